@@ -8,7 +8,9 @@
 from __future__ import annotations
 
 import asyncio
+import json
 import logging
+import zlib
 from datetime import datetime
 from typing import Any
 
@@ -70,6 +72,13 @@ def _tasklist_url(device_host: str) -> str:
         base = f"http://{base}"
     return f"{base}/api/tasklist"
 
+
+def _status_url(device_host: str) -> str:
+    base = device_host.strip().rstrip("/")
+    if not base.startswith(("http://", "https://")):
+        base = f"http://{base}"
+    return f"{base}/api/status"
+
 def _unwrap_service_response(resp: Any) -> Any:
     """兼容不同服务实现：有的会把 payload 包一层 dict。"""
     if isinstance(resp, dict) and len(resp) == 1:
@@ -98,6 +107,14 @@ def _to_mmdd(value: str | None) -> str:
     return dt_util.as_local(dt).strftime("%m.%d")
 
 
+def _to_ymd(value: str | None) -> int:
+    """截止日期转为 YYYYMMDD 整数，供设备跨年排序；无日期返回 0。"""
+    dt = _parse_ticktick_datetime(value)
+    if dt is None:
+        return 0
+    return int(dt_util.as_local(dt).strftime("%Y%m%d"))
+
+
 def _priority_flag(priority: int) -> str:
     # TickTick：None 0 / Low 1 / Medium 3 / High 5
     if priority >= 5:
@@ -154,7 +171,11 @@ async def async_setup(hass: HomeAssistant, config: dict[str, Any]) -> bool:
 
     session = async_get_clientsession(hass)
     url_tasklist = _tasklist_url(device_host)
+    url_status = _status_url(device_host)
     push_lock = asyncio.Lock()
+    # 最近一次推送的内容与版本：内容不变时沿用版本，保证请求体逐字节一致（设备按哈希去重）
+    # 版本持久化到 .storage，HA 重启或时钟回拨后仍从上次的版本继续递增
+    push_state: dict[str, Any] = {"content": None, "version": stats_store.get_push_version()}
 
     hass.data.setdefault(DOMAIN, {})
     hass.data[DOMAIN]["config"] = domain_cfg
@@ -268,6 +289,7 @@ async def async_setup(hass: HomeAssistant, config: dict[str, Any]) -> bool:
                 status = "completed" if status_num == 2 else "needs_action"
 
                 due_mmdd = _to_mmdd(t.get("dueDate"))
+                due_ymd = _to_ymd(t.get("dueDate"))
                 completed_mmdd = _to_mmdd(t.get("completedTime"))
 
                 priority = int(t.get("priority") or 0)
@@ -300,6 +322,7 @@ async def async_setup(hass: HomeAssistant, config: dict[str, Any]) -> bool:
                     "priority": priority,
                     "priority_flag": _priority_flag(priority),
                     "due_mmdd": due_mmdd,
+                    "due_ymd": due_ymd,
                     "completed_mmdd": completed_mmdd,
                     "has_repeat": bool(repeat_flag),
                     "has_reminder": bool(reminders),
@@ -330,10 +353,64 @@ async def async_setup(hass: HomeAssistant, config: dict[str, Any]) -> bool:
                 "tasks": tasks_payload,
             }
 
+            # 列表版本（单调递增）：设备据此持久化缓存并忽略过期推送；内容不变则版本不变
+            content = json.dumps(payload, ensure_ascii=False, separators=(",", ":"), sort_keys=True)
+            if content != push_state["content"]:
+                push_state["content"] = content
+                push_state["version"] = max(int(dt_util.utcnow().timestamp()), push_state["version"] + 1)
+                await stats_store.async_set_push_version(push_state["version"])
+
             try:
-                async with async_timeout.timeout(5):
-                    resp = await session.post(url_tasklist, json=payload)
-                    resp.raise_for_status()
+                # 设备以更高版本拒绝（409 stale）时，从设备的版本接续并重推一次
+                for attempt in range(2):
+                    payload["version"] = push_state["version"]
+                    body = json.dumps(payload, ensure_ascii=False, separators=(",", ":"), sort_keys=True).encode("utf-8")
+                    body_hash = f"{zlib.crc32(body) & 0xFFFFFFFF:08x}"
+
+                    # 设备已持有相同内容（/api/status 的 tasklist_hash 一致）时跳过推送
+                    if attempt == 0:
+                        try:
+                            async with async_timeout.timeout(3):
+                                status_resp = await session.get(url_status)
+                                status_resp.raise_for_status()
+                                status = await status_resp.json(content_type=None)
+                            if isinstance(status, dict) and status.get("tasklist_hash") == body_hash:
+                                _LOGGER.debug("设备任务列表未变化（hash=%s），跳过推送", body_hash)
+                                return
+                        except (asyncio.TimeoutError, ClientError, ValueError) as err:
+                            _LOGGER.debug("查询设备状态失败，继续推送：%s", err)
+
+                    async with async_timeout.timeout(5):
+                        resp = await session.post(
+                            url_tasklist,
+                            data=body,
+                            headers={"Content-Type": "application/json", "If-None-Match": f'"{body_hash}"'},
+                        )
+                        if resp.status == 409:
+                            try:
+                                stale = await resp.json(content_type=None)
+                            except ValueError:
+                                stale = None
+                            device_version = int(stale.get("version") or 0) if isinstance(stale, dict) else 0
+                            if attempt == 0 and device_version >= push_state["version"]:
+                                _LOGGER.warning(
+                                    "设备任务列表版本 %s 不低于本次推送的 %s（HA 时钟回拨？），改用 %s 重新推送",
+                                    device_version,
+                                    push_state["version"],
+                                    device_version + 1,
+                                )
+                                push_state["version"] = device_version + 1
+                                await stats_store.async_set_push_version(push_state["version"])
+                                continue
+                            _LOGGER.warning(
+                                "设备拒绝了任务列表推送（409 stale，推送 version=%s，设备 version=%s），同步已停滞",
+                                push_state["version"],
+                                device_version,
+                            )
+                            return
+                        resp.raise_for_status()
+                    break
+
                 _LOGGER.info(
                     "已推送任务到设备：project=%s 待办=%s 已完成=%s",
                     selected_project_name or selected_project_id,
@@ -33,6 +33,7 @@ class FocusDialStats:
     tasks_total: dict[str, dict[str, Any]]
     completed_tasks: list[dict[str, Any]]  # 已完成任务缓存（最近 N 个）
     selected_project_id: str  # 当前选中的 TickTick Project（用于多项目切换记忆）
+    push_version: int  # 最近一次推送的任务列表版本（重启后接续，不随时钟回拨倒退）
 
     @classmethod
     def default(cls) -> "FocusDialStats":
@@ -44,6 +45,7 @@ class FocusDialStats:
             tasks_total={},
             completed_tasks=[],
             selected_project_id="",
+            push_version=0,
         )
 
     @classmethod
@@ -59,6 +61,7 @@ class FocusDialStats:
             tasks_total=dict(data.get("tasks_total") or {}),
             completed_tasks=list(data.get("completed_tasks") or []),
             selected_project_id=str(data.get("selected_project_id") or ""),
+            push_version=int(data.get("push_version") or 0),
         )
 
     def to_dict(self) -> dict[str, Any]:
@@ -70,6 +73,7 @@ class FocusDialStats:
             "tasks_total": self.tasks_total,
             "completed_tasks": self.completed_tasks,
             "selected_project_id": self.selected_project_id,
+            "push_version": self.push_version,
         }
 
     def ensure_today(self) -> None:
@@ -191,3 +195,11 @@ class FocusDialStatsStore:
 
     def get_selected_project_id(self) -> str:
         return str(self._stats.selected_project_id or "")
+
+    async def async_set_push_version(self, version: int) -> None:
+        async with self._lock:
+            self._stats.push_version = int(version)
+            await self._store.async_save(self._stats.to_dict())
+
+    def get_push_version(self) -> int:
+        return int(self._stats.push_version or 0)
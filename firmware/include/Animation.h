@@ -12,8 +12,10 @@ class Animation
 public:
     Animation(Adafruit_SSD1306 *display);
     void start(const byte *frames, int frameCount, bool loop, bool reverse, unsigned long durationMs, int width, int height); // reverse 参数移至此处 / Moved reverse parameter
+    // 推进一帧（帧间隔由调度器控制）/ Advance one frame; the scheduler owns the frame interval
     void update();
     bool isRunning();
+    unsigned long getFrameDelay() const { return frameDelay; }
 
 private:
     Adafruit_SSD1306 *oled;
@@ -28,7 +30,6 @@ private:
     bool loopAnimation;
     bool playInReverse;
     unsigned long animationStartTime;
-    unsigned long lastFrameTime;
     unsigned long animationDuration;
     unsigned long frameDelay;
 };
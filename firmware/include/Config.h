@@ -6,6 +6,7 @@
 #define OLED_WIDTH 128
 #define OLED_HEIGHT 64
 #define OLED_ADDR 0x3C
+#define OLED_I2C_HZ 400000 // Hz - OLED 总线时钟，SSD1306 规格上限 400 kHz；可自行提高到 800000–1000000（超出规格），传输出错时自动退回 400 kHz；Bus clock at the 400 kHz SSD1306 spec; higher is opt-in and falls back on transfer errors
 
 #define LED_PIN 15
 #define NUM_LEDS 16
@@ -33,3 +34,13 @@
 #define CHANGE_TIMEOUT  15  // sec - 调整超时时间 15 秒；15 seconds adjust timeout
 #define SLEEP_TIMOUT    5   // min - 5 分钟无操作进入休眠；5 minutes to transition to sleep
 #define PAUSE_TIMEOUT   10  // min - 暂停 10 分钟后取消定时；10 minutes to cancel the timer if stayed paused
+#define SESSION_NVS_INTERVAL 60 // sec - 计时中会话写入 NVS 的最短间隔（RTC 内存每秒更新）；Min NVS checkpoint interval while running
+
+// --- Power --- 电源
+#define LIGHT_SLEEP_MIN_MS    4   // ms - 短于此的空闲不值得进出轻睡眠；Idle gaps shorter than this stay awake
+#define LIGHT_SLEEP_MAX_MS    250 // ms - 单次轻睡眠上限，保证 WiFi/HTTP 定期得到服务；Cap so WiFi/HTTP get serviced
+#define POWER_ACTIVE_MA       45  // mA - 清醒（CPU + WiFi 调制解调器睡眠）典型电流；Typical awake current, modem sleep
+#define POWER_LIGHT_SLEEP_MA  2   // mA - 轻睡眠典型电流（不含 LED）；Typical light-sleep current, LEDs excluded
+
+#define DUMP_STATE_GRAPH 0  // 1：启动时向串口输出 Graphviz 状态图；1 to print the state graph (Graphviz DOT) on boot
+#define BENCH_PAGE_RASTER 0 // 1：启动时向串口输出 GFX 与 PageRaster 绘制原语的耗时对比；1 to print the GFX vs PageRaster timing on boot
@@ -4,6 +4,7 @@
 #include "controllers/LedController.h"
 #include "controllers/InputController.h"
 #include "controllers/NetworkController.h"
+#include "controllers/PowerController.h"
 #include <Preferences.h>
 
 // Declare global controller instances / 声明全局控制器实例
@@ -11,4 +12,5 @@ extern DisplayController displayController;
 extern LEDController ledController;
 extern InputController inputController;
 extern NetworkController networkController;
+extern PowerController powerController;
 extern Preferences preferences;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 唤醒主循环的事件来源 / What woke the main loop
+enum class EventType : uint8_t
+{
+    Input,     // 按键/旋钮中断 / Button or encoder interrupt
+    Timer,     // 定时器到期 / Timer expiry
+    Network,   // 网络回调（如任务列表更新）/ Network callback (e.g. task list update)
+    Animation, // 动画帧请求 / Animation frame request
+    WebhookOk,     // webhook 发送成功 / Webhook delivered
+    WebhookFailed, // webhook 发送失败；与成功分开，避免被排队中的成功合并掉 / Webhook failed; separate so a queued success cannot absorb it
+};
+
+static const uint8_t EVENT_TYPE_COUNT = 6;
+
+struct Event
+{
+    EventType type;
+    uint32_t arg;
+};
+
+// EventQueue / 事件队列
+//
+// 中断、定时器与网络回调向队列投递事件，主循环阻塞等待，直到有事件或到达最近的截止时间。
+// 同类事件在被取走前只入队一次（合并），旋钮中断再频繁也不会占满队列。
+class EventQueue
+{
+public:
+    EventQueue();
+
+    void begin();
+
+    // Post from task context / 任务上下文投递
+    bool post(EventType type, uint32_t arg = 0);
+
+    // Post from an ISR / 中断上下文投递
+    bool postFromISR(EventType type, uint32_t arg = 0);
+
+    // Block up to timeoutMs for the next event / 最多阻塞 timeoutMs 等待事件
+    bool wait(Event &event, uint32_t timeoutMs);
+
+    // 是否有未取走的事件 / Whether any event is queued
+    bool pending() const;
+
+private:
+    static const uint8_t QUEUE_LENGTH = 8;
+
+    QueueHandle_t queue;
+    StaticQueue_t queueControl;
+    uint8_t queueStorage[QUEUE_LENGTH * sizeof(Event)];
+    std::atomic<uint8_t> pendingMask; // 已入队未取走的事件类型 / Types queued but not yet taken
+
+    bool markPending(EventType type);
+};
+
+extern EventQueue eventQueue;
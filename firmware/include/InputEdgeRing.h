@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 一次引脚电平变化（ISR 记录）/ One pin edge, recorded by the ISR
+struct InputEdge
+{
+    uint32_t us;    // micros() at the edge / 边沿时刻
+    uint8_t levels; // bit0=A, bit1=B, bit2=button（原始电平）/ raw pin levels
+};
+
+// InputEdgeRing / 输入边沿环形缓冲
+//
+// 单生产者（按键/旋钮中断，ESP32 同级中断不互相嵌套）单消费者（主循环）的无锁队列。
+// 主循环被 OLED 刷新或 HTTP 处理拖住时，边沿先在此排队，不会丢失旋钮步进。
+// Single-producer (the input ISRs, which do not nest) single-consumer (main loop) lock-free queue.
+// Edges queue here while the loop is busy flushing the OLED or serving HTTP, so no detent is lost.
+template <uint16_t N>
+class InputEdgeRing
+{
+    static_assert((N & (N - 1)) == 0, "InputEdgeRing size must be a power of two");
+
+public:
+    InputEdgeRing() : head(0), tail(0), overflows(0) {}
+
+    bool IRAM_ATTR push(const InputEdge &edge)
+    {
+        const uint16_t h = head.load(std::memory_order_relaxed);
+        if ((uint16_t)(h - tail.load(std::memory_order_acquire)) >= N)
+        {
+            overflows = overflows + 1;
+            return false;
+        }
+        slots[h & (N - 1)] = edge;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(InputEdge &edge)
+    {
+        const uint16_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        edge = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+
+    uint32_t overflowCount() const { return overflows; }
+
+private:
+    InputEdge slots[N];
+    std::atomic<uint16_t> head; // 仅 ISR 写 / written by the ISR only
+    std::atomic<uint16_t> tail; // 仅主循环写 / written by the main loop only
+    volatile uint32_t overflows;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Transitions.h"
+
+// 一次输入手势 / One input gesture
+//
+// gesture 取值为 Press / DoublePress / LongPress / Rotate / HoldRotate，与转移表的触发事件一致，
+// 状态未消费的手势可直接交给转移表；未处理的 HoldRotate 按普通 Rotate 处理。
+// gesture is one of Press / DoublePress / LongPress / Rotate / HoldRotate, the same values the
+// transition table uses, so a gesture a state does not consume can be dispatched as-is; an unhandled
+// HoldRotate is treated as a plain Rotate.
+struct InputEvent
+{
+    Trigger gesture;
+    int delta;          // 旋钮增量，仅 Rotate / HoldRotate 有效 / Encoder delta, Rotate / HoldRotate only
+    uint32_t timestamp; // 手势可判定的时刻（micros）/ micros() at which the gesture became recognisable
+};
+
+// 旋钮加速曲线 / Encoder acceleration curve
+//
+// 相邻两步同向且间隔 ≥ slowMs 时每步计 1，≤ fastMs 时计 maxSteps，其间线性插值；反向时回到 1。
+// Same-direction detents at least slowMs apart count 1, at most fastMs apart count maxSteps,
+// linear in between; a direction change drops back to 1.
+struct EncoderProfile
+{
+    uint16_t slowMs;
+    uint16_t fastMs;
+    uint8_t maxSteps;
+
+    uint8_t stepsFor(uint32_t intervalMs) const
+    {
+        if (maxSteps <= 1 || intervalMs >= slowMs)
+        {
+            return 1;
+        }
+        if (intervalMs <= fastMs)
+        {
+            return maxSteps;
+        }
+        return 1 + (uint32_t)(maxSteps - 1) * (slowMs - intervalMs) / (slowMs - fastMs);
+    }
+};
+
+extern const EncoderProfile ENCODER_PRECISE; // 无加速：选项切换 / No acceleration: option toggles
+extern const EncoderProfile ENCODER_LIST;    // 列表滚动 / List scrolling
+extern const EncoderProfile ENCODER_VALUE;   // 数值调节（时长）/ Value adjustment (durations)
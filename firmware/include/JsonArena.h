@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+
+// JsonArena / JSON 静态内存区
+//
+// 启动时静态预留一块内存，供所有 JSON 解析/序列化复用，避免每次推送和 webhook
+// 反复申请释放大块堆内存导致碎片化。同一时刻只有一个文档持有该内存区（租用），
+// 文档析构时归还；内存区被占用或容量不足时回退到堆分配，并计入 fallbacks。
+class JsonArena
+{
+public:
+    // 任务列表 payload 可能包含 projects + subtasks，与 API 端校验共用该容量
+    // Sized for the largest task-list payload (projects + subtasks)
+    static const size_t CAPACITY = 24576;
+
+    static JsonArena &instance();
+
+    // Claim / return exclusive ownership / 租用与归还（归还时整体复位）
+    bool acquire();
+    void release();
+
+    // Bump allocation inside the arena, nullptr when exhausted / 内存区内顺序分配，不足时返回 nullptr
+    void *allocate(size_t size);
+    void deallocate(void *ptr);
+    void *reallocate(void *ptr, size_t newSize);
+
+    bool contains(const void *ptr) const;
+    size_t bytesFrom(const void *ptr) const; // Bytes in use from ptr to the top / 从 ptr 到已用末尾的字节数
+
+    // Stats / 统计
+    size_t peakUsage() const { return peak; }
+    uint32_t fallbackCount() const { return fallbacks; }
+    void noteFallback() { fallbacks++; }
+
+private:
+    JsonArena();
+
+    alignas(8) uint8_t buffer[CAPACITY];
+    size_t used;       // Bytes handed out / 已分配字节
+    size_t lastOffset; // Start of the most recent block / 最近一块的起始偏移
+    size_t peak;       // High-water mark / 峰值用量
+    uint32_t fallbacks;
+    std::atomic<bool> leased;
+};
+
+// ArduinoJson allocator backed by JsonArena / 基于 JsonArena 的 ArduinoJson 分配器
+//
+// 构造时尝试租用内存区，析构时归还。复制时转移所有权（ArduinoJson 6 按值传递分配器），
+// 因此任何时候只有一个实例负责归还。
+class JsonArenaAllocator
+#if ARDUINOJSON_VERSION_MAJOR >= 7
+    : public ArduinoJson::Allocator
+#endif
+{
+public:
+    JsonArenaAllocator();
+    JsonArenaAllocator(const JsonArenaAllocator &other);
+    ~JsonArenaAllocator();
+
+    void *allocate(size_t size);
+    void deallocate(void *ptr);
+    void *reallocate(void *ptr, size_t newSize);
+
+private:
+    mutable bool leased;
+
+    JsonArenaAllocator &operator=(const JsonArenaAllocator &) = delete;
+};
+
+// 替代 DynamicJsonDocument：作用域内持有内存区 / Drop-in for DynamicJsonDocument, owns the arena for its scope
+#if ARDUINOJSON_VERSION_MAJOR >= 7
+class ArenaJsonDocument : private JsonArenaAllocator, public JsonDocument
+{
+public:
+    explicit ArenaJsonDocument(size_t = 0)
+        : JsonArenaAllocator(), JsonDocument(static_cast<ArduinoJson::Allocator *>(this)) {}
+
+    ArenaJsonDocument(const ArenaJsonDocument &) = delete;
+    ArenaJsonDocument &operator=(const ArenaJsonDocument &) = delete;
+};
+#else
+typedef BasicJsonDocument<JsonArenaAllocator> ArenaJsonDocument;
+#endif
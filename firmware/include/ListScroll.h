@@ -0,0 +1,30 @@
+#pragma once
+
+// 列表滚动：选中行按增量移动（加速时一次可移动多行），并保持在可见窗口内
+// Move the selection by delta (several rows when the encoder accelerates) and keep it inside the visible window
+inline void scrollList(int &selected, int &offset, int count, int delta, int visible)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    selected += delta;
+    if (selected < 0)
+    {
+        selected = 0;
+    }
+    if (selected > count - 1)
+    {
+        selected = count - 1;
+    }
+
+    if (selected < offset)
+    {
+        offset = selected;
+    }
+    if (selected - offset >= visible)
+    {
+        offset = selected - visible + 1;
+    }
+}
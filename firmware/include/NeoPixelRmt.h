@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/rmt.h>
+
+// NeoPixelRmt / 由 RMT 外设驱动的 WS2812 灯环
+//
+// UI 线程只在画布上改像素并 show()：画布复制到待发帧后通知后台任务即返回。低优先级的 "LED Task"
+// 把帧编码成 RMT 脉冲并由外设发送，不关中断、不阻塞主循环，编码器 ISR 照常响应。
+// 后台来不及发送时新帧覆盖旧帧（只保留最新一帧），计入 dropped。
+// The UI thread edits the canvas and calls show(), which copies it into the pending frame and
+// notifies a background task. The low-priority "LED Task" encodes the frame into RMT pulses and the
+// peripheral clocks them out with interrupts enabled, so the main loop and encoder ISRs never wait.
+// A frame posted before the previous one went out replaces it (latest wins) and counts as dropped.
+//
+// show() 与上一次提交的影子帧逐像素比较，完全相同则不提交，计入 suppressed。
+// show() compares the canvas with a shadow of the last posted frame and skips identical frames,
+// counting them as suppressed.
+class NeoPixelRmt
+{
+public:
+    NeoPixelRmt(uint8_t pin, uint16_t numLeds, rmt_channel_t channel = RMT_CHANNEL_0);
+
+    // 安装 RMT 驱动并启动后台任务 / Install the RMT driver and start the background task
+    void begin();
+
+    // 全局亮度，在编码时施加（同 Adafruit_NeoPixel::setBrightness）/ Global brightness applied at encode time
+    void setBrightness(uint8_t brightness);
+
+    // 画布操作，仅 UI 线程调用 / Canvas edits, UI thread only
+    void setPixelColor(uint16_t index, uint32_t color);
+    void fill(uint32_t color);
+    void clear();
+
+    // 提交画布，立即返回；与影子帧相同则跳过并返回 false / Post the canvas and return at once; false when unchanged
+    bool show();
+
+    // 等待在途帧发完（轻睡眠前调用，RMT 时钟在睡眠中停止）
+    // Wait for the frame in flight to finish (call before light sleep; the RMT clock stops while asleep)
+    bool waitIdle(uint32_t timeoutMs);
+
+    uint16_t numPixels() const { return numLeds; }
+    uint32_t framesShown() const { return shown; }
+    uint32_t framesDropped() const { return dropped; }
+    uint32_t framesSuppressed() const { return suppressed; }
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b; }
+
+private:
+    const uint8_t pin;
+    const uint16_t numLeds;
+    const rmt_channel_t channel;
+    uint16_t scale; // brightness + 1，255 即不缩放 / brightness + 1, so 255 is a no-op
+
+    uint32_t *canvas;  // UI 线程的画布 / UI-side canvas
+    uint32_t *shadow;  // 上一次提交的帧 / Last posted frame
+    bool shadowValid;  // 开机或改亮度后须强制发送 / Forces a send after boot or a brightness change
+    uint32_t *pending; // 待发帧（mux 保护）/ Frame waiting for the task (guarded by mux)
+    uint32_t *sending; // 任务私有副本 / Task-private copy
+    rmt_item32_t *items;
+    volatile bool hasPending;
+    volatile bool busy;
+
+    portMUX_TYPE mux;
+    TaskHandle_t taskHandle;
+
+    volatile uint32_t shown;
+    volatile uint32_t dropped;
+    uint32_t suppressed;
+
+    static void ledTask(void *param);
+    void encode(const uint32_t *frame, uint16_t scale);
+
+    // 40 MHz RMT 时钟（clk_div 2），每 tick 25 ns / 40 MHz RMT clock (clk_div 2), 25 ns per tick
+    static const uint8_t RMT_CLK_DIV = 2;
+    static const uint16_t T0H = 16; // 0.40 us
+    static const uint16_t T0L = 34; // 0.85 us
+    static const uint16_t T1H = 32; // 0.80 us
+    static const uint16_t T1L = 18; // 0.45 us
+    static const uint32_t RESET_US = 80; // 帧间低电平锁存 / Low time that latches a frame
+};
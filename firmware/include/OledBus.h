@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// OledBus / OLED 的 I2C 传输层
+//
+// Adafruit_SSD1306::display() 每次都按整帧、以小块 Wire 传输发送，每块都重复起始位、地址和控制字节。
+// 这里放大 Wire 缓冲区让整帧或一个写入窗口一次传完，窗口设置（PAGEADDR + COLUMNADDR）合并为一次命令传输，
+// 时钟按配置设定（高于 400 kHz 需显式开启；探测不应答或传输出错则退回 400 kHz），并统计传输次数与错误。
+// Adafruit_SSD1306::display() always sends the whole frame in small Wire transfers, each repeating the
+// start condition, address and control byte. This grows the Wire buffer so a frame or write window goes
+// out in one transfer, sends the window setup (PAGEADDR + COLUMNADDR) as one command transfer, runs the
+// bus at the configured clock (above 400 kHz is opt-in and falls back to 400 kHz when the panel does not
+// answer or transfers fail) and counts transfers and errors.
+class OledBus
+{
+public:
+    OledBus(TwoWire &wire, uint8_t address);
+
+    // 须在显示驱动启动总线之前调用 / Call before the display driver starts the bus
+    void reserve(size_t frameBytes);
+
+    // 总线启动后以配置的时钟探测面板 / Probe the panel at the configured clock once the bus is up
+    void begin(uint32_t clockHz);
+
+    // 传输出错时退回 400 kHz；已在该时钟时返回 false / Drop to 400 kHz after transfer errors; false if already there
+    bool fallBack();
+
+    // 其他驱动（如帧动画经 Adafruit 刷屏）可能改过时钟，发送前恢复 / Other drivers (frame animations via Adafruit) may have changed the clock; restore it before sending
+    void claim();
+
+    // 设置写入窗口 / Set the write window
+    bool window(uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1);
+
+    // 写入显存，仅在超出缓冲区时分块 / Write display RAM, split only beyond the buffer capacity
+    bool data(const uint8_t *bytes, size_t length);
+
+    uint32_t clockHz() const { return clock; }
+    uint32_t transactions() const { return transfers; }
+    uint32_t errors() const { return failures; }
+
+private:
+    TwoWire &wire;
+    const uint8_t address;
+    uint32_t clock;
+    size_t chunk; // 每次传输的数据字节上限 / Data bytes per transfer
+    uint32_t transfers;
+    uint32_t failures;
+
+    bool send(uint8_t control, const uint8_t *bytes, size_t length);
+
+    static const uint32_t FALLBACK_HZ = 400000;
+    static const size_t DEFAULT_CHUNK = 127; // Arduino-ESP32 默认 128 字节缓冲减去控制字节 / Default 128-byte buffer minus the control byte
+    static const uint8_t CONTROL_COMMAND = 0x00;
+    static const uint8_t CONTROL_DATA = 0x40;
+    static const uint8_t CMD_COLUMNADDR = 0x21;
+    static const uint8_t CMD_PAGEADDR = 0x22;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+
+// PageRaster / SSD1306 页格式上的整字节绘制原语
+//
+// SSD1306 帧缓冲按页存放：每字节是一列中纵向 8 个像素（byte = x + (y / 8) * width）。Adafruit_GFX 的
+// 填充与贴图逐像素调用虚函数 drawPixel()；这里按列对每页做一次带掩码的字节运算，整页用 memset。
+// 结果与 GFX 逐像素一致（圆角与 fillRoundRect 同一算法），可直接替换热路径上的调用。
+// The SSD1306 buffer is stored in pages: each byte is 8 vertical pixels of one column
+// (byte = x + (y / 8) * width). Adafruit_GFX fills and blits through the virtual drawPixel() one pixel at
+// a time; these primitives do one masked byte operation per column per page, memset for whole pages.
+// Output is pixel-identical to GFX (rounded corners use fillRoundRect's algorithm), so hot paths can swap.
+class PageRaster
+{
+public:
+    // 与 SSD1306_BLACK / WHITE / INVERSE 取值相同 / Same values as SSD1306_BLACK / WHITE / INVERSE
+    enum Color : uint8_t
+    {
+        Black = 0,
+        White = 1,
+        Invert = 2
+    };
+
+    PageRaster(uint8_t *buffer, int16_t width, int16_t height);
+
+    // 矩形区域按行跨度填充 / Fill horizontal spans over a rectangle
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+
+    // 区域反色（选中高亮）/ XOR-invert a region (selection highlight)
+    void invertRect(int16_t x, int16_t y, int16_t w, int16_t h) { fillRect(x, y, w, h, Invert); }
+
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint8_t color);
+
+    // 1bpp 行优先位图（Adafruit 格式，MSB 在左），任意 y；只画置位像素。每页取 8 个源行字节转置成 8 列的页字节
+    // 1bpp row-major bitmap (Adafruit format, MSB leftmost) at any y; only set bits are drawn. Each page
+    // gathers 8 source row bytes and transposes them into the page bytes of 8 columns
+    void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint8_t color);
+
+private:
+    uint8_t *buffer;
+    const int16_t width;
+    const int16_t height;
+
+    // 单列 [y0, y1] 的纵向跨度，已裁剪 / Vertical span [y0, y1] in one column, already clipped
+    void fillColumn(int16_t x, int16_t y0, int16_t y1, uint8_t color);
+
+    static void apply(uint8_t &dst, uint8_t mask, uint8_t color);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Scheduler / 统一定时调度
+//
+// 所有周期与一次性工作（LED/屏幕动画帧、HTTP 轮询、状态超时、手势截止时间……）登记为固定槽位的定时任务，
+// 截止时间基于 64 位单调毫秒（esp_timer），不会回绕。主循环只需等到最早的截止时间，再运行到期任务，
+// 各模块不再各自比较 millis()。
+// Every periodic and one-shot job (LED/display frames, HTTP polling, state timeouts, gesture deadlines...) is
+// a fixed-slot task with a deadline on a 64-bit monotonic millisecond clock (esp_timer), so nothing wraps.
+// The loop sleeps until the single earliest deadline and runs what is due; modules no longer poll millis().
+//
+// 可延后任务（deferrable）只在 CPU 本来就醒着时运行，不单独把芯片从轻睡眠中唤醒。
+// Deferrable tasks run when the CPU is awake anyway; on their own they do not end a light sleep.
+class Scheduler
+{
+public:
+    typedef void (*Callback)(void *arg);
+    typedef uint8_t Handle;
+
+    static const Handle INVALID = 0xFF;
+    static const uint8_t MAX_TASKS = 16;
+
+    Scheduler();
+
+    // 登记任务（未布防）；槽位用尽返回 INVALID / Register a task (unarmed); INVALID when full
+    Handle add(const char *name, Callback callback, void *arg, bool deferrable = false);
+
+    // delayMs 后运行一次 / Run once after delayMs
+    void in(Handle handle, uint32_t delayMs);
+
+    // 不晚于 delayMs 运行：已有更早的截止时间则保留 / Run within delayMs; an earlier deadline is kept
+    void within(Handle handle, uint32_t delayMs);
+
+    // 每 periodMs 运行一次（按截止时间累加，不漂移），首次在 periodMs 后
+    // Run every periodMs on a drift-free cadence, first run after periodMs
+    void every(Handle handle, uint32_t periodMs);
+
+    void cancel(Handle handle);
+    bool armed(Handle handle) const;
+
+    // 运行所有到期任务（回调里可重新布防/撤销任何任务）/ Run every due task; callbacks may re-arm or cancel any task
+    void run();
+
+    // 距最早截止时间的毫秒数，无任务时返回 UINT32_MAX / Milliseconds to the earliest deadline, UINT32_MAX when idle
+    uint32_t msUntilNext(bool includeDeferrable = true) const;
+
+    static int64_t nowMs();
+
+private:
+    struct Task
+    {
+        const char *name;
+        Callback callback;
+        void *arg;
+        int64_t dueMs;
+        uint32_t periodMs; // 0：一次性 / 0: one-shot
+        bool armed;
+        bool deferrable;
+    };
+
+    Task tasks[MAX_TASKS];
+    uint8_t count;
+
+    void arm(Handle handle, uint32_t delayMs, uint32_t periodMs);
+};
+
+extern Scheduler scheduler;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "Scheduler.h"
+#include "models/FocusSession.h"
+
+// SessionJournal / 专注会话断电恢复记录
+//
+// 计时/暂停中的会话在每次状态切换、以及计时中每秒写入 RTC 慢速内存（软件复位、看门狗、崩溃后仍保留），
+// 并合并写入 NVS（断电后仍保留）：开始/暂停/恢复立即写，计时中最多每 SESSION_NVS_INTERVAL 秒写一次，
+// 以限制闪存磨损。重启后恢复为暂停状态，并向 HA 上报 focus_interrupted（带已专注时长）。
+//
+// Running/paused sessions are checkpointed to RTC slow memory on every state change and every second while
+// running (survives software reset, watchdog and panic), and coalesced into NVS (survives power loss):
+// start/pause/resume are written at once, running progress at most every SESSION_NVS_INTERVAL seconds to
+// limit flash wear. After a reboot the session comes back paused and HA gets focus_interrupted with the
+// elapsed time.
+class SessionJournal
+{
+public:
+    SessionJournal();
+
+    // 读取上次未结束的会话（RTC 优先，其次 NVS）/ Load an unfinished session, RTC first, then NVS
+    void begin();
+
+    // 记录会话进度（时钟停止即为暂停）/ Checkpoint a session; a stopped clock means paused
+    void record(const FocusSession& session);
+
+    // 会话已结束 / The session is over
+    void clear();
+
+    bool hasInterrupted() const { return interruptedValid; }
+
+    // 取出中断的会话（时钟已停），并排队上报 focus_interrupted / Take the interrupted session and queue the report
+    FocusSession takeInterrupted();
+
+private:
+    // 定长记录，RTC 与 NVS 共用 / Fixed-size record shared by RTC and NVS
+    struct Record
+    {
+        uint32_t magic;
+        uint16_t durationMin;
+        uint8_t running;
+        uint8_t reserved;
+        int64_t elapsedUs;
+        char sessionId[24];
+        char taskId[48];
+        char taskName[96];
+        char taskDisplayName[96];
+        char taskProjectId[32];
+        uint32_t crc; // 以上字段的 CRC-32 / CRC-32 of the fields above
+    };
+
+    static Record rtcRecord; // 不被启动代码清零的 RTC 慢速内存 / RTC slow memory left untouched by startup code
+
+    Preferences prefs;
+    bool nvsHasRecord;
+    bool nvsRunning;
+    String nvsSessionId;
+    int64_t nvsWrittenAtUs;
+
+    bool interruptedValid;
+    Record interrupted;
+    const char* interruptedSource; // "rtc" 或 "nvs" / "rtc" or "nvs"
+    String pendingReport;
+    Scheduler::Handle reportTask; // 等 WiFi 连上后发送 focus_interrupted / Sends focus_interrupted once WiFi is up
+
+    static void onReport(void* arg);
+
+    static bool isValid(const Record& record);
+    static void seal(Record& record);
+    static void copyText(char* dest, size_t size, const String& text);
+    void writeNvs(const Record& record);
+
+    static const uint32_t MAGIC = 0x464F4353; // "FOCS"
+    static const uint32_t REPORT_RETRY_MS = 1000;
+};
+
+extern SessionJournal sessionJournal;
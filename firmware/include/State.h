@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Config.h"
+#include "InputEvent.h"
 
 // Base class / 状态基类
 class State {
@@ -10,4 +11,23 @@ public:
     virtual void enter() = 0; 
     virtual void update() = 0;
     virtual void exit() = 0;
+
+    // 下次需要 update() 的时间点（millis）；主循环最多阻塞到此时，输入/网络事件会提前唤醒
+    // Deadline (millis) for the next update(); the loop blocks until then unless an event arrives first
+    virtual unsigned long nextWakeup(unsigned long now) { return now + STATE_TICK_MS; }
+
+    // 处理输入手势；返回 true 表示已消费，false 则交给转移表（可先做状态内的动作再放行）
+    // Handle a gesture; return true if consumed, false to pass it on to the transition table
+    // (a state may do its own work first and still let the table transition)
+    virtual bool onInput(const InputEvent& event) { return false; }
+
+    // 本状态的旋钮加速曲线，进入状态时生效 / Encoder acceleration used while this state is active
+    virtual const EncoderProfile& encoderProfile() const { return ENCODER_PRECISE; }
+
+    // 等待事件期间可进入轻睡眠（无动画需要精确帧率、无计时需要连续刷新）
+    // Whether the loop may light-sleep while waiting (no frame-accurate animation or running timer)
+    virtual bool allowsLightSleep() const { return false; }
+
+protected:
+    static const unsigned long STATE_TICK_MS = 100; // 默认节拍：超时检查与重绘 / Default tick for timeouts and redraws
 };
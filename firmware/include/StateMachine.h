@@ -1,7 +1,10 @@
 #pragma once
 
 #include <Arduino.h>
+#include "Scheduler.h"
 #include "State.h"
+#include "Transitions.h"
+#include "EventQueue.h"
 #include "states/AdjustState.h"
 #include "states/DoneState.h"
 #include "states/DurationSelectState.h"
@@ -22,10 +25,33 @@ public:
     StateMachine();
     ~StateMachine();
 
+    // 登记状态节拍与超时任务（调度器构造之后调用）/ Register the state tick and timeout tasks (after static init)
+    void begin();
+
     void changeState(State* newState);
-    void update();
+    void changeState(StateId id);
+
+    // 输入先交给当前状态，未消费则按转移表处理 / Offer input to the current state, then to the transition table
+    void handleInput(const InputEvent& event);
+
+    // 按转移表处理触发事件，无匹配行时忽略 / Apply the transition table; ignored when no row matches
+    bool dispatch(Trigger trigger);
+
+    // 导出 Graphviz DOT 状态图 / Dump the transition table as a Graphviz DOT graph
+    void dumpGraph(Print& out);
     State* getCurrentState();
 
+    // 尽快运行一次当前状态的 update()（输入、网络、动画结束后重绘）
+    // Run the current state's update() as soon as possible (redraw after input, network or an animation)
+    void requestUpdate();
+
+    // ms 后向 owner 投递 trigger（owner 须为当前状态；再次调用即顺延，切换状态时自动撤销）
+    // Dispatch trigger after ms while owner is current; calling again pushes it back, a state change cancels it
+    void armTimeout(const State* owner, uint32_t ms, Trigger trigger = Trigger::Timeout);
+
+    // Block until an event or the scheduler's earliest deadline / 阻塞等待事件或调度器最早的截止时间
+    void waitForEvent();
+
     // Static states / 静态状态对象
     static AdjustState adjustState;
     static DoneState doneState;
@@ -44,8 +70,26 @@ public:
 
 private:
     State* currentState;            // Pointer to the current state / 当前状态指针
+    StateId currentId;
     SemaphoreHandle_t stateMutex;   // Mutex to protect transitions / 保护状态切换的互斥量
     bool transition = false;
+
+    Scheduler::Handle stateTask = Scheduler::INVALID;
+    Scheduler::Handle timeoutTask = Scheduler::INVALID;
+    Trigger timeoutTrigger = Trigger::Timeout;
+
+    void update();
+    void onEvent(const Event& event);
+    static void onStateTick(void* arg);
+    static void onStateTimeout(void* arg);
+
+    static State* stateFor(StateId id);
+    static StateId idOf(State* state);
+
+    // 进入新状态后记录/清除进行中的会话 / Checkpoint or clear the running session after entering a state
+    void checkpointSession();
+
+    static const uint32_t MAX_WAIT_MS = 1000; // 兜底唤醒间隔 / Upper bound on a single wait
 };
 
 extern StateMachine stateMachine;  // Global instance of the StateMachine / 状态机全局实例
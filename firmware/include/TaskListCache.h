@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+
+class TaskListState;
+
+// TaskListCache / 任务列表闪存缓存
+//
+// 将最近一次接受的任务列表以紧凑二进制格式保存到 SPIFFS 分区（含列表版本号），
+// 开机时同步读回，使得 HA 推送前双击进入任务列表也能立即看到数据。
+class TaskListCache
+{
+public:
+    TaskListCache();
+
+    // Mount SPIFFS (format on first use) / 挂载 SPIFFS（首次使用时自动格式化）
+    bool begin();
+
+    // Load cached list into state, returns false if missing/corrupt / 读回缓存，不存在或损坏时返回 false
+    bool load(TaskListState &state);
+
+    // Persist current list of state / 将当前任务列表写入缓存
+    bool save(const TaskListState &state);
+
+    // Drop cached list (e.g. factory reset) / 删除缓存
+    void clear();
+
+private:
+    bool mounted;
+
+    static const uint32_t MAGIC = 0x4C544446; // "FDTL"
+    static const uint8_t FORMAT_VERSION = 2;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+#include "models/ScreenTransition.h"
+
+// 状态编号（与 StateMachine 中的静态状态一一对应）/ State ids, one per static state in StateMachine
+enum class StateId : uint8_t
+{
+    Startup,
+    Provision,
+    Idle,
+    Adjust,
+    Reset,
+    Sleep,
+    Timer,
+    Paused,
+    Done,
+    TaskListView,
+    TaskCompletePrompt,
+    TaskList,
+    DurationSelect,
+    TaskDetail,
+    Count
+};
+
+// 触发转移的事件 / Events that trigger a transition
+enum class Trigger : uint8_t
+{
+    Press,       // 单击
+    DoublePress, // 双击
+    LongPress,   // 长按
+    Rotate,      // 旋钮
+    HoldRotate,  // 按住按键旋转 / Turn while holding the button
+    Timeout,     // 状态超时（无操作/暂停过久）/ State timeout (inactivity, pause too long)
+    Done,        // 状态自身完成（闪屏结束、计时结束、配网成功）/ State finished its own work
+    Count
+};
+
+typedef bool (*TransitionGuard)();
+typedef void (*TransitionAction)();
+
+// 转移表的一行：from × trigger →（guard 通过时）执行 action 并切换到 to
+// One row: from × trigger -> run action and enter `to` (when guard passes)
+struct Transition
+{
+    StateId from;
+    Trigger trigger;
+    TransitionGuard guard;   // nullptr：无条件（每组最后一行）/ nullptr: unconditional (last row of a group)
+    TransitionAction action; // nullptr：无附加动作 / nullptr: no action
+    StateId to;
+    const char *guardName;   // 仅用于导出状态图 / For the graph dump only
+};
+
+namespace Transitions
+{
+    // 某状态的所有转移行（按 trigger 分组）/ All rows leaving a state, grouped by trigger
+    const Transition *rowsFor(StateId from, size_t &count);
+
+    const Transition *all(size_t &count);
+
+    // 两个状态之间的屏幕切换效果，未列出的为 None / Screen transition between two states; None when unlisted
+    ScreenTransition screenFor(StateId from, StateId to);
+
+    const char *stateName(StateId id);
+    const char *triggerName(Trigger trigger);
+}
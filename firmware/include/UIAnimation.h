@@ -9,19 +9,104 @@
 // ============================================================
 
 // Animation easing types
-enum class EasingType {
+enum class EasingType : uint8_t {
     UNLINEAR,    // Non-linear easing (OLED_UI style) - smooth deceleration
     PID,         // PID curve animation - smoother acceleration/deceleration
     LINEAR       // Linear interpolation
 };
 
+// ============================================================
+// Q16.16 fixed point
+// 16 integer bits (pixels) and 16 fraction bits; no FPU work per frame
+// ============================================================
+typedef int32_t q16_t;
+
+static const q16_t Q16_ONE = 1 << 16;
+
+inline q16_t toQ16(float value) { return (q16_t)(value * Q16_ONE + (value >= 0 ? 0.5f : -0.5f)); }
+inline float fromQ16(q16_t value) { return (float)value / Q16_ONE; }
+inline int roundQ16(q16_t value) { return (value + (Q16_ONE / 2)) >> 16; }
+
+// ============================================================
+// AnimationPool - Structure-of-arrays store for every AnimatedValue
+// Values that are moving sit in a dense active list and are stepped
+// in one loop; a value that settles drops out of the list, so an
+// idle UI costs a single compare per frame.
+// ============================================================
+class AnimationPool {
+public:
+    typedef uint8_t Slot;
+
+    static const Slot INVALID = 0xFF;
+    static const uint8_t CAPACITY = 32;
+
+    // Shared pool (function-local static, safe during static init)
+    static AnimationPool& shared();
+
+    AnimationPool();
+
+    // Reserve / release a slot; INVALID when the pool is full
+    Slot acquire(q16_t initialValue);
+    void release(Slot slot);
+
+    // Step every active value once (call once per frame)
+    void update(unsigned long deltaMs);
+
+    // Step a single value (legacy per-value update)
+    void updateOne(Slot slot, unsigned long deltaMs);
+
+    void setTarget(Slot slot, q16_t target);
+    void snapTo(Slot slot, q16_t value);
+    void configure(Slot slot, q16_t speed, q16_t threshold, EasingType easing);
+
+    q16_t current(Slot slot) const { return current_[slot]; }
+    q16_t target(Slot slot) const { return target_[slot]; }
+    q16_t speed(Slot slot) const { return speed_[slot]; }
+    q16_t threshold(Slot slot) const { return threshold_[slot]; }
+    EasingType easing(Slot slot) const { return (EasingType)easing_[slot]; }
+    bool isActive(Slot slot) const { return activePos_[slot] != INVALID; }
+
+    uint8_t activeCount() const { return activeCount_; }
+
+private:
+    // Per-value state, one array per field
+    q16_t current_[CAPACITY];
+    q16_t target_[CAPACITY];
+    q16_t speed_[CAPACITY];
+    q16_t threshold_[CAPACITY];
+    q16_t gain_[CAPACITY];        // UNLINEAR/PID: Kp, LINEAR: step per 16 ms
+    q16_t ki_[CAPACITY];          // PID integral gain
+    q16_t maxIntegral_[CAPACITY]; // PID windup limit
+    q16_t integral_[CAPACITY];
+    q16_t lastError_[CAPACITY];
+    uint8_t easing_[CAPACITY];
+
+    // Dense list of moving slots and each slot's position in it
+    Slot active_[CAPACITY];
+    Slot activePos_[CAPACITY];
+    uint8_t activeCount_;
+
+    uint32_t used_; // Bit per reserved slot
+
+    void activate(Slot slot);
+    void deactivate(Slot slot);
+    bool step(Slot slot, q16_t timeFactor); // false once settled
+    static q16_t timeFactor(unsigned long deltaMs);
+};
+
 // ============================================================
 // AnimatedValue - Single value animation object
 // Used for: cursor Y position, scrollbar position, etc.
+// A handle into AnimationPool::shared(); the math is Q16.16.
 // ============================================================
 class AnimatedValue {
 public:
     AnimatedValue(float initialValue = 0.0f);
+    ~AnimatedValue();
+
+    // Owns a pool slot; not copyable
+    AnimatedValue(const AnimatedValue&) = delete;
+    AnimatedValue& operator=(const AnimatedValue&) = delete;
 
     // Set target value (starts animation)
     void setTarget(float target);
@@ -29,13 +114,16 @@ public:
     // Immediately jump to value (no animation)
     void snapTo(float value);
 
-    // Update animation (call every frame)
+    // Update this value only (prefer AnimationPool::update once per frame)
     // deltaMs: milliseconds since last update
     void update(unsigned long deltaMs);
 
     // Get current animated value
     float getValue() const;
 
+    // Current value rounded to whole pixels
+    int getPixel() const;
+
     // Get target value
     float getTarget() const;
 
@@ -48,15 +136,8 @@ public:
     void setThreshold(float threshold);   // Arrival threshold (default 0.5)
 
 private:
-    float current_;
-    float target_;
-    float speed_;
-    float threshold_;
-    EasingType easing_;
-
-    // PID controller state
-    float integral_;
-    float lastError_;
+    AnimationPool::Slot slot_;
+    q16_t fallback_; // Used only when the pool is full: no animation, values snap
 };
 
 // ============================================================
@@ -81,6 +162,86 @@ struct AnimatedRect {
     void setEasing(EasingType easing);
 };
 
+// ============================================================
+// Timeline - Keyframed tracks grouped in sequences and parallels
+// Tracks drive AnimatedValues through keyframes (snapTo each
+// update); a sequence plays its children one after another, a
+// parallel group plays them together. Fixed capacity, no heap.
+// Used for: screen transitions
+// ============================================================
+
+// Keyframe - value at a time offset from the start of its track
+struct Keyframe {
+    uint16_t atMs;
+    float value;
+};
+
+// Interpolation between two keyframes
+enum class CurveType : uint8_t {
+    LINEAR,
+    EASE_OUT,     // Fast start, soft landing
+    EASE_IN_OUT   // Smoothstep
+};
+
+class Timeline {
+public:
+    typedef uint8_t Node;
+
+    static const Node INVALID = 0xFF;
+    static const Node ROOT = 0;          // Root is a parallel group
+    static const uint8_t MAX_NODES = 16;
+    static const uint8_t MAX_KEYFRAMES = 32;
+
+    Timeline();
+
+    // Drop every node (root stays)
+    void clear();
+
+    // Add groups and tracks under a parent; INVALID when full
+    Node sequence(Node parent = ROOT);
+    Node parallel(Node parent = ROOT);
+    Node track(Node parent, AnimatedValue& value, const Keyframe* keys, uint8_t count, CurveType curve = CurveType::EASE_OUT);
+
+    // Lay out start times and apply the first keyframes
+    void start(int64_t nowMs);
+
+    // Apply every track at nowMs; returns false once the timeline has finished
+    bool update(int64_t nowMs);
+
+    bool isRunning() const { return running_; }
+    uint32_t duration() const { return nodes_[ROOT].durationMs; }
+
+private:
+    enum Kind : uint8_t { SEQUENCE, PARALLEL, TRACK };
+
+    struct NodeData {
+        Kind kind;
+        Node firstChild;
+        Node lastChild;
+        Node nextSibling;
+        uint8_t firstKey;
+        uint8_t keyCount;
+        CurveType curve;
+        AnimatedValue* value;
+        uint32_t startMs;     // Relative to the timeline start
+        uint32_t durationMs;
+    };
+
+    NodeData nodes_[MAX_NODES];
+    uint8_t nodeCount_;
+    uint16_t keyAt_[MAX_KEYFRAMES];
+    q16_t keyValue_[MAX_KEYFRAMES];
+    uint8_t keyCount_;
+
+    int64_t startedAt_;
+    bool running_;
+
+    Node add(Node parent, Kind kind);
+    uint32_t layout(Node node, uint32_t startMs);  // Returns the node's duration
+    void apply(const NodeData& track, uint32_t elapsedMs);
+    static q16_t curve(CurveType type, q16_t t);
+};
+
 // ============================================================
 // TaskListAnimationState - Task list animation state
 // Encapsulates all animation states needed for task list page
@@ -101,7 +262,7 @@ struct TaskListAnimationState {
     // Constructor - initializes with default values
     TaskListAnimationState();
 
-    // Update all animations
+    // Update all animations (steps the shared pool once)
     void updateAll(unsigned long deltaMs);
 
     // Check if any animation is in progress
@@ -2,11 +2,17 @@
 
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include <ArduinoJson.h>
 #include <U8g2_for_Adafruit_GFX.h>
 #include "Animation.h"
+#include "OledBus.h"
+#include "PageRaster.h"
+#include "Scheduler.h"
 #include "UIAnimation.h"
 #include "models/FocusProject.h"
 #include "models/FocusTask.h"
+#include "models/ScreenTransition.h"
+#include "models/TaskListMode.h"
 #include <vector>
 
 class DisplayController
@@ -24,8 +30,11 @@ public:
     void drawDoneScreen();
     void drawAdjustScreen(int duration);
     void drawProvisionScreen();
-    void drawTaskListScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted);
-    void drawTaskListViewScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted);
+    // order: 可选的排序索引（行号 → tasks 下标），nullptr 表示原始顺序 / Optional view index, nullptr = original order
+    void drawTaskListScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted,
+                            const uint16_t* order = nullptr, TaskSortMode sortMode = TaskSortMode::Default, char jumpInitial = 0);
+    void drawTaskListViewScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted,
+                                const uint16_t* order = nullptr, TaskSortMode sortMode = TaskSortMode::Default);
     void drawProjectSelectScreen(const std::vector<FocusProject>& projects, int selectedIndex, int displayOffset, const String& selectedProjectId, bool readOnly);
     void drawTaskDetailScreen(const String& projectName, const FocusTask& task, int selectedIndex, int displayOffset);
     void drawDurationSelectScreen(const String& taskName, int duration);
@@ -51,9 +60,24 @@ public:
     );
 
     void showAnimation(const byte frames[][288], int frameCount, bool loop = false, bool reverse = false, unsigned long durationMs = 0, int width = 48, int height = 48);
-    void updateAnimation();
     bool isAnimationRunning();
 
+    // 屏幕切换：截下当前画面，此后新状态的绘制只更新缓存的新画面，由切换任务按偏移拼合两帧，
+    // 每帧只做按页的内存拷贝，不重绘任一画面。帧动画开始时取消切换。
+    // Screen transition: snapshot the current screen; the new state's draws then only refresh the cached
+    // incoming frame and the transition task composes both by offset with per-page copies, never redrawing
+    // either screen. Starting a frame animation cancels the transition.
+    void beginTransition(ScreenTransition type);
+    bool isTransitionRunning() const { return transitionType != ScreenTransition::None; }
+
+    // 对比 GFX 与 PageRaster 绘制原语的耗时并校验结果一致（启动时调用，会清屏）
+    // Time GFX against PageRaster on the hot primitives and check the output matches (boot only; clears the screen)
+    void benchmarkRaster(Print& out);
+
+    // /api/status 的 display 字段（I2C 时钟、传输与错误计数、开机整帧刷新耗时）
+    // The "display" object of /api/status (I2C clock, transfer and error counts, boot full-frame flush time)
+    void writeStatus(JsonObject out);
+
     void showConfirmation();
     void showCancel();
     void showReset();
@@ -67,6 +91,90 @@ private:
     Adafruit_SSD1306 oled;
     U8G2_FOR_ADAFRUIT_GFX u8g2Fonts;
     Animation animation;
+    Scheduler::Handle animationTask; // 逐帧推进动画 / Advances the animation frame by frame
+
+    static void onAnimationFrame(void* arg);
+
+    // 填充/贴图走整字节原语，不经 GFX 逐像素 drawPixel() / Fills and blits use byte-wide primitives instead of GFX's per-pixel drawPixel()
+    PageRaster raster() { return PageRaster(oled.getBuffer(), oled.width(), oled.height()); }
+
+    size_t frameBytes; // 一帧缓冲的字节数（页格式）/ Bytes in one frame buffer (page layout)
+
+    uint8_t i2cAddress;
+    OledBus bus; // 刷新走这里，不经 Adafruit display() / Flushes go here rather than Adafruit display()
+    uint32_t bootFlushUs; // 开机实测整帧刷新耗时 / Full-frame flush measured at boot
+
+    // 已发送到屏上的帧：刷新时逐页比较，只发送每页变化的列段（计时每秒只改动变化的数字列）
+    // Frame last sent to the panel: flush() compares page by page and sends only each page's changed
+    // column span, so a timer tick only moves the digit columns that changed
+    uint8_t* shownFrame;
+    bool shownValid; // 帧动画直接刷屏后失效 / Invalidated when a frame animation writes the panel directly
+
+    uint8_t* staging; // 跨页窗口的数据按页拼接 / Data of a multi-page window, gathered page by page
+
+    void flush();      // 发送并处理传输错误 / Sends and handles transfer errors
+    void sendDirty();  // 整帧或各脏窗口 / Full frame or the dirty windows
+    void sendWindow(uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1);
+
+    // 一次窗口传输的固定开销折合字节数，相邻脏页合并窗口更省时即合并
+    // Fixed cost of one window transfer in byte-times; adjacent dirty pages merge when that is cheaper
+    static const int WINDOW_COST_BYTES = 12;
+
+    // 大号数字精灵（Org_01 ×5，基线 36），开机时栅格化一次。页格式下一列一个字节，贴图就是按字节或入，
+    // 不再每帧经过 GFX 的逐像素缩放绘制
+    // Large digit sprites (Org_01 x5, baseline 36) rasterized once at startup. In page layout a column is a
+    // byte, so a blit ORs bytes instead of going through GFX's scaled per-pixel glyph drawing every frame
+    static const uint8_t DIGIT_SCALE = 5;
+    static const int16_t DIGIT_BASELINE = 36;
+    static const uint8_t DIGIT_MAX_COLS = 32;
+    static const uint8_t DIGIT_MAX_PAGES = 5;
+
+    uint8_t digitAtlas[10][DIGIT_MAX_COLS * DIGIT_MAX_PAGES]; // 每个数字按页存放 / Per digit, page by page
+    uint8_t digitWidth[10];
+    uint8_t digitAdvance[10];
+    uint8_t digitFirstPage;
+    uint8_t digitPages;
+
+    void buildDigitAtlas();
+    void blitDigit(char c, int x);
+    void drawBigNumber(const char* text, int x); // 同 setCursor(x, 36) + print(text) / Same as setCursor(x, 36) + print(text)
+
+    // 静态底图：标题、边框、图标、固定标签，每个界面首次绘制时栅格化一次，之后每帧从缓存拷贝，只画动态部分
+    // Static chrome: titles, frames, icons and fixed labels are rasterized once on a screen's first draw;
+    // every later frame starts from a copy of the cache and only draws the dynamic parts
+    enum ChromeLayer : uint8_t {
+        ChromeIdle,
+        ChromeTimer,
+        ChromePaused,
+        ChromeAdjust,
+        CHROME_LAYER_COUNT
+    };
+
+    uint8_t* chromeCache; // CHROME_LAYER_COUNT 帧 / CHROME_LAYER_COUNT frames
+    uint8_t chromeValid;  // 已缓存的底图位图 / Bit per cached layer
+
+    // 代替 clearDisplay()：缓冲置为该界面的底图 / Replaces clearDisplay(): the buffer starts as the screen's chrome
+    void beginFrame(ChromeLayer layer);
+    void drawChrome(ChromeLayer layer);
+
+    // 屏幕切换 / Screen transition
+    ScreenTransition transitionType;
+    Timeline transitionTimeline;
+    AnimatedValue transitionOffset; // 0..宽度，已移动的像素列 / 0..width, columns moved so far
+    Scheduler::Handle transitionTask;
+    uint8_t* transitionFrom;        // 旧画面快照（SSD1306 页格式）/ Outgoing snapshot (SSD1306 page layout)
+    uint8_t* transitionTo;          // 新状态最近一次绘制 / Latest draw of the incoming state
+    bool transitionToValid;
+
+    static void onTransitionFrame(void* arg);
+    void composeTransition();
+    void finishTransition();
+
+    // 各 draw* 的收尾：切换中缓存新画面并拼合，否则直接刷新 / Ends every draw*: cache and compose while transitioning, else display
+    void present();
+
+    static const uint16_t TRANSITION_MS = 250;
+    static const uint32_t TRANSITION_FRAME_MS = 33; // 400 kHz I2C 一帧约 25 ms / One frame takes ~25 ms at 400 kHz I2C
 
     // Internal helper methods for animated drawing
     void drawSegmentControlAnimated(
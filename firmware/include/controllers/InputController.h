@@ -1,46 +1,130 @@
 #pragma once
 
 #include <Arduino.h>
-#include <OneButton.h>
-#include <RotaryEncoder.h>
-#include <functional>
+#include "InputEdgeRing.h"
+#include "InputEvent.h"
+#include "Scheduler.h"
+
+// 输入延迟统计（边沿可判定 → 状态处理完成，微秒）/ Input latency, recognisable edge -> state handled (us)
+struct InputLatencyStats
+{
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint32_t avgUs;     // 指数滑动平均 / Exponential moving average
+    uint32_t events;    // 已分发手势数 / Gestures delivered
+    uint32_t overflows; // 环形缓冲溢出丢弃的边沿数 / Edges dropped on ring overflow
+};
 
 class InputController
 {
 public:
     InputController(uint8_t buttonPin, uint8_t encoderPinA, uint8_t encoderPinB);
     void begin();
+
+    // 取出中断记录的边沿并解码为手势；未到期的单击/长按/去抖截止时间登记到调度器
+    // Drain ISR edges into gestures; pending click/long-press/debounce deadlines go to the scheduler
     void update();
 
-    void onPressHandler(std::function<void()> handler);
-    void onDoublePressHandler(std::function<void()> handler);
-    void onLongPressHandler(std::function<void()> handler);
-    void onEncoderRotateHandler(std::function<void(int delta)> handler);
+    // 所有手势送往同一个接收函数（由状态机分发），不再按状态注册回调，输入路径不分配内存
+    // Every gesture goes to one sink (the state machine); no per-state registration, so no allocation
+    void setInputSink(void (*sink)(const InputEvent& event));
+
+    // 切换状态时清除未完成的手势与编码器增量 / Drop half-detected gestures and encoder delta on state change
+    void reset();
 
-    void releaseHandlers();
+    InputLatencyStats getLatencyStats() const;
+
+    // 设置旋钮加速曲线（状态切换时由状态机调用）/ Set the encoder acceleration curve (called on state change)
+    void setEncoderProfile(const EncoderProfile& profile);
+
+    // 允许自动轻睡眠前后调用：边沿中断换成与当前电平相反的电平中断（同时作为 GPIO 唤醒源），
+    // 第一次触发时 ISR 立即换回边沿中断并照常记录这条边沿
+    // Around a sleep-eligible wait: swap the edge interrupts for level interrupts opposite to the current
+    // levels (also the GPIO wakeup source); the first one to fire restores edge interrupts from the ISR
+    // and records the edge as usual
+    void armWakeup();
+    void disarmWakeup();
+
+    // 手动轻睡眠被引脚唤醒后调用：ISR 未触发（引脚已回到原电平）时按当前电平补记一条边沿
+    // After a manual light sleep woken by a pin: if the ISR did not fire (the pin already returned), record the
+    // current levels as an edge
+    void recordWakeEdge();
 
 private:
-    OneButton button;
-    RotaryEncoder encoder;
+    // 按键手势识别状态 / Button gesture recogniser state
+    enum class ButtonPhase : uint8_t
+    {
+        Idle,      // 未按下 / Released
+        Down,      // 第一次按下 / First press held
+        Up,        // 第一次松开，等待是否双击 / Released once, waiting for a second press
+        DownAgain, // 第二次按下 / Second press held
+        Held,      // 已触发长按，等待松开 / Long press fired, waiting for release
+        Turning,   // 按住时转动过：旋转报 HoldRotate，松开不再报单击 / Turned while held: rotation is HoldRotate, release reports no click
+    };
 
     uint8_t buttonPin;
     uint8_t encoderPinA;
     uint8_t encoderPinB;
 
-    std::function<void()> pressHandler = nullptr;
-    std::function<void()> doublePressHandler = nullptr;
-    std::function<void()> longPressHandler = nullptr;
-    std::function<void(int delta)> encoderRotateHandler = nullptr;
+    void (*inputSink)(const InputEvent& event) = nullptr;
+
+    Scheduler::Handle tickTask = Scheduler::INVALID;
+    static void onTick(void* arg);
+    uint32_t msUntilNextTick();
+
+    InputEdgeRing<128> edges;
+
+    volatile bool wakeArmed; // 引脚处于电平唤醒配置 / Pins are configured for level wakeup
+
+    void IRAM_ATTR restoreEdgeInterrupts();
+
+    // 按键去抖 / Button debounce
+    bool rawPressed;
+    bool stablePressed;
+    uint32_t stableAtUs;
+    uint32_t rawAtUs;
+
+    // 手势识别 / Gesture recogniser
+    ButtonPhase phase;
+    uint32_t phaseAtUs; // 进入当前阶段的边沿时刻 / Edge time that entered the current phase
+
+    // 正交解码（与 RotaryEncoder TWO03 相同）/ Quadrature decoder (same as RotaryEncoder TWO03)
+    uint8_t quadState;
+    int quadPosition;
+    int detentPosition;
+    int pendingDelta;
+    uint32_t pendingDeltaUs; // 首个未上报步进的时刻 / Time of the first unreported detent
+
+    // 加速 / Acceleration
+    const EncoderProfile* encoderProfile;
+    uint32_t lastDetentUs;
+    int8_t lastDetentDir; // 0：无上一步 / 0: no previous detent
+
+    // 延迟统计 / Latency
+    uint32_t latencyLastUs;
+    uint32_t latencyMaxUs;
+    uint32_t latencyAvgUs;
+    uint32_t latencyEvents;
+
+    uint8_t readLevels() const;
+    void decodeEdge(const InputEdge& edge);
+    void decodeEncoder(uint8_t levels, uint32_t us);
+    int accelerate(int dir, uint32_t us);
+    void settleButton(uint32_t nowUs);
+    void acceptButton(bool pressed, uint32_t us);
+    void expireGesture(uint32_t nowUs);
+    void flushRotation();
+    void emit(Trigger gesture, int delta, uint32_t timestampUs);
 
-    int lastPosition;
+    static const uint8_t LEVEL_A = 0x01;
+    static const uint8_t LEVEL_B = 0x02;
+    static const uint8_t LEVEL_BUTTON = 0x04;
 
-    void onButtonClick();
-    void onButtonDoubleClick();
-    void onButtonLongPress();
-    void onEncoderRotate(int delta);
+    static const uint32_t DEBOUNCE_US = 20000;    // 去抖 20 ms
+    static const uint32_t CLICK_US = 150000;      // 双击窗口 150 ms / Double-click window
+    static const uint32_t LONG_PRESS_US = 400000; // 长按 400 ms
 
-    static void handleEncoderInterrupt();
-    static void handleButtonInterrupt();
+    static void handleInterrupt();
 };
 
 extern InputController inputController;
@@ -1,57 +1,120 @@
 #pragma once
 
-#include <Adafruit_NeoPixel.h>
+#include "NeoPixelRmt.h"
+#include "Scheduler.h"
 
+// LEDController / 灯环合成器
+//
+// 两层合成到同一帧：基础层是当前状态的动画（计时进度、呼吸……），切换时从上一帧的快照交叉淡化过去，
+// 不再先熄灭一帧；叠加层是短暂提示（如 webhook 成败闪烁），按混合方式叠在基础层之上，播完自动移除。
+// Two layers are composited into one frame. The base layer is the state's animation (timer progress,
+// breath...) and crossfades from a snapshot of the previous frame instead of blinking dark. The overlay
+// is a transient notice (e.g. a webhook result flash) blended on top and removed when it finishes.
 class LEDController
 {
 public:
+    // 叠加层与基础层的混合方式 / How the overlay combines with the base layer
+    enum BlendMode : uint8_t
+    {
+        Add,     // 按通道饱和相加 / Per-channel saturating add
+        Lighten, // 按通道取较亮者 / Per-channel maximum
+        Replace  // 叠加层非黑像素直接覆盖 / Non-black overlay pixels replace the base
+    };
+
     LEDController(uint8_t ledPin, uint16_t numLeds, uint8_t brightness = 255);
 
+    // 动画按输出的下一次可见变化排帧，无动画时不占用唤醒 / Frames are scheduled at the next visible change; no wakeups while idle
     void begin();
-    void update();
 
+    // 基础层 / Base layer
     void startFillAndDecay(uint32_t color, uint32_t totalDuration);
     void setSpinner(uint32_t color, int cycles);
     void setBreath(uint32_t color, int cycles, bool endFilled, uint32_t speed);
     void setSolid(uint32_t color);
-
     void turnOff();
+
+    // 叠加层：闪烁 pulses 次后移除，新的提示替换旧的 / Overlay: pulse `pulses` times then remove; a new notice replaces the old
+    void flash(uint32_t color, int pulses, BlendMode mode = Add);
+
     void printDebugInfo();
 
-private:
-    Adafruit_NeoPixel leds;
-    uint16_t numLeds;
-    uint8_t brightness;
-    int brightnessLevel;
+    // 等灯环发完在途帧（轻睡眠前）/ Let the ring finish the frame in flight (before light sleep)
+    bool waitIdle(uint32_t timeoutMs) { return leds.waitIdle(timeoutMs); }
 
+private:
     enum AnimationType
     {
         None,
+        Solid,
         FillAndDecay,
         Spinner,
         Breath
-    } currentAnimation;
-    unsigned long lastUpdateTime;
-
-    uint32_t animationColor;
-    uint32_t animationDuration;
-    uint32_t animationSpeed;
-
-    int currentStep;
-    int currentCycle;
-    int pixelIndex;
-    int animationCycles;
-    bool endFilled;
-    bool decayStarted;
-
-    // Animation handling methods / 各动画处理方法
-    void handleFillAndDecay();
-    void handleSpinner();
-    void handleBreath();
-
-    // Reset animation state / 重置动画状态
-    void stopCurrentAnimation();
-
-    // Helper to scale color by brightness / 根据亮度缩放颜色
-    uint32_t scaleColor(uint32_t color, uint8_t brightness);
+    };
+
+    // 动画是起始时刻之后经过时间的纯函数 / An animation is a pure function of the time since it started
+    struct Layer
+    {
+        AnimationType type;
+        int64_t startMs;
+        uint32_t color;
+        uint32_t duration;
+        uint32_t speed;
+        int cycles;
+        bool endFilled;
+        uint8_t floor; // 呼吸最低强度 / Lowest breath intensity
+        BlendMode blend;
+
+        // 亮度查找表：下标为强度（0..255，已做 gamma），值为该颜色的最终像素值，动画开始时生成一次
+        // Ramp LUT: index is intensity (0..255, gamma applied), value is the final pixel; built once per animation
+        uint32_t ramp[256];
+    };
+
+    NeoPixelRmt leds; // show() 只提交帧，由后台任务发送 / show() only posts; a background task sends it
+    uint16_t numLeds;
+    uint8_t brightness;
+
+    Layer base;
+    Layer overlay;
+    Scheduler::Handle frameTask;
+
+    uint32_t *baseFrame;  // 最近一次基础层输出（含淡化）/ Last base output, crossfade included
+    uint32_t *fadeFrom;   // 正在淡出的快照 / Snapshot being faded out
+    uint32_t *layerFrame; // 叠加层渲染缓冲 / Overlay render buffer
+    int64_t fadeStartMs;
+    bool fading;
+    bool baseRendered; // 新基础层是否已出过帧 / Whether the new base layer has produced a frame
+    uint32_t frames;   // 实际提交的帧数 / Frames actually posted
+
+    static void buildRamp(Layer &layer, uint32_t color, uint8_t peak);
+    Layer &beginBase(AnimationType type);
+    void requestFrame();
+
+    static void onFrame(void *arg);
+    void renderFrame();
+
+    // 绘制该层的当前帧，返回距下一次可见变化的毫秒数；已播完（画面不再变化）返回 UINT32_MAX
+    // Draw the layer's current frame; return ms until its output next changes, UINT32_MAX once it is final
+    uint32_t renderLayer(const Layer &layer, int64_t nowMs, uint32_t *out);
+
+    // 绘制 elapsedMs 时刻的一帧，返回下一次可见变化的时刻；动画结束返回 ANIMATION_END
+    // Draw the frame at elapsedMs and return when the output next changes; ANIMATION_END once finished
+    uint32_t renderFillAndDecay(const Layer &layer, uint32_t elapsedMs, uint32_t *out);
+    uint32_t renderSpinner(const Layer &layer, uint32_t elapsedMs, uint32_t *out);
+    uint32_t renderBreath(const Layer &layer, uint32_t elapsedMs, uint32_t *out);
+
+    static uint8_t breathLevel(const Layer &layer, uint32_t step);
+    static uint32_t nextRampChange(const Layer &layer, uint32_t sub); // ramp[255 - k] 首次不同于 ramp[255 - sub] 的 k / First k whose output differs
+
+    void fillFrame(uint32_t *out, uint32_t color);
+    static uint32_t blend(uint32_t below, uint32_t above, BlendMode mode);
+    static uint32_t mix(uint32_t from, uint32_t to, uint32_t weight); // weight 0..256 为 to 的占比 / weight 0..256 of `to`
+
+    static const uint32_t ANIMATION_END = UINT32_MAX;
+    static const uint32_t FILL_MS = 300;       // 开场填满整圈 / Time to fill the ring at the start
+    static const uint32_t SPINNER_STEP_MS = 100;
+    static const uint32_t BREATH_STEPS = 255;  // 每个呼吸周期的步数 / Steps per breath cycle
+    static const uint8_t BREATH_FLOOR = 104;   // gamma 后约 10%，呼吸不完全熄灭 / ~10% after gamma so the breath never goes dark
+    static const uint32_t FLASH_STEP_MS = 2;   // 一次闪烁约 0.5 s / About 0.5 s per flash
+    static const uint32_t CROSSFADE_MS = 250;
+    static const uint32_t CROSSFADE_FRAME_MS = 20;
 };
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
 #include <BluetoothA2DPSink.h>
 #include <WiFiProvisioner.h>
 #include <Preferences.h>
+#include "Scheduler.h"
+#include <atomic>
 #include <functional>
 
 class WebServer;
@@ -12,8 +15,12 @@ class NetworkController
 {
 public:
     NetworkController();
+    // HTTP 轮询与堆采样登记为可延后的调度任务 / HTTP polling and heap sampling run as deferrable scheduler tasks
     void begin();
-    void update();
+
+    // 无配网/蓝牙/待发 webhook 时可进入轻睡眠（WiFi 已在调制解调器睡眠下保持关联）
+    // Light sleep is allowed when not provisioning, no Bluetooth and no webhook in flight (WiFi stays associated in modem sleep)
+    bool canLightSleep();
     void startProvisioning();
     void stopProvisioning();
     void reset();
@@ -27,7 +34,9 @@ public:
     void sendWebhookPayload(const String &payload);
 
     // HTTP API callbacks / HTTP API 回调
-    void setTaskListUpdateCallback(std::function<void(const String&)> callback);
+    // 回调收到已解析并校验的文档（仅解析一次），返回是否接受（旧版本返回 false）
+    // Callback gets the parsed, validated document (parsed once) and returns whether it was accepted (false when stale)
+    void setTaskListUpdateCallback(std::function<bool(JsonDocument&)> callback);
 
 private:
     BluetoothA2DPSink a2dp_sink;
@@ -49,8 +58,10 @@ private:
     TaskHandle_t bluetoothTaskHandle;
     TaskHandle_t webhookTaskHandle;
     QueueHandle_t webhookQueue;
+    std::atomic<bool> webhookBusy; // webhook 任务正在发送 / Webhook task is mid-request
 
     static void bluetoothTask(void *param);
+    void notifyBluetoothTask(); // 蓝牙标志或连接状态变化时唤醒蓝牙任务 / Wake the Bluetooth task on a flag or link change
     static void webhookTask(void *param);
     bool sendWebhookRequest(const String &payload);
 
@@ -65,11 +76,30 @@ private:
     // HTTP Server / HTTP 服务器（用于 HA 下发任务列表等）
     WebServer* apiServer;
     bool apiServerStarted;
-    String lastTaskListJson;
-    std::function<void(const String&)> onTaskListUpdate;
+    uint32_t lastTaskListHash;       // CRC-32 of last accepted /api/tasklist body / 最近一次任务列表内容哈希
+    bool taskListLoaded;
+    std::function<bool(JsonDocument&)> onTaskListUpdate;
+
+    // Heap fragmentation watermark / 堆碎片水位
+    uint32_t minLargestFreeBlock;    // 最大可分配块的历史最小值 / Lowest largest-free-block seen
+    void sampleHeap();
+
+    // 调度任务 / Scheduler tasks
+    Scheduler::Handle pollTask;
+    Scheduler::Handle heapTask;
+    void update();
+    uint32_t msUntilNextPoll();         // WebServer 需要轮询 handleClient() / WebServer has to be polled via handleClient()
+    static void onPoll(void *arg);
+    static void onHeapSample(void *arg);
+
+    static const unsigned long HEAP_SAMPLE_INTERVAL = 1000; // ms
+    static const uint32_t API_POLL_INTERVAL = 20;           // ms, HTTP API 响应延迟上限 / HTTP API latency bound
+    static const uint32_t WIFI_POLL_INTERVAL = 250;         // ms, 未连接时重连/启动服务器 / Reconnect while offline
+    static const uint32_t BT_RECONNECT_INTERVAL = 2000;     // ms, 蓝牙断开时重连间隔 / Bluetooth reconnect interval
 
     void ensureApiServer();
     void setupApiServer();
     void handleAPITaskList();
     void handleAPIStatus();
+    String taskListETag() const;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <esp_pm.h>
+#include "EventQueue.h"
+#include "Transitions.h"
+
+// PowerController / 电源控制
+//
+// 空闲与休眠界面的等待期间进入轻睡眠，由定时器（下一个任务超时）或按键/旋钮 GPIO 唤醒。两种方式：
+// - 自动（固件启用 CONFIG_PM_ENABLE 与 CONFIG_FREERTOS_USE_TICKLESS_IDLE 时）：平时持有 NO_LIGHT_SLEEP 锁，等待期间释放，
+//   FreeRTOS 空闲时芯片自行睡眠；WiFi 最小调制解调器睡眠按 DTIM 收信标，保持关联，接口随时可达。
+// - 手动（默认 Arduino 构建没有上述选项，esp_pm_configure 失败）：等待改为 esp_light_sleep_start()，射频随 CPU 一起停，
+//   每段最长 LIGHT_SLEEP_MAX_MS。睡眠期间收不到信标和请求：HTTP 请求要等到醒来的间隙才被处理，可能超时，
+//   长时间停在休眠界面时路由器也可能断开关联（醒来后由 WiFi 自动重连）。
+// 板上没有电流采样电路，current_ma_est 是按睡眠时间占比与 Config.h 中两个恒定电流估算的模型值，不是实测。
+//
+// Idle and Sleep screens light-sleep while they wait, woken by the timer (the next task timeout) or a
+// button/encoder GPIO. Two modes:
+// - Automatic (firmware built with CONFIG_PM_ENABLE and CONFIG_FREERTOS_USE_TICKLESS_IDLE): a NO_LIGHT_SLEEP
+//   lock is held normally and released during the wait, so the chip sleeps whenever FreeRTOS idles; WiFi
+//   minimum modem sleep keeps receiving DTIM beacons, the station stays associated and the API stays reachable.
+// - Manual (the stock Arduino build lacks those options and esp_pm_configure fails): the wait becomes
+//   esp_light_sleep_start(), which stops the radio along with the CPU, for at most LIGHT_SLEEP_MAX_MS per wait.
+//   Beacons and requests are missed while asleep: HTTP requests are only served in the gaps between sleeps and
+//   may time out, and a long stay on the sleep screen can get the station disassociated (WiFi reconnects on wake).
+// The board has no current sensor: current_ma_est is a model built from the sleep share and two constant
+// currents in Config.h, not a measurement.
+class PowerController
+{
+public:
+    PowerController();
+
+    void begin();
+
+    // 开始一段允许轻睡眠的等待（布防 GPIO 唤醒、释放睡眠锁）；不能睡时返回 false，无需调用 endSleepWait
+    // Start a wait in which light sleep is allowed (arm GPIO wakeup, release the lock); false when sleep is not
+    // possible, in which case endSleepWait must not be called
+    bool beginSleepWait();
+
+    // 在 begin/endSleepWait 之间等待事件：自动模式阻塞在队列上，手动模式轻睡眠最多 ms 后取事件
+    // Wait for an event between begin/endSleepWait: blocks on the queue in automatic mode, light-sleeps up to
+    // ms and then takes an event in manual mode
+    bool sleepWait(Event &event, uint32_t ms);
+    void endSleepWait();
+
+    // 状态切换时调用，结算上一状态的驻留时间 / Called on state change to close the previous state's residency
+    void enterState(StateId id);
+
+    // /api/status 的 power 字段 / The "power" object of /api/status
+    void writeStatus(JsonObject out);
+
+private:
+    struct Residency
+    {
+        uint64_t totalUs;
+        uint64_t sleepUs;
+        uint32_t wakeups;
+    };
+
+    Residency residency[(size_t)StateId::Count];
+    StateId currentId;
+    int64_t enteredAtUs;
+    uint32_t rejects; // 未能允许轻睡眠的次数 / Sleep-eligible waits that could not start
+    bool autoLightSleep;          // esp_pm 自动轻睡眠是否可用 / Whether esp_pm automatic light sleep is available
+    esp_pm_lock_handle_t awakeLock; // 持有期间不进入轻睡眠 / No light sleep while held
+    int64_t sleepStartUs;
+
+    static float estimateMa(uint64_t totalUs, uint64_t sleepUs);
+
+    static const int PM_MIN_FREQ_MHZ = 80;     // APB 保持 80 MHz，RMT/I2C/UART 时序不变 / Keeps APB at 80 MHz so RMT/I2C/UART timing holds
+    static const uint32_t LED_IDLE_WAIT_MS = 5; // 16 颗灯一帧约 0.6 ms / A 16-LED frame takes about 0.6 ms
+};
+
+extern PowerController powerController;
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+// FocusClock / 专注计时时钟
+//
+// 基于 esp_timer_get_time() 的 64 位单调微秒时钟，不会像 millis() 那样 49 天回绕。
+// 暂停前的已用时长以微秒累计，随会话在状态间复制时不取整，暂停/恢复多少次都不丢时间。
+// 64-bit monotonic microseconds from esp_timer_get_time(), so no 49-day millis() wrap. Elapsed time
+// before a pause is kept in microseconds and copied between states unrounded, so pause/resume loses nothing.
+struct FocusClock {
+    int64_t accumulatedUs = 0;   // 之前各段运行累计 / Sum of previous running spans
+    int64_t runningSinceUs = -1; // 本段开始时刻，-1 表示已停止 / Start of the current span, -1 when stopped
+
+    static int64_t now() { return esp_timer_get_time(); }
+
+    bool running() const { return runningSinceUs >= 0; }
+
+    void start()
+    {
+        if (!running())
+        {
+            runningSinceUs = now();
+        }
+    }
+
+    void stop()
+    {
+        if (running())
+        {
+            accumulatedUs += now() - runningSinceUs;
+            runningSinceUs = -1;
+        }
+    }
+
+    void reset()
+    {
+        accumulatedUs = 0;
+        runningSinceUs = -1;
+    }
+
+    int64_t elapsedUs() const { return accumulatedUs + (running() ? now() - runningSinceUs : 0); }
+};
+
+// FocusSession / 一次专注会话的上下文（计时、暂停、专注中查看列表之间传递）
+struct FocusSession {
+    int duration = 0;              // 计划时长（分钟）
+    FocusClock clock;              // 已专注时长 / Focused time so far
+    String taskId;
+    String taskName;
+    String taskDisplayName;
+    String taskProjectId;
+    String sessionId;
+
+    bool hasTask() const { return !taskId.isEmpty(); }
+
+    int64_t durationUs() const { return (int64_t)duration * 60 * 1000000; }
+
+    // 运行中的绝对结束时刻（esp_timer 时基）/ Absolute end deadline on the esp_timer clock while running
+    int64_t endDeadlineUs() const { return clock.runningSinceUs + durationUs() - clock.accumulatedUs; }
+
+    int64_t remainingUs() const
+    {
+        const int64_t remaining = durationUs() - clock.elapsedUs();
+        return remaining > 0 ? remaining : 0;
+    }
+
+    // 上报用整秒（仅在发送时取整）/ Whole seconds for webhooks, truncated only when reported
+    uint32_t elapsedSeconds() const { return (uint32_t)(clock.elapsedUs() / 1000000); }
+
+    // 倒计时显示向上取整：开始时显示满时长，到 0 即结束 / Countdown rounds up: full duration at start, 0 at the end
+    int remainingSeconds() const { return (int)((remainingUs() + 999999) / 1000000); }
+};
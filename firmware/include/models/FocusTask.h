@@ -28,6 +28,7 @@ struct FocusTask {
     int priority = 0;          // 0/1/3/5
     String priorityFlag;       // H/M/L/-
     String dueMmdd;            // 截止日期（MM.DD）
+    uint32_t dueYmd = 0;       // 截止日期 YYYYMMDD，用于跨年排序；0 表示未下发 / Due date as YYYYMMDD for sorting across years; 0 if not sent
     bool hasRepeat = false;    // 是否重复
     bool hasReminder = false;  // 是否提醒
 
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+// 状态之间的屏幕切换效果 / How the screen changes between two states
+// Push：旧画面被新画面推出；Slide：新画面滑入覆盖静止的旧画面
+// Push: the new screen pushes the old one out; Slide: the new screen slides over the still old one
+enum class ScreenTransition : uint8_t {
+    None = 0,
+    PushLeft = 1,   // 前进 / Forward
+    PushRight = 2,  // 返回 / Back
+    SlideLeft = 3,  // 打开子页面 / Open a sub-page
+    SlideRight = 4, // 关闭子页面（旧画面滑出）/ Close a sub-page (the old screen slides away)
+};
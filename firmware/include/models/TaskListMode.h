@@ -9,3 +9,14 @@ enum class TaskListMode : uint8_t {
     Projects = 2,
 };
 
+
+// 任务排序视图：原始顺序 / 优先级 / 截止日期 / 今日用时
+// 索引在列表更新时一次性构建，切换视图只换索引数组，不重排不复制
+enum class TaskSortMode : uint8_t {
+    Default = 0,
+    Priority = 1,
+    Due = 2,
+    Spent = 3,
+};
+
+static const uint8_t TASK_SORT_MODE_COUNT = 4;
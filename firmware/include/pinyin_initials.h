@@ -0,0 +1,368 @@
+#pragma once
+
+#include <Arduino.h>
+
+// --- Pinyin initials --- 拼音首字母表
+//
+// GB2312 一级汉字（3755 个，按拼音排序）的 Unicode 码点与拼音首字母，按码点升序排列，供二分查找。
+// 多音字取 GB2312 排序所用读音；二级汉字不在表内（按 '#' 归类）。
+
+static const uint16_t PINYIN_TABLE_SIZE = 3755;
+
+static const uint16_t PROGMEM pinyin_codepoints[] = {
+    0x4E00, 0x4E01, 0x4E03, 0x4E07, 0x4E08, 0x4E09, 0x4E0A, 0x4E0B, 0x4E0D, 0x4E0E, 0x4E11, 0x4E13,
+    0x4E14, 0x4E16, 0x4E18, 0x4E19, 0x4E1A, 0x4E1B, 0x4E1C, 0x4E1D, 0x4E22, 0x4E24, 0x4E25, 0x4E27,
+    0x4E2A, 0x4E2B, 0x4E2D, 0x4E30, 0x4E32, 0x4E34, 0x4E38, 0x4E39, 0x4E3A, 0x4E3B, 0x4E3D, 0x4E3E,
+    0x4E43, 0x4E45, 0x4E48, 0x4E49, 0x4E4B, 0x4E4C, 0x4E4D, 0x4E4E, 0x4E4F, 0x4E50, 0x4E52, 0x4E53,
+    0x4E54, 0x4E56, 0x4E58, 0x4E59, 0x4E5D, 0x4E5E, 0x4E5F, 0x4E60, 0x4E61, 0x4E66, 0x4E70, 0x4E71,
+    0x4E73, 0x4E7E, 0x4E86, 0x4E88, 0x4E89, 0x4E8B, 0x4E8C, 0x4E8E, 0x4E8F, 0x4E91, 0x4E92, 0x4E94,
+    0x4E95, 0x4E9A, 0x4E9B, 0x4EA1, 0x4EA2, 0x4EA4, 0x4EA5, 0x4EA6, 0x4EA7, 0x4EA8, 0x4EA9, 0x4EAB,
+    0x4EAC, 0x4EAD, 0x4EAE, 0x4EB2, 0x4EBA, 0x4EBF, 0x4EC0, 0x4EC1, 0x4EC5, 0x4EC6, 0x4EC7, 0x4ECA,
+    0x4ECB, 0x4ECD, 0x4ECE, 0x4ED1, 0x4ED3, 0x4ED4, 0x4ED5, 0x4ED6, 0x4ED7, 0x4ED8, 0x4ED9, 0x4EDF,
+    0x4EE3, 0x4EE4, 0x4EE5, 0x4EEA, 0x4EEC, 0x4EF0, 0x4EF2, 0x4EF6, 0x4EF7, 0x4EFB, 0x4EFD, 0x4EFF,
+    0x4F01, 0x4F0A, 0x4F0D, 0x4F0E, 0x4F0F, 0x4F10, 0x4F11, 0x4F17, 0x4F18, 0x4F19, 0x4F1A, 0x4F1E,
+    0x4F1F, 0x4F20, 0x4F24, 0x4F26, 0x4F2A, 0x4F2F, 0x4F30, 0x4F34, 0x4F36, 0x4F38, 0x4F3A, 0x4F3C,
+    0x4F43, 0x4F46, 0x4F4D, 0x4F4E, 0x4F4F, 0x4F50, 0x4F51, 0x4F53, 0x4F55, 0x4F59, 0x4F5B, 0x4F5C,
+    0x4F60, 0x4F63, 0x4F69, 0x4F6C, 0x4F6F, 0x4F70, 0x4F73, 0x4F7F, 0x4F84, 0x4F88, 0x4F8B, 0x4F8D,
+    0x4F97, 0x4F9B, 0x4F9D, 0x4FA0, 0x4FA3, 0x4FA5, 0x4FA6, 0x4FA7, 0x4FA8, 0x4FA9, 0x4FAE, 0x4FAF,
+    0x4FB5, 0x4FBF, 0x4FC3, 0x4FC4, 0x4FCA, 0x4FCF, 0x4FD0, 0x4FD7, 0x4FD8, 0x4FDD, 0x4FDE, 0x4FE1,
+    0x4FE9, 0x4FED, 0x4FEE, 0x4FEF, 0x4FF1, 0x4FFA, 0x500D, 0x5012, 0x5014, 0x5018, 0x5019, 0x501A,
+    0x501F, 0x5021, 0x5026, 0x502A, 0x503A, 0x503C, 0x503E, 0x5047, 0x504F, 0x505A, 0x505C, 0x5065,
+    0x5076, 0x5077, 0x507F, 0x5080, 0x5085, 0x5088, 0x508D, 0x50A3, 0x50A8, 0x50AC, 0x50B2, 0x50BB,
+    0x50CF, 0x50DA, 0x50E7, 0x50F3, 0x50F5, 0x50FB, 0x5112, 0x5121, 0x513F, 0x5141, 0x5143, 0x5144,
+    0x5145, 0x5146, 0x5148, 0x5149, 0x514B, 0x514D, 0x5151, 0x5154, 0x515A, 0x515C, 0x5162, 0x5165,
+    0x5168, 0x516B, 0x516C, 0x516D, 0x5170, 0x5171, 0x5173, 0x5174, 0x5175, 0x5176, 0x5177, 0x5178,
+    0x5179, 0x517B, 0x517C, 0x517D, 0x5180, 0x5185, 0x5188, 0x5189, 0x518C, 0x518D, 0x5192, 0x5195,
+    0x5197, 0x5199, 0x519B, 0x519C, 0x51A0, 0x51A4, 0x51AC, 0x51AF, 0x51B0, 0x51B2, 0x51B3, 0x51B5,
+    0x51B6, 0x51B7, 0x51BB, 0x51C0, 0x51C4, 0x51C6, 0x51C9, 0x51CB, 0x51CC, 0x51CF, 0x51D1, 0x51DB,
+    0x51DD, 0x51E0, 0x51E1, 0x51E4, 0x51ED, 0x51EF, 0x51F0, 0x51F3, 0x51F6, 0x51F8, 0x51F9, 0x51FA,
+    0x51FB, 0x51FD, 0x51FF, 0x5200, 0x5201, 0x5203, 0x5206, 0x5207, 0x520A, 0x5211, 0x5212, 0x5217,
+    0x5218, 0x5219, 0x521A, 0x521B, 0x521D, 0x5220, 0x5224, 0x5228, 0x5229, 0x522B, 0x522E, 0x5230,
+    0x5236, 0x5237, 0x5238, 0x5239, 0x523A, 0x523B, 0x523D, 0x5241, 0x5242, 0x5243, 0x524A, 0x524D,
+    0x5250, 0x5251, 0x5254, 0x5256, 0x5265, 0x5267, 0x5269, 0x526A, 0x526F, 0x5272, 0x527F, 0x5288,
+    0x529B, 0x529D, 0x529E, 0x529F, 0x52A0, 0x52A1, 0x52A3, 0x52A8, 0x52A9, 0x52AA, 0x52AB, 0x52B1,
+    0x52B2, 0x52B3, 0x52BF, 0x52C3, 0x52C7, 0x52C9, 0x52CB, 0x52D2, 0x52D8, 0x52DF, 0x52E4, 0x52FA,
+    0x52FE, 0x52FF, 0x5300, 0x5305, 0x5306, 0x5308, 0x5316, 0x5317, 0x5319, 0x531D, 0x5320, 0x5321,
+    0x5323, 0x532A, 0x5339, 0x533A, 0x533B, 0x533F, 0x5341, 0x5343, 0x5347, 0x5348, 0x5349, 0x534A,
+    0x534E, 0x534F, 0x5351, 0x5352, 0x5353, 0x5355, 0x5356, 0x5357, 0x535A, 0x535C, 0x535E, 0x5360,
+    0x5361, 0x5362, 0x5364, 0x5367, 0x536B, 0x536F, 0x5370, 0x5371, 0x5373, 0x5374, 0x5375, 0x5377,
+    0x5378, 0x537F, 0x5382, 0x5384, 0x5385, 0x5386, 0x5389, 0x538B, 0x538C, 0x5395, 0x5398, 0x539A,
+    0x539F, 0x53A2, 0x53A6, 0x53A8, 0x53A9, 0x53BB, 0x53BF, 0x53C1, 0x53C2, 0x53C8, 0x53C9, 0x53CA,
+    0x53CB, 0x53CC, 0x53CD, 0x53D1, 0x53D4, 0x53D6, 0x53D7, 0x53D8, 0x53D9, 0x53DB, 0x53E0, 0x53E3,
+    0x53E4, 0x53E5, 0x53E6, 0x53EA, 0x53EB, 0x53EC, 0x53ED, 0x53EE, 0x53EF, 0x53F0, 0x53F2, 0x53F3,
+    0x53F6, 0x53F7, 0x53F8, 0x53F9, 0x53FC, 0x5401, 0x5403, 0x5404, 0x5408, 0x5409, 0x540A, 0x540C,
+    0x540D, 0x540E, 0x540F, 0x5410, 0x5411, 0x5413, 0x5415, 0x5417, 0x541B, 0x541D, 0x541E, 0x541F,
+    0x5420, 0x5426, 0x5427, 0x5428, 0x5429, 0x542B, 0x542C, 0x542D, 0x542E, 0x542F, 0x5431, 0x5434,
+    0x5435, 0x5438, 0x5439, 0x543B, 0x543C, 0x543E, 0x5440, 0x5446, 0x5448, 0x544A, 0x5450, 0x5455,
+    0x5458, 0x545B, 0x545C, 0x5462, 0x5468, 0x5473, 0x5475, 0x5478, 0x547B, 0x547C, 0x547D, 0x5480,
+    0x5486, 0x548B, 0x548C, 0x548E, 0x548F, 0x5490, 0x5492, 0x5495, 0x5496, 0x5499, 0x54A8, 0x54AC,
+    0x54AF, 0x54B1, 0x54B3, 0x54B8, 0x54BD, 0x54C0, 0x54C1, 0x54C4, 0x54C6, 0x54C7, 0x54C8, 0x54C9,
+    0x54CD, 0x54CE, 0x54D1, 0x54D7, 0x54DF, 0x54E5, 0x54E6, 0x54E8, 0x54E9, 0x54EA, 0x54ED, 0x54EE,
+    0x54F2, 0x54FA, 0x54FC, 0x5501, 0x5506, 0x5507, 0x5509, 0x5510, 0x5524, 0x552C, 0x552E, 0x552F,
+    0x5531, 0x553E, 0x5543, 0x5544, 0x5546, 0x554A, 0x5561, 0x5564, 0x5565, 0x5566, 0x556A, 0x556E,
+    0x5578, 0x557C, 0x5580, 0x5582, 0x5584, 0x5587, 0x5589, 0x558A, 0x5598, 0x559C, 0x559D, 0x55A7,
+    0x55B3, 0x55B7, 0x55BB, 0x55C5, 0x55D3, 0x55DC, 0x55E1, 0x55E3, 0x55FD, 0x5609, 0x560E, 0x5618,
+    0x561B, 0x5631, 0x5632, 0x5634, 0x5636, 0x563B, 0x563F, 0x564E, 0x5668, 0x566A, 0x566C, 0x5676,
+    0x568E, 0x568F, 0x56A3, 0x56B7, 0x56BC, 0x56CA, 0x56DA, 0x56DB, 0x56DE, 0x56E0, 0x56E2, 0x56E4,
+    0x56ED, 0x56F0, 0x56F1, 0x56F4, 0x56FA, 0x56FD, 0x56FE, 0x5703, 0x5706, 0x5708, 0x571F, 0x5723,
+    0x5728, 0x572D, 0x5730, 0x573A, 0x573E, 0x5740, 0x5747, 0x574A, 0x574D, 0x574E, 0x574F, 0x5750,
+    0x5751, 0x5757, 0x575A, 0x575B, 0x575D, 0x575E, 0x575F, 0x5760, 0x5761, 0x5764, 0x5766, 0x576A,
+    0x576F, 0x5777, 0x5782, 0x5783, 0x5784, 0x578B, 0x5792, 0x579B, 0x57A2, 0x57A3, 0x57A6, 0x57AB,
+    0x57AE, 0x57C2, 0x57C3, 0x57CB, 0x57CE, 0x57D4, 0x57DF, 0x57E0, 0x57F9, 0x57FA, 0x5802, 0x5806,
+    0x5811, 0x5815, 0x5821, 0x5824, 0x582A, 0x5830, 0x5835, 0x584C, 0x5851, 0x5854, 0x5858, 0x585E,
+    0x586B, 0x5883, 0x5885, 0x5892, 0x5893, 0x5899, 0x589E, 0x589F, 0x58A8, 0x58A9, 0x58C1, 0x58D5,
+    0x58E4, 0x58EB, 0x58EC, 0x58EE, 0x58F0, 0x58F3, 0x58F6, 0x58F9, 0x5904, 0x5907, 0x590D, 0x590F,
+    0x5915, 0x5916, 0x591A, 0x591C, 0x591F, 0x5927, 0x5929, 0x592A, 0x592B, 0x592E, 0x592F, 0x5931,
+    0x5934, 0x5937, 0x5938, 0x5939, 0x593A, 0x5944, 0x5947, 0x5948, 0x5949, 0x594B, 0x594E, 0x594F,
+    0x5951, 0x5954, 0x5956, 0x5957, 0x5960, 0x5962, 0x5965, 0x5973, 0x5974, 0x5976, 0x5978, 0x5979,
+    0x597D, 0x5982, 0x5984, 0x5986, 0x5987, 0x5988, 0x598A, 0x5992, 0x5993, 0x5996, 0x5999, 0x59A5,
+    0x59A8, 0x59AE, 0x59B9, 0x59BB, 0x59C6, 0x59CB, 0x59D0, 0x59D1, 0x59D3, 0x59D4, 0x59DA, 0x59DC,
+    0x59E5, 0x59E8, 0x59EC, 0x59FB, 0x59FF, 0x5A01, 0x5A03, 0x5A04, 0x5A07, 0x5A18, 0x5A1C, 0x5A1F,
+    0x5A20, 0x5A25, 0x5A29, 0x5A31, 0x5A36, 0x5A46, 0x5A49, 0x5A5A, 0x5A6A, 0x5A74, 0x5A76, 0x5A7F,
+    0x5A92, 0x5A9A, 0x5AB3, 0x5AC1, 0x5AC2, 0x5AC9, 0x5ACC, 0x5AE1, 0x5AE9, 0x5B50, 0x5B54, 0x5B55,
+    0x5B57, 0x5B58, 0x5B59, 0x5B5C, 0x5B5D, 0x5B5F, 0x5B63, 0x5B64, 0x5B66, 0x5B69, 0x5B6A, 0x5B70,
+    0x5B75, 0x5B7A, 0x5B7D, 0x5B81, 0x5B83, 0x5B85, 0x5B87, 0x5B88, 0x5B89, 0x5B8B, 0x5B8C, 0x5B8F,
+    0x5B97, 0x5B98, 0x5B99, 0x5B9A, 0x5B9B, 0x5B9C, 0x5B9D, 0x5B9E, 0x5BA0, 0x5BA1, 0x5BA2, 0x5BA3,
+    0x5BA4, 0x5BA6, 0x5BAA, 0x5BAB, 0x5BB0, 0x5BB3, 0x5BB4, 0x5BB5, 0x5BB6, 0x5BB9, 0x5BBD, 0x5BBE,
+    0x5BBF, 0x5BC2, 0x5BC4, 0x5BC5, 0x5BC6, 0x5BC7, 0x5BCC, 0x5BD0, 0x5BD2, 0x5BD3, 0x5BDD, 0x5BDE,
+    0x5BDF, 0x5BE1, 0x5BE5, 0x5BE8, 0x5BF8, 0x5BF9, 0x5BFA, 0x5BFB, 0x5BFC, 0x5BFF, 0x5C01, 0x5C04,
+    0x5C06, 0x5C09, 0x5C0A, 0x5C0F, 0x5C11, 0x5C14, 0x5C16, 0x5C18, 0x5C1A, 0x5C1D, 0x5C24, 0x5C27,
+    0x5C31, 0x5C38, 0x5C39, 0x5C3A, 0x5C3C, 0x5C3D, 0x5C3E, 0x5C3F, 0x5C40, 0x5C41, 0x5C42, 0x5C45,
+    0x5C48, 0x5C49, 0x5C4A, 0x5C4B, 0x5C4E, 0x5C4F, 0x5C51, 0x5C55, 0x5C5E, 0x5C60, 0x5C61, 0x5C65,
+    0x5C6F, 0x5C71, 0x5C79, 0x5C7F, 0x5C81, 0x5C82, 0x5C94, 0x5C97, 0x5C9B, 0x5CA9, 0x5CAD, 0x5CB3,
+    0x5CB8, 0x5CBF, 0x5CD9, 0x5CE1, 0x5CE6, 0x5CE8, 0x5CEA, 0x5CED, 0x5CF0, 0x5CFB, 0x5D07, 0x5D0E,
+    0x5D14, 0x5D16, 0x5D29, 0x5D2D, 0x5D4C, 0x5DCD, 0x5DDD, 0x5DDE, 0x5DE1, 0x5DE2, 0x5DE5, 0x5DE6,
+    0x5DE7, 0x5DE8, 0x5DE9, 0x5DEB, 0x5DEE, 0x5DF1, 0x5DF2, 0x5DF3, 0x5DF4, 0x5DF7, 0x5DFE, 0x5E01,
+    0x5E02, 0x5E03, 0x5E05, 0x5E06, 0x5E08, 0x5E0C, 0x5E10, 0x5E15, 0x5E16, 0x5E18, 0x5E1A, 0x5E1B,
+    0x5E1C, 0x5E1D, 0x5E26, 0x5E27, 0x5E2D, 0x5E2E, 0x5E38, 0x5E3D, 0x5E42, 0x5E45, 0x5E4C, 0x5E55,
+    0x5E62, 0x5E72, 0x5E73, 0x5E74, 0x5E76, 0x5E78, 0x5E7B, 0x5E7C, 0x5E7D, 0x5E7F, 0x5E84, 0x5E86,
+    0x5E87, 0x5E8A, 0x5E8F, 0x5E90, 0x5E93, 0x5E94, 0x5E95, 0x5E97, 0x5E99, 0x5E9A, 0x5E9C, 0x5E9E,
+    0x5E9F, 0x5EA6, 0x5EA7, 0x5EAD, 0x5EB6, 0x5EB7, 0x5EB8, 0x5EC9, 0x5ECA, 0x5ED3, 0x5ED6, 0x5EF6,
+    0x5EF7, 0x5EFA, 0x5F00, 0x5F02, 0x5F03, 0x5F04, 0x5F0A, 0x5F0F, 0x5F13, 0x5F15, 0x5F17, 0x5F18,
+    0x5F1B, 0x5F1F, 0x5F20, 0x5F25, 0x5F26, 0x5F27, 0x5F2F, 0x5F31, 0x5F39, 0x5F3A, 0x5F52, 0x5F53,
+    0x5F55, 0x5F5D, 0x5F62, 0x5F64, 0x5F66, 0x5F69, 0x5F6A, 0x5F6C, 0x5F6D, 0x5F70, 0x5F71, 0x5F79,
+    0x5F7B, 0x5F7C, 0x5F80, 0x5F81, 0x5F84, 0x5F85, 0x5F88, 0x5F8A, 0x5F8B, 0x5F90, 0x5F92, 0x5F97,
+    0x5F98, 0x5FA1, 0x5FAA, 0x5FAE, 0x5FB7, 0x5FBD, 0x5FC3, 0x5FC5, 0x5FC6, 0x5FCC, 0x5FCD, 0x5FD7,
+    0x5FD8, 0x5FD9, 0x5FE0, 0x5FE7, 0x5FEB, 0x5FF1, 0x5FF5, 0x5FFB, 0x5FFD, 0x5FFF, 0x6000, 0x6001,
+    0x6002, 0x600E, 0x6012, 0x6014, 0x6015, 0x6016, 0x601C, 0x601D, 0x6020, 0x6025, 0x6027, 0x6028,
+    0x602A, 0x602F, 0x603B, 0x6043, 0x604B, 0x604D, 0x6050, 0x6052, 0x6055, 0x6062, 0x6064, 0x6068,
+    0x6069, 0x606B, 0x606C, 0x606D, 0x606F, 0x6070, 0x6073, 0x6076, 0x607C, 0x607F, 0x6084, 0x6089,
+    0x608D, 0x6094, 0x609F, 0x60A0, 0x60A3, 0x60A6, 0x60A8, 0x60AC, 0x60AF, 0x60B2, 0x60B8, 0x60BC,
+    0x60C5, 0x60CA, 0x60CB, 0x60D1, 0x60D5, 0x60DC, 0x60DF, 0x60E0, 0x60E6, 0x60E7, 0x60E8, 0x60E9,
+    0x60EB, 0x60ED, 0x60EE, 0x60EF, 0x60F0, 0x60F3, 0x60F6, 0x60F9, 0x60FA, 0x6101, 0x6108, 0x6109,
+    0x610F, 0x611A, 0x611F, 0x6124, 0x6127, 0x613F, 0x6148, 0x614C, 0x614E, 0x6151, 0x6155, 0x6162,
+    0x6167, 0x6168, 0x6170, 0x6177, 0x618B, 0x618E, 0x61A8, 0x61BE, 0x61C2, 0x61C8, 0x61CA, 0x61D2,
+    0x61E6, 0x6208, 0x620A, 0x620C, 0x620D, 0x620E, 0x620F, 0x6210, 0x6211, 0x6212, 0x6216, 0x6218,
+    0x621A, 0x622A, 0x622E, 0x6233, 0x6234, 0x6237, 0x623F, 0x6240, 0x6241, 0x6247, 0x624B, 0x624D,
+    0x624E, 0x6251, 0x6252, 0x6253, 0x6254, 0x6258, 0x625B, 0x6263, 0x6266, 0x6267, 0x6269, 0x626B,
+    0x626C, 0x626D, 0x626E, 0x626F, 0x6270, 0x6273, 0x6276, 0x6279, 0x627C, 0x627E, 0x627F, 0x6280,
+    0x6284, 0x6289, 0x628A, 0x6291, 0x6292, 0x6293, 0x6295, 0x6296, 0x6297, 0x6298, 0x629A, 0x629B,
+    0x62A0, 0x62A1, 0x62A2, 0x62A4, 0x62A5, 0x62A8, 0x62AB, 0x62AC, 0x62B1, 0x62B5, 0x62B9, 0x62BC,
+    0x62BD, 0x62BF, 0x62C2, 0x62C4, 0x62C5, 0x62C6, 0x62C7, 0x62C8, 0x62C9, 0x62CC, 0x62CD, 0x62CE,
+    0x62D0, 0x62D2, 0x62D3, 0x62D4, 0x62D6, 0x62D8, 0x62D9, 0x62DB, 0x62DC, 0x62DF, 0x62E2, 0x62E3,
+    0x62E5, 0x62E6, 0x62E7, 0x62E8, 0x62E9, 0x62EC, 0x62ED, 0x62EF, 0x62F1, 0x62F3, 0x62F4, 0x62F7,
+    0x62FC, 0x62FD, 0x62FE, 0x62FF, 0x6301, 0x6302, 0x6307, 0x6309, 0x630E, 0x6311, 0x6316, 0x631A,
+    0x631B, 0x631D, 0x631E, 0x631F, 0x6320, 0x6321, 0x6323, 0x6324, 0x6325, 0x6328, 0x632A, 0x632B,
+    0x632F, 0x633A, 0x633D, 0x6342, 0x6345, 0x6346, 0x6349, 0x634C, 0x634D, 0x634E, 0x634F, 0x6350,
+    0x6355, 0x635E, 0x635F, 0x6361, 0x6362, 0x6363, 0x6367, 0x636E, 0x6376, 0x6377, 0x637B, 0x6380,
+    0x6382, 0x6387, 0x6388, 0x6389, 0x638C, 0x638F, 0x6390, 0x6392, 0x6396, 0x6398, 0x63A0, 0x63A2,
+    0x63A3, 0x63A5, 0x63A7, 0x63A8, 0x63A9, 0x63AA, 0x63B3, 0x63B7, 0x63B8, 0x63BA, 0x63C9, 0x63CD,
+    0x63CF, 0x63D0, 0x63D2, 0x63D6, 0x63E1, 0x63E3, 0x63E9, 0x63EA, 0x63ED, 0x63F4, 0x63FD, 0x6400,
+    0x6401, 0x6402, 0x6405, 0x640F, 0x6410, 0x6413, 0x6414, 0x641C, 0x641E, 0x642A, 0x642C, 0x642D,
+    0x643A, 0x643D, 0x6444, 0x6446, 0x6447, 0x6448, 0x644A, 0x6454, 0x6458, 0x6467, 0x6469, 0x6478,
+    0x6479, 0x6482, 0x6485, 0x6487, 0x6491, 0x6492, 0x6495, 0x649E, 0x64A4, 0x64A9, 0x64AC, 0x64AD,
+    0x64AE, 0x64B0, 0x64B5, 0x64BC, 0x64C2, 0x64C5, 0x64CD, 0x64CE, 0x64D2, 0x64DE, 0x64E6, 0x6500,
+    0x6512, 0x6518, 0x652B, 0x652F, 0x6536, 0x6539, 0x653B, 0x653E, 0x653F, 0x6545, 0x6548, 0x654C,
+    0x654F, 0x6551, 0x6556, 0x6559, 0x655B, 0x655D, 0x655E, 0x6562, 0x6563, 0x6566, 0x656C, 0x6570,
+    0x6572, 0x6574, 0x6577, 0x6587, 0x658B, 0x658C, 0x6591, 0x6597, 0x6599, 0x659C, 0x659F, 0x65A1,
+    0x65A4, 0x65A5, 0x65A7, 0x65A9, 0x65AD, 0x65AF, 0x65B0, 0x65B9, 0x65BD, 0x65C1, 0x65C5, 0x65CB,
+    0x65CF, 0x65D7, 0x65E0, 0x65E2, 0x65E5, 0x65E6, 0x65E7, 0x65E8, 0x65E9, 0x65EC, 0x65ED, 0x65F1,
+    0x65F6, 0x65F7, 0x65FA, 0x6602, 0x6606, 0x660C, 0x660E, 0x660F, 0x6613, 0x6614, 0x661F, 0x6620,
+    0x6625, 0x6627, 0x6628, 0x662D, 0x662F, 0x663C, 0x663E, 0x6643, 0x664B, 0x664C, 0x6652, 0x6653,
+    0x6655, 0x665A, 0x6664, 0x6666, 0x6668, 0x666E, 0x666F, 0x6670, 0x6674, 0x6676, 0x667A, 0x667E,
+    0x6682, 0x6687, 0x6691, 0x6696, 0x6697, 0x66AE, 0x66B4, 0x66D9, 0x66DD, 0x66F0, 0x66F2, 0x66F3,
+    0x66F4, 0x66F9, 0x66FC, 0x66FE, 0x66FF, 0x6700, 0x6708, 0x6709, 0x670B, 0x670D, 0x6714, 0x6717,
+    0x671B, 0x671D, 0x671F, 0x6728, 0x672A, 0x672B, 0x672C, 0x672D, 0x672F, 0x6731, 0x6734, 0x6735,
+    0x673A, 0x673D, 0x6740, 0x6742, 0x6743, 0x6746, 0x6749, 0x674E, 0x674F, 0x6750, 0x6751, 0x6756,
+    0x675C, 0x675F, 0x6760, 0x6761, 0x6765, 0x6768, 0x676D, 0x676F, 0x6770, 0x677E, 0x677F, 0x6781,
+    0x6784, 0x6789, 0x6790, 0x6795, 0x6797, 0x679A, 0x679C, 0x679D, 0x67A2, 0x67A3, 0x67AA, 0x67AB,
+    0x67AF, 0x67B6, 0x67B7, 0x67C4, 0x67CF, 0x67D0, 0x67D1, 0x67D2, 0x67D3, 0x67D4, 0x67DC, 0x67DE,
+    0x67E0, 0x67E5, 0x67EC, 0x67EF, 0x67F1, 0x67F3, 0x67F4, 0x67FF, 0x6805, 0x6807, 0x6808, 0x680B,
+    0x680F, 0x6811, 0x6813, 0x6816, 0x6817, 0x6821, 0x682A, 0x6837, 0x6838, 0x6839, 0x683C, 0x683D,
+    0x6842, 0x6843, 0x6845, 0x6846, 0x6848, 0x684C, 0x6850, 0x6851, 0x6853, 0x6854, 0x6863, 0x6865,
+    0x6868, 0x6869, 0x6876, 0x6881, 0x6885, 0x6886, 0x6897, 0x68A2, 0x68A6, 0x68A7, 0x68A8, 0x68AD,
+    0x68AF, 0x68B0, 0x68B3, 0x68C0, 0x68C9, 0x68CB, 0x68CD, 0x68D2, 0x68D5, 0x68D8, 0x68DA, 0x68E0,
+    0x68EE, 0x68F1, 0x68F5, 0x68FA, 0x6905, 0x690D, 0x690E, 0x6912, 0x692D, 0x6930, 0x693D, 0x693F,
+    0x6954, 0x695A, 0x695E, 0x6977, 0x697C, 0x6982, 0x6986, 0x6994, 0x699C, 0x69A8, 0x69B4, 0x69B7,
+    0x69D0, 0x69DB, 0x69FD, 0x6A0A, 0x6A1F, 0x6A21, 0x6A2A, 0x6A31, 0x6A47, 0x6A59, 0x6A61, 0x6A71,
+    0x6A80, 0x6A84, 0x6AAC, 0x6B20, 0x6B21, 0x6B22, 0x6B23, 0x6B27, 0x6B32, 0x6B3A, 0x6B3E, 0x6B47,
+    0x6B49, 0x6B4C, 0x6B62, 0x6B63, 0x6B64, 0x6B65, 0x6B66, 0x6B67, 0x6B6A, 0x6B79, 0x6B7B, 0x6B7C,
+    0x6B83, 0x6B86, 0x6B89, 0x6B8A, 0x6B8B, 0x6B96, 0x6BB4, 0x6BB5, 0x6BB7, 0x6BBF, 0x6BC1, 0x6BC5,
+    0x6BCB, 0x6BCD, 0x6BCF, 0x6BD2, 0x6BD4, 0x6BD5, 0x6BD6, 0x6BD7, 0x6BD9, 0x6BDB, 0x6BE1, 0x6BEB,
+    0x6BEF, 0x6C0F, 0x6C11, 0x6C13, 0x6C14, 0x6C16, 0x6C1B, 0x6C1F, 0x6C22, 0x6C26, 0x6C27, 0x6C28,
+    0x6C2E, 0x6C2F, 0x6C30, 0x6C34, 0x6C38, 0x6C40, 0x6C41, 0x6C42, 0x6C47, 0x6C49, 0x6C50, 0x6C55,
+    0x6C57, 0x6C5B, 0x6C5D, 0x6C5E, 0x6C5F, 0x6C60, 0x6C61, 0x6C64, 0x6C6A, 0x6C70, 0x6C72, 0x6C79,
+    0x6C7D, 0x6C7E, 0x6C81, 0x6C82, 0x6C83, 0x6C88, 0x6C89, 0x6C8F, 0x6C99, 0x6C9B, 0x6C9F, 0x6CA1,
+    0x6CA4, 0x6CA5, 0x6CA6, 0x6CA7, 0x6CAA, 0x6CAB, 0x6CAE, 0x6CB3, 0x6CB8, 0x6CB9, 0x6CBB, 0x6CBC,
+    0x6CBD, 0x6CBE, 0x6CBF, 0x6CC4, 0x6CC5, 0x6CC9, 0x6CCA, 0x6CCC, 0x6CD5, 0x6CDB, 0x6CDE, 0x6CE1,
+    0x6CE2, 0x6CE3, 0x6CE5, 0x6CE8, 0x6CEA, 0x6CF0, 0x6CF3, 0x6CF5, 0x6CFB, 0x6CFC, 0x6CFD, 0x6D01,
+    0x6D0B, 0x6D12, 0x6D17, 0x6D1B, 0x6D1E, 0x6D25, 0x6D2A, 0x6D31, 0x6D32, 0x6D3B, 0x6D3C, 0x6D3D,
+    0x6D3E, 0x6D41, 0x6D45, 0x6D46, 0x6D47, 0x6D4A, 0x6D4B, 0x6D4E, 0x6D51, 0x6D53, 0x6D59, 0x6D5A,
+    0x6D66, 0x6D69, 0x6D6A, 0x6D6E, 0x6D74, 0x6D77, 0x6D78, 0x6D82, 0x6D85, 0x6D88, 0x6D89, 0x6D8C,
+    0x6D8E, 0x6D95, 0x6D9B, 0x6D9D, 0x6D9F, 0x6DA1, 0x6DA3, 0x6DA4, 0x6DA6, 0x6DA7, 0x6DA8, 0x6DA9,
+    0x6DAA, 0x6DAF, 0x6DB2, 0x6DB5, 0x6DB8, 0x6DC0, 0x6DC4, 0x6DC6, 0x6DCB, 0x6DCC, 0x6DD1, 0x6DD6,
+    0x6DD8, 0x6DE1, 0x6DE4, 0x6DEB, 0x6DEC, 0x6DEE, 0x6DF1, 0x6DF3, 0x6DF7, 0x6DF9, 0x6DFB, 0x6E05,
+    0x6E0A, 0x6E0D, 0x6E10, 0x6E14, 0x6E17, 0x6E1D, 0x6E20, 0x6E21, 0x6E23, 0x6E24, 0x6E29, 0x6E2D,
+    0x6E2F, 0x6E34, 0x6E38, 0x6E3A, 0x6E43, 0x6E4D, 0x6E56, 0x6E58, 0x6E5B, 0x6E7E, 0x6E7F, 0x6E83,
+    0x6E85, 0x6E89, 0x6E90, 0x6E9C, 0x6EA2, 0x6EAA, 0x6EAF, 0x6EB6, 0x6EBA, 0x6EC1, 0x6EC7, 0x6ECB,
+    0x6ED1, 0x6ED3, 0x6ED4, 0x6EDA, 0x6EDE, 0x6EE1, 0x6EE4, 0x6EE5, 0x6EE6, 0x6EE8, 0x6EE9, 0x6EF4,
+    0x6F02, 0x6F06, 0x6F0F, 0x6F13, 0x6F14, 0x6F20, 0x6F2B, 0x6F31, 0x6F33, 0x6F3E, 0x6F4D, 0x6F58,
+    0x6F5C, 0x6F5E, 0x6F66, 0x6F6D, 0x6F6E, 0x6F84, 0x6F88, 0x6F8E, 0x6F9C, 0x6FA1, 0x6FB3, 0x6FC0,
+    0x6FD2, 0x7011, 0x704C, 0x706B, 0x706D, 0x706F, 0x7070, 0x7075, 0x7076, 0x7078, 0x707C, 0x707E,
+    0x707F, 0x7089, 0x708A, 0x708E, 0x7092, 0x7094, 0x7095, 0x7099, 0x70AC, 0x70AD, 0x70AE, 0x70AF,
+    0x70B3, 0x70B8, 0x70B9, 0x70BC, 0x70BD, 0x70C1, 0x70C2, 0x70C3, 0x70C8, 0x70D8, 0x70D9, 0x70DB,
+    0x70DF, 0x70E4, 0x70E6, 0x70E7, 0x70E9, 0x70EB, 0x70EC, 0x70ED, 0x70EF, 0x70F7, 0x70F9, 0x70FD,
+    0x7109, 0x710A, 0x7115, 0x7119, 0x711A, 0x7126, 0x7130, 0x7136, 0x714C, 0x714E, 0x715E, 0x7164,
+    0x7167, 0x716E, 0x717D, 0x7184, 0x718A, 0x718F, 0x7194, 0x7199, 0x719F, 0x71AC, 0x71C3, 0x71CE,
+    0x71D5, 0x71E5, 0x7206, 0x722A, 0x722C, 0x7231, 0x7235, 0x7236, 0x7237, 0x7238, 0x7239, 0x723D,
+    0x7247, 0x7248, 0x724C, 0x7259, 0x725B, 0x725F, 0x7261, 0x7262, 0x7267, 0x7269, 0x7272, 0x7275,
+    0x7279, 0x727A, 0x7280, 0x7281, 0x728A, 0x72AC, 0x72AF, 0x72B6, 0x72B9, 0x72C2, 0x72C4, 0x72C8,
+    0x72D0, 0x72D7, 0x72D9, 0x72DE, 0x72E0, 0x72E1, 0x72EC, 0x72ED, 0x72EE, 0x72F0, 0x72F1, 0x72F8,
+    0x72FC, 0x730E, 0x7316, 0x731B, 0x731C, 0x7329, 0x732A, 0x732B, 0x732E, 0x7334, 0x733E, 0x733F,
+    0x736D, 0x7384, 0x7387, 0x7389, 0x738B, 0x7396, 0x739B, 0x73A9, 0x73AB, 0x73AF, 0x73B0, 0x73B2,
+    0x73BB, 0x73CA, 0x73CD, 0x73D0, 0x73E0, 0x73ED, 0x7403, 0x7405, 0x7406, 0x7409, 0x7410, 0x7422,
+    0x7433, 0x7434, 0x7435, 0x7436, 0x743C, 0x745A, 0x745E, 0x745F, 0x7470, 0x7476, 0x7483, 0x74DC,
+    0x74E2, 0x74E3, 0x74E4, 0x74E6, 0x74EE, 0x74F6, 0x74F7, 0x7504, 0x7518, 0x751A, 0x751C, 0x751F,
+    0x7525, 0x7528, 0x7529, 0x752B, 0x752D, 0x7530, 0x7531, 0x7532, 0x7533, 0x7535, 0x7537, 0x7538,
+    0x753B, 0x7545, 0x754C, 0x754F, 0x7554, 0x7559, 0x755C, 0x7565, 0x7566, 0x756A, 0x7574, 0x7578,
+    0x7586, 0x758F, 0x7591, 0x7597, 0x7599, 0x759A, 0x759F, 0x75A1, 0x75A4, 0x75A5, 0x75AB, 0x75AE,
+    0x75AF, 0x75B2, 0x75B5, 0x75B9, 0x75BC, 0x75BD, 0x75BE, 0x75C5, 0x75C7, 0x75C8, 0x75C9, 0x75CA,
+    0x75D2, 0x75D4, 0x75D5, 0x75D8, 0x75DB, 0x75DE, 0x75E2, 0x75EA, 0x75F0, 0x75F4, 0x75F9, 0x7601,
+    0x761F, 0x7624, 0x7626, 0x7629, 0x762A, 0x762B, 0x7634, 0x7638, 0x764C, 0x7663, 0x7678, 0x767B,
+    0x767D, 0x767E, 0x7682, 0x7684, 0x7686, 0x7687, 0x768B, 0x7691, 0x7696, 0x76AE, 0x76B1, 0x76BF,
+    0x76C2, 0x76C5, 0x76C6, 0x76C8, 0x76CA, 0x76CE, 0x76CF, 0x76D0, 0x76D1, 0x76D2, 0x76D4, 0x76D6,
+    0x76D7, 0x76D8, 0x76DB, 0x76DF, 0x76EE, 0x76EF, 0x76F2, 0x76F4, 0x76F8, 0x76FC, 0x76FE, 0x7701,
+    0x7709, 0x770B, 0x771F, 0x7720, 0x7728, 0x7729, 0x772F, 0x7736, 0x7737, 0x773A, 0x773C, 0x7740,
+    0x7741, 0x775B, 0x7761, 0x7763, 0x7766, 0x776B, 0x776C, 0x7779, 0x7784, 0x7785, 0x778E, 0x7792,
+    0x77A5, 0x77A7, 0x77A9, 0x77AA, 0x77AC, 0x77B3, 0x77BB, 0x77D7, 0x77DB, 0x77E2, 0x77E3, 0x77E5,
+    0x77E9, 0x77EB, 0x77ED, 0x77EE, 0x77F3, 0x77FD, 0x77FE, 0x77FF, 0x7801, 0x7802, 0x780C, 0x780D,
+    0x7812, 0x7814, 0x7816, 0x781A, 0x7827, 0x7830, 0x7834, 0x7837, 0x7838, 0x783E, 0x7840, 0x7845,
+    0x7852, 0x7855, 0x785D, 0x786B, 0x786C, 0x786E, 0x7877, 0x787C, 0x7889, 0x788C, 0x788D, 0x788E,
+    0x7891, 0x7897, 0x7898, 0x789F, 0x78A7, 0x78B0, 0x78B1, 0x78B3, 0x78B4, 0x78BE, 0x78C1, 0x78C5,
+    0x78CA, 0x78CB, 0x78D0, 0x78D5, 0x78E8, 0x78F7, 0x78FA, 0x7901, 0x793A, 0x793C, 0x793E, 0x7941,
+    0x7948, 0x7956, 0x795D, 0x795E, 0x795F, 0x7965, 0x7968, 0x796D, 0x7977, 0x7978, 0x7981, 0x7984,
+    0x798F, 0x79B9, 0x79BB, 0x79BD, 0x79BE, 0x79C0, 0x79C1, 0x79C3, 0x79C6, 0x79C9, 0x79CB, 0x79CD,
+    0x79D1, 0x79D2, 0x79D8, 0x79DF, 0x79E4, 0x79E6, 0x79E7, 0x79E9, 0x79EF, 0x79F0, 0x79F8, 0x79FB,
+    0x79FD, 0x7A00, 0x7A0B, 0x7A0D, 0x7A0E, 0x7A17, 0x7A1A, 0x7A20, 0x7A33, 0x7A3B, 0x7A3C, 0x7A3D,
+    0x7A3F, 0x7A46, 0x7A57, 0x7A74, 0x7A76, 0x7A77, 0x7A7A, 0x7A7F, 0x7A81, 0x7A83, 0x7A84, 0x7A8D,
+    0x7A91, 0x7A92, 0x7A96, 0x7A97, 0x7A98, 0x7A9C, 0x7A9D, 0x7A9F, 0x7AA5, 0x7ABF, 0x7ACB, 0x7AD6,
+    0x7AD9, 0x7ADE, 0x7ADF, 0x7AE0, 0x7AE3, 0x7AE5, 0x7AED, 0x7AEF, 0x7AF9, 0x7AFF, 0x7B06, 0x7B0B,
+    0x7B11, 0x7B14, 0x7B1B, 0x7B26, 0x7B28, 0x7B2C, 0x7B3A, 0x7B3C, 0x7B49, 0x7B4B, 0x7B4F, 0x7B50,
+    0x7B51, 0x7B52, 0x7B54, 0x7B56, 0x7B5B, 0x7B77, 0x7B79, 0x7B7E, 0x7B80, 0x7B8D, 0x7B94, 0x7B95,
+    0x7B97, 0x7BA1, 0x7BA9, 0x7BAD, 0x7BB1, 0x7BC6, 0x7BC7, 0x7BD3, 0x7BD9, 0x7BE1, 0x7BEE, 0x7BF1,
+    0x7BF7, 0x7C07, 0x7C27, 0x7C3F, 0x7C4D, 0x7C73, 0x7C7B, 0x7C7D, 0x7C89, 0x7C92, 0x7C95, 0x7C97,
+    0x7C98, 0x7C9F, 0x7CA4, 0x7CA5, 0x7CAA, 0x7CAE, 0x7CB1, 0x7CB3, 0x7CB9, 0x7CBE, 0x7CCA, 0x7CD5,
+    0x7CD6, 0x7CD9, 0x7CDC, 0x7CDF, 0x7CE0, 0x7CEF, 0x7CFB, 0x7D0A, 0x7D20, 0x7D22, 0x7D27, 0x7D2B,
+    0x7D2F, 0x7D6E, 0x7E41, 0x7E82, 0x7EA0, 0x7EA2, 0x7EA4, 0x7EA6, 0x7EA7, 0x7EAA, 0x7EAB, 0x7EAC,
+    0x7EAF, 0x7EB1, 0x7EB2, 0x7EB3, 0x7EB5, 0x7EB6, 0x7EB7, 0x7EB8, 0x7EB9, 0x7EBA, 0x7EBD, 0x7EBF,
+    0x7EC3, 0x7EC4, 0x7EC5, 0x7EC6, 0x7EC7, 0x7EC8, 0x7ECA, 0x7ECD, 0x7ECE, 0x7ECF, 0x7ED1, 0x7ED2,
+    0x7ED3, 0x7ED5, 0x7ED8, 0x7ED9, 0x7EDA, 0x7EDC, 0x7EDD, 0x7EDE, 0x7EDF, 0x7EE2, 0x7EE3, 0x7EE5,
+    0x7EE6, 0x7EE7, 0x7EE9, 0x7EEA, 0x7EED, 0x7EF0, 0x7EF3, 0x7EF4, 0x7EF5, 0x7EF7, 0x7EF8, 0x7EFC,
+    0x7EFD, 0x7EFF, 0x7F00, 0x7F04, 0x7F05, 0x7F06, 0x7F09, 0x7F0E, 0x7F13, 0x7F14, 0x7F15, 0x7F16,
+    0x7F18, 0x7F1A, 0x7F1D, 0x7F20, 0x7F28, 0x7F29, 0x7F2E, 0x7F34, 0x7F38, 0x7F3A, 0x7F50, 0x7F51,
+    0x7F55, 0x7F57, 0x7F5A, 0x7F62, 0x7F69, 0x7F6A, 0x7F6E, 0x7F72, 0x7F8A, 0x7F8C, 0x7F8E, 0x7F94,
+    0x7F9A, 0x7F9E, 0x7FA1, 0x7FA4, 0x7FB9, 0x7FBD, 0x7FC1, 0x7FC5, 0x7FCC, 0x7FD4, 0x7FD8, 0x7FDF,
+    0x7FE0, 0x7FF0, 0x7FF1, 0x7FFB, 0x7FFC, 0x8000, 0x8001, 0x8003, 0x8005, 0x800C, 0x800D, 0x8010,
+    0x8015, 0x8017, 0x8018, 0x8019, 0x802A, 0x8033, 0x8036, 0x8038, 0x803B, 0x803D, 0x803F, 0x8042,
+    0x804A, 0x804B, 0x804C, 0x8054, 0x8058, 0x805A, 0x806A, 0x8083, 0x8084, 0x8086, 0x8087, 0x8089,
+    0x808B, 0x808C, 0x8096, 0x8098, 0x809A, 0x809B, 0x809D, 0x80A0, 0x80A1, 0x80A2, 0x80A4, 0x80A5,
+    0x80A9, 0x80AA, 0x80AE, 0x80AF, 0x80B2, 0x80BA, 0x80BE, 0x80BF, 0x80C0, 0x80C1, 0x80C3, 0x80C6,
+    0x80CC, 0x80CE, 0x80D6, 0x80DA, 0x80DC, 0x80DE, 0x80E1, 0x80EF, 0x80F0, 0x80F3, 0x80F6, 0x80F8,
+    0x80FA, 0x80FD, 0x8102, 0x8106, 0x8109, 0x810A, 0x810F, 0x8110, 0x8111, 0x8113, 0x8116, 0x811A,
+    0x812F, 0x8131, 0x8138, 0x813E, 0x8146, 0x814A, 0x814B, 0x8150, 0x8151, 0x8154, 0x8155, 0x8165,
+    0x816E, 0x8170, 0x8179, 0x817A, 0x817B, 0x817E, 0x817F, 0x8180, 0x818A, 0x818F, 0x8198, 0x819B,
+    0x819C, 0x819D, 0x81A8, 0x81B3, 0x81C0, 0x81C2, 0x81C3, 0x81C6, 0x81E3, 0x81EA, 0x81ED, 0x81F3,
+    0x81F4, 0x81FB, 0x81FC, 0x8200, 0x8205, 0x8206, 0x820C, 0x820D, 0x8212, 0x8214, 0x821C, 0x821E,
+    0x821F, 0x822A, 0x822C, 0x8230, 0x8231, 0x8235, 0x8236, 0x8237, 0x8239, 0x8247, 0x8258, 0x826F,
+    0x8270, 0x8272, 0x8273, 0x827A, 0x827E, 0x8282, 0x828B, 0x828D, 0x8292, 0x829C, 0x829D, 0x82A5,
+    0x82A6, 0x82AC, 0x82AD, 0x82AF, 0x82B1, 0x82B3, 0x82B9, 0x82BD, 0x82C7, 0x82CD, 0x82CF, 0x82D1,
+    0x82D4, 0x82D7, 0x82DB, 0x82DE, 0x82DF, 0x82E5, 0x82E6, 0x82EB, 0x82EF, 0x82F1, 0x82F9, 0x8301,
+    0x8302, 0x8303, 0x8304, 0x8305, 0x830E, 0x8327, 0x8328, 0x832B, 0x832C, 0x8335, 0x8336, 0x8338,
+    0x8339, 0x8346, 0x8349, 0x8350, 0x8352, 0x8354, 0x835A, 0x8361, 0x8363, 0x8364, 0x8367, 0x836B,
+    0x836F, 0x8377, 0x8386, 0x8389, 0x838E, 0x83AB, 0x83B1, 0x83B2, 0x83B7, 0x83B9, 0x83BD, 0x83C7,
+    0x83CA, 0x83CC, 0x83CF, 0x83DC, 0x83E0, 0x83E9, 0x83F1, 0x83F2, 0x8404, 0x840C, 0x840D, 0x840E,
+    0x841D, 0x8424, 0x8425, 0x8427, 0x8428, 0x843D, 0x8457, 0x845B, 0x8461, 0x8463, 0x846B, 0x846C,
+    0x8471, 0x8475, 0x8482, 0x848B, 0x8499, 0x849C, 0x84B2, 0x84B8, 0x84C4, 0x84C9, 0x84D1, 0x84D6,
+    0x84DD, 0x84DF, 0x84EC, 0x8511, 0x8513, 0x8517, 0x851A, 0x8521, 0x852B, 0x852C, 0x8537, 0x853C,
+    0x853D, 0x8549, 0x854A, 0x8574, 0x857E, 0x8584, 0x859B, 0x85AA, 0x85AF, 0x85C9, 0x85CF, 0x85D0,
+    0x85D5, 0x85E4, 0x85E9, 0x85FB, 0x8611, 0x8638, 0x864E, 0x864F, 0x8650, 0x8651, 0x865A, 0x865E,
+    0x866B, 0x8671, 0x8679, 0x867D, 0x867E, 0x8680, 0x8681, 0x8682, 0x868A, 0x868C, 0x8695, 0x869C,
+    0x86A4, 0x86C0, 0x86C6, 0x86C7, 0x86CA, 0x86CB, 0x86D4, 0x86D9, 0x86DB, 0x86E4, 0x86EE, 0x86F0,
+    0x86F9, 0x86FE, 0x8700, 0x8702, 0x8712, 0x8715, 0x8717, 0x8718, 0x871C, 0x8721, 0x8747, 0x8749,
+    0x874E, 0x8757, 0x8774, 0x8776, 0x878D, 0x879F, 0x87BA, 0x87F9, 0x8815, 0x8822, 0x8840, 0x8845,
+    0x884C, 0x884D, 0x8854, 0x8857, 0x8859, 0x8861, 0x8863, 0x8865, 0x8868, 0x886B, 0x886C, 0x8870,
+    0x8877, 0x8881, 0x8884, 0x888B, 0x888D, 0x8892, 0x8896, 0x889C, 0x88AB, 0x88AD, 0x88B1, 0x88C1,
+    0x88C2, 0x88C5, 0x88D4, 0x88D5, 0x88D9, 0x88E4, 0x88F3, 0x88F4, 0x88F8, 0x88F9, 0x8902, 0x8910,
+    0x8912, 0x8925, 0x892A, 0x8944, 0x895F, 0x897F, 0x8981, 0x8986, 0x89C1, 0x89C2, 0x89C4, 0x89C5,
+    0x89C6, 0x89C8, 0x89C9, 0x89D2, 0x89E3, 0x89E6, 0x8A00, 0x8A79, 0x8A89, 0x8A8A, 0x8A93, 0x8B66,
+    0x8B6C, 0x8BA1, 0x8BA2, 0x8BA3, 0x8BA4, 0x8BA5, 0x8BA8, 0x8BA9, 0x8BAB, 0x8BAD, 0x8BAE, 0x8BAF,
+    0x8BB0, 0x8BB2, 0x8BB3, 0x8BB6, 0x8BB8, 0x8BB9, 0x8BBA, 0x8BBC, 0x8BBD, 0x8BBE, 0x8BBF, 0x8BC0,
+    0x8BC1, 0x8BC4, 0x8BC5, 0x8BC6, 0x8BC8, 0x8BC9, 0x8BCA, 0x8BCC, 0x8BCD, 0x8BD1, 0x8BD5, 0x8BD7,
+    0x8BDA, 0x8BDB, 0x8BDD, 0x8BDE, 0x8BE1, 0x8BE2, 0x8BE3, 0x8BE5, 0x8BE6, 0x8BE7, 0x8BEB, 0x8BEC,
+    0x8BED, 0x8BEF, 0x8BF1, 0x8BF2, 0x8BF4, 0x8BF5, 0x8BF7, 0x8BF8, 0x8BFA, 0x8BFB, 0x8BFD, 0x8BFE,
+    0x8C01, 0x8C03, 0x8C05, 0x8C06, 0x8C08, 0x8C0A, 0x8C0B, 0x8C0D, 0x8C0E, 0x8C10, 0x8C13, 0x8C17,
+    0x8C1A, 0x8C1C, 0x8C22, 0x8C23, 0x8C24, 0x8C26, 0x8C28, 0x8C29, 0x8C2C, 0x8C2D, 0x8C30, 0x8C31,
+    0x8C34, 0x8C37, 0x8C41, 0x8C46, 0x8C4C, 0x8C61, 0x8C62, 0x8C6A, 0x8C6B, 0x8C79, 0x8C7A, 0x8C89,
+    0x8C8C, 0x8D1D, 0x8D1E, 0x8D1F, 0x8D21, 0x8D22, 0x8D23, 0x8D24, 0x8D25, 0x8D26, 0x8D27, 0x8D28,
+    0x8D29, 0x8D2A, 0x8D2B, 0x8D2C, 0x8D2D, 0x8D2E, 0x8D2F, 0x8D30, 0x8D31, 0x8D34, 0x8D35, 0x8D37,
+    0x8D38, 0x8D39, 0x8D3A, 0x8D3C, 0x8D3E, 0x8D3F, 0x8D41, 0x8D42, 0x8D43, 0x8D44, 0x8D4A, 0x8D4B,
+    0x8D4C, 0x8D4E, 0x8D4F, 0x8D50, 0x8D54, 0x8D56, 0x8D58, 0x8D5A, 0x8D5B, 0x8D5E, 0x8D60, 0x8D61,
+    0x8D62, 0x8D63, 0x8D64, 0x8D66, 0x8D6B, 0x8D70, 0x8D74, 0x8D75, 0x8D76, 0x8D77, 0x8D81, 0x8D85,
+    0x8D8A, 0x8D8B, 0x8D9F, 0x8DA3, 0x8DB3, 0x8DB4, 0x8DBE, 0x8DC3, 0x8DCB, 0x8DCC, 0x8DD1, 0x8DDD,
+    0x8DDF, 0x8DE8, 0x8DEA, 0x8DEF, 0x8DF3, 0x8DF5, 0x8DFA, 0x8E0A, 0x8E0C, 0x8E0F, 0x8E1E, 0x8E22,
+    0x8E29, 0x8E2A, 0x8E44, 0x8E48, 0x8E4B, 0x8E66, 0x8E6C, 0x8E6D, 0x8E72, 0x8E7F, 0x8E81, 0x8E87,
+    0x8EAB, 0x8EAC, 0x8EAF, 0x8EB2, 0x8EBA, 0x8F66, 0x8F67, 0x8F68, 0x8F69, 0x8F6C, 0x8F6E, 0x8F6F,
+    0x8F70, 0x8F74, 0x8F7B, 0x8F7D, 0x8F7F, 0x8F83, 0x8F85, 0x8F86, 0x8F88, 0x8F89, 0x8F8A, 0x8F90,
+    0x8F91, 0x8F93, 0x8F95, 0x8F96, 0x8F97, 0x8F99, 0x8F9B, 0x8F9C, 0x8F9E, 0x8F9F, 0x8FA3, 0x8FA8,
+    0x8FA9, 0x8FAB, 0x8FB0, 0x8FB1, 0x8FB9, 0x8FBD, 0x8FBE, 0x8FC1, 0x8FC2, 0x8FC4, 0x8FC5, 0x8FC7,
+    0x8FC8, 0x8FCE, 0x8FD0, 0x8FD1, 0x8FD4, 0x8FD8, 0x8FD9, 0x8FDB, 0x8FDC, 0x8FDD, 0x8FDE, 0x8FDF,
+    0x8FE2, 0x8FEA, 0x8FEB, 0x8FED, 0x8FF0, 0x8FF7, 0x8FF8, 0x8FF9, 0x8FFD, 0x9000, 0x9001, 0x9002,
+    0x9003, 0x9006, 0x9009, 0x900A, 0x900F, 0x9010, 0x9012, 0x9014, 0x9017, 0x901A, 0x901B, 0x901D,
+    0x901E, 0x901F, 0x9020, 0x9022, 0x902E, 0x9038, 0x903B, 0x903C, 0x903E, 0x9041, 0x9042, 0x9047,
+    0x904D, 0x904F, 0x9053, 0x9057, 0x9063, 0x9065, 0x906D, 0x906E, 0x9075, 0x907F, 0x9080, 0x9091,
+    0x9093, 0x90A2, 0x90A3, 0x90A6, 0x90AA, 0x90AE, 0x90AF, 0x90B1, 0x90B5, 0x90B9, 0x90BB, 0x90C1,
+    0x90CA, 0x90CE, 0x90D1, 0x90DD, 0x90E1, 0x90E7, 0x90E8, 0x90ED, 0x90F4, 0x90F8, 0x90FD, 0x9102,
+    0x9119, 0x9149, 0x914B, 0x914C, 0x914D, 0x9152, 0x9157, 0x915A, 0x915D, 0x915E, 0x9163, 0x9165,
+    0x916A, 0x916C, 0x916E, 0x9171, 0x9175, 0x9176, 0x9177, 0x9178, 0x917F, 0x9187, 0x9189, 0x918B,
+    0x9192, 0x919A, 0x919B, 0x91C7, 0x91C9, 0x91CA, 0x91CC, 0x91CD, 0x91CE, 0x91CF, 0x91D1, 0x91DC,
+    0x9274, 0x9488, 0x9489, 0x948E, 0x9492, 0x9493, 0x9499, 0x949D, 0x949E, 0x949F, 0x94A0, 0x94A1,
+    0x94A2, 0x94A5, 0x94A6, 0x94A7, 0x94A8, 0x94A9, 0x94AE, 0x94B1, 0x94B3, 0x94B5, 0x94BB, 0x94BE,
+    0x94C0, 0x94C1, 0x94C2, 0x94C3, 0x94C5, 0x94C6, 0x94DC, 0x94DD, 0x94E1, 0x94E3, 0x94EC, 0x94ED,
+    0x94F0, 0x94F1, 0x94F2, 0x94F6, 0x94F8, 0x94FA, 0x94FE, 0x9500, 0x9501, 0x9504, 0x9505, 0x9508,
+    0x950B, 0x950C, 0x9510, 0x9511, 0x9517, 0x9519, 0x951A, 0x9521, 0x9523, 0x9524, 0x9525, 0x9526,
+    0x9528, 0x952D, 0x952E, 0x952F, 0x9530, 0x9539, 0x953B, 0x9540, 0x9541, 0x9547, 0x954A, 0x954D,
+    0x9550, 0x9551, 0x955C, 0x9563, 0x956D, 0x9570, 0x9576, 0x957F, 0x95E8, 0x95EA, 0x95ED, 0x95EE,
+    0x95EF, 0x95F0, 0x95F2, 0x95F4, 0x95F7, 0x95F8, 0x95F9, 0x95FA, 0x95FB, 0x95FD, 0x9600, 0x9601,
+    0x9602, 0x9605, 0x9609, 0x960E, 0x9610, 0x9611, 0x9614, 0x961C, 0x961F, 0x962E, 0x9632, 0x9633,
+    0x9634, 0x9635, 0x9636, 0x963B, 0x963F, 0x9640, 0x9644, 0x9645, 0x9646, 0x9647, 0x9648, 0x964B,
+    0x964C, 0x964D, 0x9650, 0x9655, 0x965B, 0x9661, 0x9662, 0x9664, 0x9668, 0x9669, 0x966A, 0x9675,
+    0x9676, 0x9677, 0x9685, 0x9686, 0x968B, 0x968F, 0x9690, 0x9694, 0x9698, 0x9699, 0x969C, 0x96A7,
+    0x96B6, 0x96BE, 0x96C0, 0x96C1, 0x96C4, 0x96C5, 0x96C6, 0x96C7, 0x96CC, 0x96CD, 0x96CF, 0x96D5,
+    0x96E8, 0x96EA, 0x96F6, 0x96F7, 0x96F9, 0x96FE, 0x9700, 0x9704, 0x9707, 0x9709, 0x970D, 0x9713,
+    0x9716, 0x971C, 0x971E, 0x9732, 0x9738, 0x9739, 0x9752, 0x9756, 0x9759, 0x975B, 0x975E, 0x9760,
+    0x9761, 0x9762, 0x9769, 0x9773, 0x9774, 0x9776, 0x978B, 0x978D, 0x9798, 0x97A0, 0x97AD, 0x97E6,
+    0x97E7, 0x97E9, 0x97ED, 0x97F3, 0x97F5, 0x97F6, 0x9875, 0x9876, 0x9877, 0x9879, 0x987A, 0x987B,
+    0x987D, 0x987E, 0x987F, 0x9881, 0x9882, 0x9884, 0x9885, 0x9886, 0x9887, 0x9888, 0x988A, 0x9890,
+    0x9891, 0x9893, 0x9896, 0x9897, 0x9898, 0x989C, 0x989D, 0x98A0, 0x98A4, 0x98A7, 0x98CE, 0x98D8,
+    0x98DE, 0x98DF, 0x9910, 0x9965, 0x996D, 0x996E, 0x996F, 0x9970, 0x9971, 0x9972, 0x9975, 0x9976,
+    0x997A, 0x997C, 0x997F, 0x9981, 0x9985, 0x9986, 0x9988, 0x998B, 0x998F, 0x9992, 0x9996, 0x9999,
+    0x9A6C, 0x9A6D, 0x9A6E, 0x9A6F, 0x9A70, 0x9A71, 0x9A73, 0x9A74, 0x9A76, 0x9A79, 0x9A7B, 0x9A7C,
+    0x9A7E, 0x9A82, 0x9A84, 0x9A86, 0x9A87, 0x9A8B, 0x9A8C, 0x9A8F, 0x9A91, 0x9A97, 0x9A9A, 0x9AA1,
+    0x9AA4, 0x9AA8, 0x9AB8, 0x9AD3, 0x9AD8, 0x9B03, 0x9B3C, 0x9B41, 0x9B42, 0x9B44, 0x9B4F, 0x9B54,
+    0x9C7C, 0x9C81, 0x9C8D, 0x9C9C, 0x9CA4, 0x9CB8, 0x9CC3, 0x9CD6, 0x9CDE, 0x9E1F, 0x9E21, 0x9E23,
+    0x9E25, 0x9E26, 0x9E2D, 0x9E2F, 0x9E33, 0x9E35, 0x9E3D, 0x9E3F, 0x9E43, 0x9E45, 0x9E4A, 0x9E4F,
+    0x9E64, 0x9E70, 0x9E7F, 0x9E93, 0x9EA6, 0x9EBB, 0x9EC4, 0x9ECD, 0x9ECE, 0x9ED1, 0x9ED4, 0x9ED8,
+    0x9F0E, 0x9F13, 0x9F20, 0x9F3B, 0x9F50, 0x9F7F, 0x9F84, 0x9F8B, 0x9F99, 0x9F9A, 0x9F9F,
+};
+
+static const char PROGMEM pinyin_initials[] =
+    "YDQWZSSXBYCZQSQBYCDSDLYSGYZFCLWDWZLJNJMYZWZHFLPPQGCYJQYXXSMLRQLYZSEYKYHWJYXWKJHYCHMXJTLQRYSRJPCJ"
+    "JRCLCZSTZFXQDLYYMYZJJRFFQYWJFFXZYHHSWCSLWBGBLSSSDDWDZZYTHYFZNYPLYBJSZCLSDGYXLJZCQKWHQBCEJQLSFBYX"
+    "LJXFJABDJTHYJCJNZZQJPZTJOTCKFLBDCCASXLSSJPRLEYYXCZXGKMDTDDJRQBGLLGGXBQJDZYJSJNGRCZMMRXJNGYDFBCJK"
+    "YLDJQZLDLJCLNJFFPKHDXTACJHZDDRFQKXHLLZGCCSPPLBGDZSQSCKGDJTXQGJTPBJSJFGJPLQBGJWLDZNJLJLSBYMXLKMQS"
+    "GWYBCXHBCZJKXFPQYNSQSWHBHXBZZDMNBBBZKLLWWMYWJQLJXQCETLLYYCLHYXXCJQXSCYCJYSFFSQSBXPDKGJLZJZBDKTSY"
+    "YHSTDYCGHJDTMHLTXXLMJLTYFFBDFHTKSQZWCXCWHWYDCGNOYQWNZWHPSHMJPZHJYFZGKLZYKZKXYAPHDWHZXAYHYGOSLNKX"
+    "ZBHYSCATHHSWCTKZSAFPSLPNXTKWSLHHCXHXZPYXSSWSSJGXMZCZSXHYQZSGHTXRJNQSHYTDYKCWGGTPYQTSZGDCJZJFTKHZ"
+    "KKJTBWFZPKTPPKCLLXLDGYKDKGAMCPYBPJTDQDBDKYDTSTTSTJSSMQZXMDBHRSRZSKHYCBFXXWDYGDTTFYHSTYKJDYQNFFKZ"
+    "QBJTDSANNNJTHRWZFMRDJYMTFNMQMSJGXWYJLYJYZWWLJNNJSEMYQPWHLYSXMMXJSJXDNZKYZCSZXMJGXHLSFRNNTZYSASWH"
+    "ZGZDWYBSCSKXSHXGZHYXJRKBSJJYMKFMHYQMCGLZCDSXDSFSJWZXSEJCSCYYJSYCNJWNJPCJQTJWSPXZSTLLTSYYSQCGDYLY"
+    "AKZXLEYQFJCQCYBZQWCZXCGZQJGWCJYSBXJBSBSFSXZPTLZBZDDZXBCMMFHMCGPNBXHYYGZQBCXLKYDDMGFPFDZTSKYLLKLY"
+    "TJKYQNBSGYFHCDZMXHWRDQGDLYXTYCBBPZYYCBWZJDHHLXTDPYXWDHXBYJRZWMZYKCNXHFHTSZNZPBLSDJXYGQZSLHKHSHXH"
+    "EDTGXQKENYQXHHWYHYNXMBJDQJWHTXWHDJCCBCDGDXHRXCYYYYGFKYCHSSMMHKWKBZHHDXALNGWXSRXCWJHZQJLCDHFSBSSC"
+    "ZPBDRTKKQZKSYNBCRBFPEZCJCJBYSZTDKZFPKLQHBPPTBDMYCMFZDCMNLBPLGJTBTJZZBNLJYLNBZKSZGQSKPZSNCGZAKTWZ"
+    "LWTXNDZJHANCZTWWTKZBHSNJBLSJHDPJCJNXDDSDZTQPYJLTCJKTYCLZDCRZMTCYWCKJJYLCGLJBCCSSGTBDXCSBYBTSZCMM"
+    "MLJPCSSZCLQBCZNHLSCQQSCPZRJZSGGFZGXDMJAJLBCGSDJSQZFWZBBDLXZWJCFZDSXFSPLXZQWJRDJZZXXHSKWAKCMHYXXY"
+    "CMZZSZXHJSSXYWWHCPJXQJZLZXSNAMBSPYQYGCMZTZYYPFSLWCQMWMBZSZPDJXSZQGSLXCCZDSGTLYHBJSBJGWXZLMGZSZQF"
+    "KJJBBMGQRRGZNCJKZLCSZBZDLSSQLXZYHGGZGTWKAZTSHJDQJZTLMBGSMWLSTXSJMQGBZJPTSLKGYZZJTYCCXCLKLGYLBZLQ"
+    "HJCFZMHYQCXCTXMQCHXOYQKXQGZZCBWQWDSJYDXSCZODYDHYWMMDBBBPBMZHTSMMQNFFQHYADLQSYTZQHHXSHXRGJCWTWTJX"
+    "QFQYWSCQSPGMOLLCHMJHFYZZGZYXQQBMFFNPBQNZLTYBXPZJYSXLDJHEZHWQPLQJJZCJHNZJPHLFYHJTNXSYXTTLLWHDRJZS"
+    "FYYHHDZXLTSNTDYYCHSCHYTQYZJYSYQDZBWWGKYMPTHXZWSKJGYLYXSRNCDZHZTGZMLLLBTDPQLLYMMSZYWPQLLTCCCPLZAJ"
+    "BPGHMDHLZJZZCLCYCQKZJTPJBZDLCSLTLHLZYKFSHTJRXWPFYHHBFJYRHJSMZZSXXXRXSARLYZBZPAJFYBDSPBPYNMMLMWSQ"
+    "TXXLDQFZYKDBHGJNHJDXSZYLLLCMCXZMXHHYTXLYWJMWMHXLBSZFZBQLLLSZLQPPQHRSGYLGPBRWWPCZGSTSSYSFBTYJSDND"
+    "HCJWPLXLQFCJJSYLGJNYBJYCFPCZTJJBZYJQYZHDTPLHTCBCWLSDBTZQAXGDBBZDJHGAWPZMYZPYYAZYJHKGDPSMMDMZXPDS"
+    "MKZMZXMKJTYZZJSDMJCDMCXMPQZDSTZCMSYZJJDASXFKMSQKPYZYZPPSZLCGXSXLYQJPDLASBWDDBPJTCNCBLCPKMLHJSLSQ"
+    "QZZSSXPJDHJLFYLQHXSTGBQZKMMZCQYZJCJYHXCSSBZCWDJJGMSXJQKCTQZQYZJCJCWKKLLSZJJZJTJDZGBSXBDFBDJLDJFK"
+    "ZTDCSKCQJGBJSGLJXZPLGCLLPCHBJMLZFLPCZSYZFLLJCJHGTCMZKNXWSSJZLXFZJHXYJJRWCSGNZLFZWFNXLZSXZZBSYJBR"
+    "JRHGXLJJTJXSTJJXXCSWMBCZZLZJMLJDHDLBYFFCYSSJGQGWHLFBZZZSYQMGLXXQGYWCYXQDCHAFYYLKZESNGHYBPEYSCDGN"
+    "LLZLPJCSYSZRLJXZDGGCGZFFJFAKYFSZZXWDBTPPSBHKYGJXANZCMJZQNNBJFTLPTLYFFQWXSYFXNTTBBGBTMXPSTBYYCZCZ"
+    "ZZJYJYSSSTSWZHBJCDBXCTSLJSYYAJYSMWZJLFBXHFQYWCSYTMKBGRKSBYPZMFQMJJCMCYCRRJCJHLJDRHYYYHPLSMLLHYMG"
+    "JJHCBPLFTMPWLYYXSLZGPDHZCKDJMSPZXRSBLJPMMZWCNSQABJRYLBXXSJCMOTFZMZHLNLXYCSHSXSYMWBCYZZQSGDHWZGMZ"
+    "YESFYTWZMLYCXHHDRMLXRCXXXYXJYHYBBSCSZYADPTXWBXFCLZYYQKSPLGGHBRTXJXYFJGGMSLJJJCYZYTSJPJDFRJTRQXYX"
+    "JJHYXELSFSFJZPZSZSZZCYSSCZHDGXYGXCJWYWYHSSQZNDFKSDLZTYMDHXWCYMXYBQJMMTLPQGHDWXHHYBCHMBZFGCZXBZHZ"
+    "FTPBGZGEJTGDMFHZJHLLZZSFDSSCPLZZSZZSYGCSHZFZGQCCYQTQZPZYBDPJGKGLTJDYCTJTCZTDTBDCDCZCSGQDTCZGXZLR"
+    "HZQZJJFLBHGFJSYXZZXGCBLBBBCRBLDQYQXGMYYJFHZJYWLCTDPDSMBJZTSSTNXXTZDTDTGSCSZFDYLBYDSYBEDYQYZZZBYY"
+    "DXNBXYHQSZLYJLZHJYBGCDDEBYQZPJXFYTHSLCTJJMKSNCZCXMQCYSLZYLJFJZDQFDGDCZNBGYQJWGNQQBZJYTBLQMTLZXGM"
+    "JYCYZPLXSCGXFXRTZCMXLCZJXDJJMQDDMZNNGBJLLLXCMSBWCRXJMZNGWMFGHYYYCLKFDRFYYZJZATFJLLCLMJXSBDYCYXPL"
+    "TXYLSSYGAXZSLNQYXYJGCYCDYXLLBWXXZMHNLSXLBPQJJDFKMMGJXBXAQJBWRHJYYSYDQXSXWGDBSYLLPJJYPTYKTYEDCQFP"
+    "FSCJFYJSBSERJBENXGKCLMSXMYTXCQBLSJZTJMJLHCYJQPSLZGHSGZGKHPWMYLBXLJSBLNJMOYYYYTGHJEQPHYLLMMHSLHQM"
+    "DGSBQCLQLGG";
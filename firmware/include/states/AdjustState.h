@@ -8,9 +8,10 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    bool onInput(const InputEvent& event) override;
+    const EncoderProfile& encoderProfile() const override { return ENCODER_VALUE; }
     void adjustTimer(int duration);
 
 private:
     int adjustDuration;
-    unsigned long lastActivity;
 };
\ No newline at end of file
@@ -5,11 +5,7 @@
 class DoneState : public State
 {
 public:
-    DoneState();
     void enter() override;
     void update() override;
     void exit() override;
-
-private:
-    unsigned long doneEnter;
 };
\ No newline at end of file
@@ -20,6 +20,8 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    bool onInput(const InputEvent& event) override;
+    const EncoderProfile& encoderProfile() const override { return ENCODER_VALUE; }
 
     // 设置选中的任务信息 / Set selected task info
     void setTask(const FocusTask& task);
@@ -27,7 +29,6 @@ public:
 private:
     FocusTask selectedTask;      // 选中的任务
     int duration;                // 当前选择的时长（分钟）
-    unsigned long lastActivity;  // 最后操作时间
 
     static const int DURATION_STEP = 5;      // 步进5分钟
     static const int DURATION_MIN = 5;       // 最小5分钟
@@ -9,10 +9,14 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    unsigned long nextWakeup(unsigned long now) override;
+    bool allowsLightSleep() const override { return true; }
     void setTimer(int duration);
+    int getDefaultDuration() const { return defaultDuration; }
 
 private:
     int defaultDuration;
-    unsigned long lastActivity;
     static bool bootCompleted;  // 标记是否已完成首次启动通知
+
+    static const unsigned long IDLE_TICK_MS = 1000;
 };
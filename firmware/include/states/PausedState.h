@@ -1,31 +1,19 @@
 #pragma once
 
 #include "State.h"
+#include "models/FocusSession.h"
 #include <Arduino.h>
 
 class PausedState : public State
 {
 public:
-    PausedState();
     void enter() override;
     void update() override;
     void exit() override;
 
-    void setPause(int duration,
-                  unsigned long elapsedTime,
-                  const String& taskId = "",
-                  const String& taskName = "",
-                  const String& sessionId = "",
-                  const String& taskDisplayName = "",
-                  const String& taskProjectId = "");
+    void setSession(const FocusSession& session);
+    const FocusSession& getSession() const { return session; }
 
 private:
-    int duration;
-    unsigned long pauseEnter;
-    unsigned long elapsedTime;
-    String taskProjectId;
-    String taskId;
-    String taskName;
-    String sessionId;
-    String taskDisplayName;
+    FocusSession session;
 };
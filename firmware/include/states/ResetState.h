@@ -8,6 +8,5 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
-
-    unsigned long resetStartTime = 0;
+    bool onInput(const InputEvent& event) override;
 };
\ No newline at end of file
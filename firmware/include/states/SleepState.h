@@ -8,4 +8,8 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+
+    // 只等待输入中断唤醒 / Wait for input interrupts only
+    unsigned long nextWakeup(unsigned long now) override { return now + 60000UL; }
+    bool allowsLightSleep() const override { return true; }
 };
\ No newline at end of file
@@ -14,6 +14,7 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    bool onInput(const InputEvent& event) override;
 
     // Set context before entering this state / 进入前设置上下文
     void setContext(const String& taskId,
@@ -35,4 +36,6 @@ private:
     bool countTime;
     bool isCanceled;
     bool markDoneSelected;
+
+    void sendDecision();
 };
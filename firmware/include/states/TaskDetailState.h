@@ -21,17 +21,23 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    bool onInput(const InputEvent& event) override;
+    const EncoderProfile& encoderProfile() const override { return ENCODER_LIST; }
 
     // 设置当前查看的任务 / Set current task context
     void setTask(const FocusTask& task, const String& projectName);
 
 private:
+    int totalRows() const;
+    void clampSelection();
+    bool handleRotate(int delta);
+    bool handlePress();
+
     FocusTask task;
     String projectName;
 
     int selectedIndex;
     int displayOffset;
-    unsigned long lastActivity;
 
     static const int MAX_VISIBLE = 2;
     static const int TIMEOUT_SECONDS = 30;
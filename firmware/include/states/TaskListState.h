@@ -1,6 +1,7 @@
 #pragma once
 
 #include "State.h"
+#include "TaskListCache.h"
 #include "models/FocusProject.h"
 #include "models/FocusTask.h"
 #include "models/TaskListMode.h"
@@ -14,21 +15,51 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    bool onInput(const InputEvent& event) override;
+    const EncoderProfile& encoderProfile() const override { return ENCODER_LIST; }
 
-    // Update task list from JSON / 从 JSON 更新任务列表
-    void updateTaskList(const String& jsonTaskList);
+    // Update task list from parsed JSON; false if the version is stale / 从已解析的 JSON 更新任务列表，旧版本返回 false
+    bool updateTaskList(JsonDocument& doc);
+
+    // Restore last accepted list from flash (call once at boot) / 开机从闪存恢复上次的任务列表
+    void loadFromCache();
+
+    // Drop persisted list (factory reset) / 清除闪存中的任务列表
+    void clearCache();
 
     // Get currently selected task / 获取当前选中的任务
     FocusTask* getSelectedTask();
 
+    // 当前排序视图的索引（行号 → 列表下标），原始顺序返回 nullptr
+    // View index for the active sort mode (row -> list index), nullptr for original order
+    const uint16_t* viewOrder(bool completed) const;
+
+    // 切换到下一个（step > 0）或上一个排序视图（O(1)，仅切换索引数组）
+    // Cycle to the next (step > 0) or previous sort view (O(1), swaps index only)
+    void cycleSortMode(int step = 1);
+
+    // 首字母跳转：待办列表中每个首字母（A-Z / 拼音首字母，其余归 '#'）在当前视图的第一行
+    // Jump table: first row of each initial (A-Z / pinyin initial, others '#') in the active pending view
+    struct JumpEntry {
+        char initial;
+        uint16_t row;
+    };
+
     // 任务列表（public 供 TaskListViewState 只读访问）
     std::vector<FocusTask> pendingTasks;    // 待办任务列表
     std::vector<FocusTask> completedTasks;  // 已完成任务列表
     std::vector<FocusProject> projects;     // 项目（清单）列表
     String selectedProjectId;               // 当前项目 ID
     String selectedProjectName;             // 当前项目名称
+    uint32_t listVersion;                   // 任务列表版本（HA 下发或本地递增）
+    TaskSortMode sortMode;                  // 当前排序视图（待办/已完成共用）
 
 private:
+    bool handleRotate(int delta);
+    bool handlePress();
+    bool handleDoublePress();
+    bool handleHoldRotate(int delta);
+
     TaskListMode mode;                      // 当前显示模式（待办/已完成/项目选择）
 
     int selectedIndexPending;              // 待办：当前选中索引
@@ -38,7 +69,22 @@ private:
     int selectedIndexProjects;             // 项目：当前选中索引
     int displayOffsetProjects;             // 项目：显示滚动偏移
 
-    unsigned long lastActivity;       // Last user interaction time / 最后操作时间
+
+    TaskListCache cache;              // 闪存缓存 / On-flash cache
+
+    // 二级索引：每种排序一份，列表更新时构建一次 / Secondary indexes, built once per list update
+    std::vector<uint16_t> pendingIndex[TASK_SORT_MODE_COUNT];
+    std::vector<uint16_t> completedIndex[TASK_SORT_MODE_COUNT];
+
+    // 首字母跳转表：每种排序一份，按字母顺序排列，'#' 在最后 / Jump tables per sort mode, alphabetical, '#' last
+    std::vector<JumpEntry> pendingJump[TASK_SORT_MODE_COUNT];
+    bool jumpMode;                          // 旋钮按首字母跳转 / Encoder steps through initials
+    int jumpCursor;                         // 当前跳转表位置 / Position in the jump table
+
+    void resetSelection();
+    void rebuildIndexes();
+    void enterJumpMode();
+    void jumpTo(int cursor);
 
     static const int MAX_VISIBLE_TASKS = 2;  // Max tasks visible on screen / 屏幕可显示任务数
     static const int TASK_TIMEOUT = 30;      // Timeout in seconds / 超时时间（秒）
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "State.h"
+#include "models/FocusSession.h"
 #include "models/FocusTask.h"
 #include "models/TaskListMode.h"
 #include <Arduino.h>
@@ -18,6 +19,7 @@
  * - 旋钮：滚动查看任务
  * - 单击：返回计时状态
  * - 双击：循环待办 → 已完成 → 项目选择
+ * - 长按：切换排序视图（原始/优先级/截止/今日用时）
  */
 class TaskListViewState : public State {
 public:
@@ -25,22 +27,20 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    bool onInput(const InputEvent& event) override;
+    const EncoderProfile& encoderProfile() const override { return ENCODER_LIST; }
 
     // 设置返回时的计时器上下文 / Set timer context for returning
-    void setTimerContext(int duration, unsigned long elapsedTime,
-                         const String& taskId, const String& taskName,
-                         const String& sessionId, const String& taskDisplayName,
-                         const String& taskProjectId);
+    void setSession(const FocusSession& session);
+    const FocusSession& getSession() const { return timerSession; }
 
 private:
-    // 计时器上下文（返回时恢复）
-    int timerDuration;
-    unsigned long timerElapsedTime;
-    String timerTaskProjectId;
-    String timerTaskId;
-    String timerTaskName;
-    String timerSessionId;
-    String timerTaskDisplayName;
+    bool handleRotate(int delta);
+    bool handlePress();
+    bool handleDoublePress();
+    bool handleHoldRotate(int delta);
+
+    FocusSession timerSession;  // 计时器上下文（返回时恢复）
 
     // 查看状态
     TaskListMode mode;
@@ -50,7 +50,6 @@ private:
     int displayOffsetCompleted;
     int selectedIndexProjects;
     int displayOffsetProjects;
-    unsigned long lastActivity;
 
     static const int MAX_VISIBLE_TASKS = 2;
     static const int VIEW_TIMEOUT = 15;  // 15秒超时返回
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "State.h"
+#include "models/FocusSession.h"
 #include <Arduino.h>
+#include <atomic>
+#include <esp_timer.h>
 
 class TimerState : public State
 {
@@ -11,22 +14,61 @@ public:
     void enter() override;
     void update() override;
     void exit() override;
+    unsigned long nextWakeup(unsigned long now) override;
 
+    // 开始一个新会话（计时从 0 起）/ Start a new session with a zeroed clock
     void setTimer(int duration,
-                  unsigned long elapsedTime,
                   const String& taskId = "",
                   const String& taskName = "",
                   const String& sessionId = "",
                   const String& taskDisplayName = "",
                   const String& taskProjectId = "");
 
+    // 恢复已有会话（暂停/查看列表返回）/ Resume an existing session (from pause or list view)
+    void setSession(const FocusSession& session);
+    const FocusSession& getSession() const { return session; }
+
+    // 暂停/取消时停表并撤销结束定时器，已用时长保留微秒精度
+    // Stop the clock and disarm the end timer on pause/cancel, keeping microsecond elapsed time
+    void stopClock();
+
+    // 主循环收到 Timer 事件时调用：确认本会话的完成 webhook 已由结束定时器入队
+    // Called from the loop on the Timer event: notes that the end timer queued this session's completion webhook
+    void onEndEvent();
+
+    // 完成 webhook 已入队 / The completion webhook is queued
+    bool isComplete() const { return completionSent; }
+
+    // stop 类 webhook 内容（暂停/取消/完成共用）/ "stop" webhook body shared by pause, cancel and complete
+    static String focusStopPayload(const FocusSession& session,
+                                   const char* event,
+                                   uint32_t elapsedSeconds,
+                                   bool countTime,
+                                   const char* cancelReason = nullptr);
+
 private:
-    int duration;
-    unsigned long startTime;
-    unsigned long elapsedTime;
-    String taskProjectId;
-    String taskId;
-    String taskName;
-    String sessionId;
-    String taskDisplayName;
+    FocusSession session;
+
+    // 会话结束由一次性 esp_timer 调度，不再每轮比较剩余时间
+    // The session end is a one-shot esp_timer instead of a per-loop remaining-time check
+    esp_timer_handle_t endTimer;
+
+    // 布防时生成、发布后不再修改；定时器回调用 exchange 取得所有权后直接入队
+    // Built when arming and never modified once published; the timer callback takes ownership with exchange and enqueues it
+    struct ArmedCompletion
+    {
+        uint32_t generation;
+        int64_t deadlineUs;
+        String payload;
+    };
+
+    std::atomic<ArmedCompletion*> armed;
+    std::atomic<uint32_t> armGeneration;   // 每次布防/撤防递增 / Bumped on every arm and disarm
+    std::atomic<uint32_t> firedGeneration; // 回调发出完成后写入，主循环取走；0 表示无 / Written by the callback once sent, taken by the loop; 0 for none
+    uint32_t sessionGeneration;            // 本会话开始时的代数 / Generation when this session started
+    bool completionSent;                   // 仅主循环访问 / Loop-only
+
+    void armEndTimer();
+    void disarmEndTimer();
+    static void onSessionEnd(void* arg);
 };
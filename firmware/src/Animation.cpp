@@ -23,7 +23,6 @@ void Animation::start(const byte* frames, int frameCount, bool loop, bool revers
     }
 
     animationStartTime = millis();
-    lastFrameTime = millis();
 
     frameX = (oled->width() - frameWidth) / 2;
     // Move animation down to avoid yellow area (top 1/5 of screen ~13px)
@@ -45,38 +44,33 @@ void Animation::update() {
         return;
     }
 
-    // Check if it's time to advance to the next frame / 判断是否需要切换到下一帧
-    if (currentTime - lastFrameTime >= frameDelay) {
-        lastFrameTime = currentTime;
-
-        // Adjust current frame based on direction / 按方向更新当前帧
-        if (playInReverse) {
-            currentFrame--;
-            if (currentFrame < 0) { 
-                if (loopAnimation) {
-                    currentFrame = totalFrames - 1; // Wrap around to last frame / 回到最后一帧
-                } else {
-                    animationRunning = false;
-                    return;
-                }
+    // Adjust current frame based on direction / 按方向更新当前帧
+    if (playInReverse) {
+        currentFrame--;
+        if (currentFrame < 0) { 
+            if (loopAnimation) {
+                currentFrame = totalFrames - 1; // Wrap around to last frame / 回到最后一帧
+            } else {
+                animationRunning = false;
+                return;
             }
-        } else {
-            currentFrame++;
-            if (currentFrame >= totalFrames) {
-                if (loopAnimation) {
-                    currentFrame = 0; // Wrap around to first frame / 回到第一帧
-                } else {
-                    animationRunning = false;
-                    return;
-                }
+        }
+    } else {
+        currentFrame++;
+        if (currentFrame >= totalFrames) {
+            if (loopAnimation) {
+                currentFrame = 0; // Wrap around to first frame / 回到第一帧
+            } else {
+                animationRunning = false;
+                return;
             }
         }
-
-        // Display the current frame / 绘制当前帧
-        oled->clearDisplay();
-        oled->drawBitmap(frameX, frameY, &animationFrames[currentFrame * 288], frameWidth, frameHeight, 1);
-        oled->display();
     }
+
+    // Display the current frame / 绘制当前帧
+    oled->clearDisplay();
+    oled->drawBitmap(frameX, frameY, &animationFrames[currentFrame * 288], frameWidth, frameHeight, 1);
+    oled->display();
 }
 
 bool Animation::isRunning() {
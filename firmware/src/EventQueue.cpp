@@ -0,0 +1,84 @@
+#include "EventQueue.h"
+
+// Global event queue instance / 事件队列全局实例
+EventQueue eventQueue;
+
+EventQueue::EventQueue()
+    : queue(nullptr),
+      pendingMask(0)
+{
+}
+
+void EventQueue::begin()
+{
+    if (queue == nullptr)
+    {
+        // 静态分配，不占用堆 / Statically allocated, no heap use
+        queue = xQueueCreateStatic(QUEUE_LENGTH, sizeof(Event), queueStorage, &queueControl);
+    }
+}
+
+bool EventQueue::markPending(EventType type)
+{
+    const uint8_t bit = 1 << (uint8_t)type;
+    return (pendingMask.fetch_or(bit) & bit) == 0;
+}
+
+bool EventQueue::post(EventType type, uint32_t arg)
+{
+    if (queue == nullptr || !markPending(type))
+    {
+        return false; // 同类事件已在队列中 / Same type already queued
+    }
+
+    Event event = {type, arg};
+    if (xQueueSend(queue, &event, 0) != pdPASS)
+    {
+        pendingMask.fetch_and(~(1 << (uint8_t)type));
+        return false;
+    }
+    return true;
+}
+
+bool IRAM_ATTR EventQueue::postFromISR(EventType type, uint32_t arg)
+{
+    if (queue == nullptr || !markPending(type))
+    {
+        return false;
+    }
+
+    Event event = {type, arg};
+    BaseType_t woken = pdFALSE;
+    if (xQueueSendFromISR(queue, &event, &woken) != pdPASS)
+    {
+        pendingMask.fetch_and(~(1 << (uint8_t)type));
+        return false;
+    }
+    if (woken == pdTRUE)
+    {
+        portYIELD_FROM_ISR();
+    }
+    return true;
+}
+
+bool EventQueue::wait(Event &event, uint32_t timeoutMs)
+{
+    if (queue == nullptr)
+    {
+        delay(timeoutMs);
+        return false;
+    }
+
+    if (xQueueReceive(queue, &event, pdMS_TO_TICKS(timeoutMs)) != pdPASS)
+    {
+        return false;
+    }
+
+    pendingMask.fetch_and(~(1 << (uint8_t)event.type));
+    return true;
+}
+
+bool EventQueue::pending() const
+{
+    return pendingMask.load() != 0;
+}
@@ -0,0 +1,186 @@
+#include "JsonArena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const size_t ARENA_ALIGN = 8;
+
+static size_t alignUp(size_t size)
+{
+    return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+// ========== JsonArena ==========
+
+JsonArena &JsonArena::instance()
+{
+    // 静态存储：启动即预留，不占用堆 / Static storage, reserved at boot outside the heap
+    static JsonArena arena;
+    return arena;
+}
+
+JsonArena::JsonArena()
+    : used(0),
+      lastOffset(0),
+      peak(0),
+      fallbacks(0),
+      leased(false)
+{
+}
+
+bool JsonArena::acquire()
+{
+    // webhook 任务与主循环可能并发构建文档，租用需原子化 / Atomic: documents may be built from more than one task
+    return !leased.exchange(true);
+}
+
+void JsonArena::release()
+{
+    used = 0;
+    lastOffset = 0;
+    leased.store(false);
+}
+
+void *JsonArena::allocate(size_t size)
+{
+    const size_t aligned = alignUp(size);
+    if (aligned > CAPACITY - used)
+    {
+        return nullptr;
+    }
+
+    lastOffset = used;
+    used += aligned;
+    if (used > peak)
+    {
+        peak = used;
+    }
+    return buffer + lastOffset;
+}
+
+void JsonArena::deallocate(void *ptr)
+{
+    // 只有最后一块可以真正回收，其余在归还时整体复位 / Only the top block is reclaimed, the rest on release()
+    if (ptr == buffer + lastOffset && used > 0)
+    {
+        used = lastOffset;
+    }
+}
+
+void *JsonArena::reallocate(void *ptr, size_t newSize)
+{
+    // 最后一块：原地伸缩 / Top block: grow or shrink in place
+    if (ptr == buffer + lastOffset && used > 0)
+    {
+        const size_t aligned = alignUp(newSize);
+        if (aligned > CAPACITY - lastOffset)
+        {
+            return nullptr;
+        }
+        used = lastOffset + aligned;
+        if (used > peak)
+        {
+            peak = used;
+        }
+        return ptr;
+    }
+
+    // 其他块：搬到顶部 / Other blocks: move to the top
+    const size_t available = bytesFrom(ptr);
+    void *moved = allocate(newSize);
+    if (moved != nullptr)
+    {
+        memmove(moved, ptr, available < newSize ? available : newSize);
+    }
+    return moved;
+}
+
+bool JsonArena::contains(const void *ptr) const
+{
+    const uint8_t *p = static_cast<const uint8_t *>(ptr);
+    return p >= buffer && p < buffer + CAPACITY;
+}
+
+size_t JsonArena::bytesFrom(const void *ptr) const
+{
+    const size_t offset = static_cast<const uint8_t *>(ptr) - buffer;
+    return offset < used ? used - offset : 0;
+}
+
+// ========== JsonArenaAllocator ==========
+
+JsonArenaAllocator::JsonArenaAllocator()
+    : leased(JsonArena::instance().acquire())
+{
+}
+
+JsonArenaAllocator::JsonArenaAllocator(const JsonArenaAllocator &other)
+    : leased(other.leased)
+{
+    // 转移所有权，避免重复归还 / Transfer ownership so the arena is released exactly once
+    other.leased = false;
+}
+
+JsonArenaAllocator::~JsonArenaAllocator()
+{
+    if (leased)
+    {
+        JsonArena::instance().release();
+    }
+}
+
+void *JsonArenaAllocator::allocate(size_t size)
+{
+    JsonArena &arena = JsonArena::instance();
+    if (leased)
+    {
+        void *ptr = arena.allocate(size);
+        if (ptr != nullptr)
+        {
+            return ptr;
+        }
+    }
+
+    // 内存区被占用或不足：回退到堆 / Arena busy or full: fall back to the heap
+    arena.noteFallback();
+    return malloc(size);
+}
+
+void JsonArenaAllocator::deallocate(void *ptr)
+{
+    JsonArena &arena = JsonArena::instance();
+    if (arena.contains(ptr))
+    {
+        arena.deallocate(ptr);
+    }
+    else
+    {
+        free(ptr);
+    }
+}
+
+void *JsonArenaAllocator::reallocate(void *ptr, size_t newSize)
+{
+    JsonArena &arena = JsonArena::instance();
+    if (ptr == nullptr || !arena.contains(ptr))
+    {
+        return realloc(ptr, newSize);
+    }
+
+    void *resized = arena.reallocate(ptr, newSize);
+    if (resized != nullptr)
+    {
+        return resized;
+    }
+
+    // 内存区已满：搬到堆上 / Arena full: move the block to the heap
+    arena.noteFallback();
+    void *moved = malloc(newSize);
+    if (moved != nullptr)
+    {
+        const size_t available = arena.bytesFrom(ptr);
+        memcpy(moved, ptr, available < newSize ? available : newSize);
+        arena.deallocate(ptr);
+    }
+    return moved;
+}
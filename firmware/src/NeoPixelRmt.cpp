@@ -0,0 +1,169 @@
+#include "NeoPixelRmt.h"
+
+NeoPixelRmt::NeoPixelRmt(uint8_t pin, uint16_t numLeds, rmt_channel_t channel)
+    : pin(pin),
+      numLeds(numLeds),
+      channel(channel),
+      scale(256),
+      canvas(new uint32_t[numLeds]()),
+      shadow(new uint32_t[numLeds]()),
+      shadowValid(false),
+      pending(new uint32_t[numLeds]()),
+      sending(new uint32_t[numLeds]()),
+      items(nullptr),
+      hasPending(false),
+      busy(false),
+      mux(portMUX_INITIALIZER_UNLOCKED),
+      taskHandle(nullptr),
+      shown(0),
+      dropped(0),
+      suppressed(0)
+{
+}
+
+void NeoPixelRmt::begin()
+{
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, channel);
+    config.clk_div = RMT_CLK_DIV;
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+    if (rmt_config(&config) != ESP_OK || rmt_driver_install(channel, 0, 0) != ESP_OK)
+    {
+        Serial.println("NeoPixelRmt: RMT init failed / RMT 初始化失败");
+        return;
+    }
+
+    // 每个像素 24 位，每位一个 RMT 项 / 24 bits per pixel, one RMT item per bit
+    items = new rmt_item32_t[numLeds * 24];
+
+    // 低优先级、放在核心 0：主循环（核心 1）永远不等灯环 / Low priority on core 0: the loop (core 1) never waits on the ring
+    xTaskCreatePinnedToCore(ledTask, "LED Task", 2048, this, 1, &taskHandle, 0);
+}
+
+void NeoPixelRmt::setBrightness(uint8_t brightness)
+{
+    portENTER_CRITICAL(&mux);
+    scale = (uint16_t)brightness + 1;
+    portEXIT_CRITICAL(&mux);
+    shadowValid = false;
+}
+
+void NeoPixelRmt::setPixelColor(uint16_t index, uint32_t color)
+{
+    if (index < numLeds)
+    {
+        canvas[index] = color;
+    }
+}
+
+void NeoPixelRmt::fill(uint32_t color)
+{
+    for (uint16_t i = 0; i < numLeds; i++)
+    {
+        canvas[i] = color;
+    }
+}
+
+void NeoPixelRmt::clear()
+{
+    memset(canvas, 0, numLeds * sizeof(uint32_t));
+}
+
+bool NeoPixelRmt::show()
+{
+    if (taskHandle == nullptr)
+    {
+        return false;
+    }
+
+    const size_t bytes = numLeds * sizeof(uint32_t);
+    if (shadowValid && memcmp(canvas, shadow, bytes) == 0)
+    {
+        suppressed++; // 没有像素变化，不占用 RMT / No pixel changed; leave the RMT alone
+        return false;
+    }
+    memcpy(shadow, canvas, bytes);
+    shadowValid = true;
+
+    portENTER_CRITICAL(&mux);
+    if (hasPending)
+    {
+        dropped++; // 上一帧还没取走，被新帧覆盖 / The previous frame was never taken; replace it
+    }
+    memcpy(pending, canvas, bytes);
+    hasPending = true;
+    portEXIT_CRITICAL(&mux);
+
+    xTaskNotifyGive(taskHandle);
+    return true;
+}
+
+bool NeoPixelRmt::waitIdle(uint32_t timeoutMs)
+{
+    const unsigned long start = millis();
+    while (hasPending || busy)
+    {
+        if (millis() - start >= timeoutMs)
+        {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+void NeoPixelRmt::ledTask(void *param)
+{
+    NeoPixelRmt *self = static_cast<NeoPixelRmt *>(param);
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        portENTER_CRITICAL(&self->mux);
+        if (!self->hasPending)
+        {
+            portEXIT_CRITICAL(&self->mux);
+            continue;
+        }
+        memcpy(self->sending, self->pending, self->numLeds * sizeof(uint32_t));
+        self->hasPending = false;
+        self->busy = true;
+        const uint16_t scale = self->scale;
+        portEXIT_CRITICAL(&self->mux);
+
+        self->encode(self->sending, scale);
+
+        // 只阻塞本任务；RMT 驱动在中断里续填脉冲 / Blocks only this task; the RMT driver refills pulses from its ISR
+        rmt_write_items(self->channel, self->items, self->numLeds * 24, true);
+        delayMicroseconds(RESET_US);
+
+        self->shown++;
+        self->busy = false;
+    }
+}
+
+void NeoPixelRmt::encode(const uint32_t *frame, uint16_t scale)
+{
+    rmt_item32_t *item = items;
+    for (uint16_t i = 0; i < numLeds; i++)
+    {
+        const uint32_t color = frame[i];
+        const uint8_t r = ((color >> 16 & 0xFF) * scale) >> 8;
+        const uint8_t g = ((color >> 8 & 0xFF) * scale) >> 8;
+        const uint8_t b = ((color & 0xFF) * scale) >> 8;
+
+        // WS2812 按 GRB、高位先发 / WS2812 takes GRB, most significant bit first
+        const uint32_t grb = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+        for (int bit = 23; bit >= 0; bit--)
+        {
+            const bool one = (grb >> bit) & 1;
+            item->level0 = 1;
+            item->duration0 = one ? T1H : T0H;
+            item->level1 = 0;
+            item->duration1 = one ? T1L : T0L;
+            item++;
+        }
+    }
+}
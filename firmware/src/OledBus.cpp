@@ -0,0 +1,94 @@
+#include "OledBus.h"
+
+OledBus::OledBus(TwoWire &wire, uint8_t address)
+    : wire(wire),
+      address(address),
+      clock(FALLBACK_HZ),
+      chunk(DEFAULT_CHUNK),
+      transfers(0),
+      failures(0)
+{
+}
+
+void OledBus::reserve(size_t frameBytes)
+{
+    // 控制字节 + 整帧 / Control byte plus a whole frame
+    const size_t size = wire.setBufferSize(frameBytes + 1);
+    if (size > 1)
+    {
+        chunk = size - 1;
+    }
+    else
+    {
+        Serial.println("OledBus: Wire buffer not resized, using small transfers / 未能放大 Wire 缓冲区");
+    }
+}
+
+void OledBus::begin(uint32_t clockHz)
+{
+    clock = clockHz;
+    wire.setClock(clock);
+
+    wire.beginTransmission(address);
+    if (wire.endTransmission() != 0 && clock > FALLBACK_HZ)
+    {
+        Serial.printf("OledBus: No ACK at %lu kHz, falling back to %lu kHz / 面板不支持该时钟，退回\n",
+                      (unsigned long)(clock / 1000), (unsigned long)(FALLBACK_HZ / 1000));
+        clock = FALLBACK_HZ;
+        wire.setClock(clock);
+    }
+}
+
+bool OledBus::fallBack()
+{
+    if (clock <= FALLBACK_HZ)
+    {
+        return false;
+    }
+    Serial.printf("OledBus: Transfer errors at %lu kHz, falling back to %lu kHz / 传输出错，退回\n",
+                  (unsigned long)(clock / 1000), (unsigned long)(FALLBACK_HZ / 1000));
+    clock = FALLBACK_HZ;
+    wire.setClock(clock);
+    return true;
+}
+
+void OledBus::claim()
+{
+    if (wire.getClock() != clock)
+    {
+        wire.setClock(clock);
+    }
+}
+
+bool OledBus::window(uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1)
+{
+    const uint8_t commands[] = {CMD_PAGEADDR, page0, page1, CMD_COLUMNADDR, col0, col1};
+    return send(CONTROL_COMMAND, commands, sizeof(commands));
+}
+
+bool OledBus::data(const uint8_t *bytes, size_t length)
+{
+    bool ok = true;
+    while (length > 0)
+    {
+        const size_t n = length < chunk ? length : chunk;
+        ok = send(CONTROL_DATA, bytes, n) && ok;
+        bytes += n;
+        length -= n;
+    }
+    return ok;
+}
+
+bool OledBus::send(uint8_t control, const uint8_t *bytes, size_t length)
+{
+    wire.beginTransmission(address);
+    wire.write(control);
+    wire.write(bytes, length);
+    transfers++;
+    if (wire.endTransmission() != 0)
+    {
+        failures++;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,290 @@
+#include "PageRaster.h"
+
+PageRaster::PageRaster(uint8_t *buffer, int16_t width, int16_t height)
+    : buffer(buffer), width(width), height(height)
+{
+}
+
+void PageRaster::apply(uint8_t &dst, uint8_t mask, uint8_t color)
+{
+    switch (color)
+    {
+    case White:
+        dst |= mask;
+        break;
+    case Black:
+        dst &= ~mask;
+        break;
+    default:
+        dst ^= mask;
+        break;
+    }
+}
+
+void PageRaster::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color)
+{
+    // 裁剪到屏幕 / Clip to the screen
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+    if (x + w > width)
+    {
+        w = width - x;
+    }
+    if (y + h > height)
+    {
+        h = height - y;
+    }
+    if (w <= 0 || h <= 0)
+    {
+        return;
+    }
+
+    const int16_t y1 = y + h - 1;
+    const int16_t firstPage = y >> 3;
+    const int16_t lastPage = y1 >> 3;
+
+    for (int16_t page = firstPage; page <= lastPage; page++)
+    {
+        // 本页内被覆盖的位 / Bits of this page inside the span
+        uint8_t mask = 0xFF;
+        if (page == firstPage)
+        {
+            mask &= 0xFF << (y & 7);
+        }
+        if (page == lastPage)
+        {
+            mask &= 0xFF >> (7 - (y1 & 7));
+        }
+
+        uint8_t *row = buffer + page * width + x;
+        if (mask == 0xFF && color != Invert)
+        {
+            memset(row, color == White ? 0xFF : 0x00, w);
+            continue;
+        }
+        for (int16_t i = 0; i < w; i++)
+        {
+            apply(row[i], mask, color);
+        }
+    }
+}
+
+void PageRaster::fillColumn(int16_t x, int16_t y0, int16_t y1, uint8_t color)
+{
+    if (x < 0 || x >= width)
+    {
+        return;
+    }
+    if (y0 < 0)
+    {
+        y0 = 0;
+    }
+    if (y1 >= height)
+    {
+        y1 = height - 1;
+    }
+    if (y0 > y1)
+    {
+        return;
+    }
+
+    const int16_t firstPage = y0 >> 3;
+    const int16_t lastPage = y1 >> 3;
+    for (int16_t page = firstPage; page <= lastPage; page++)
+    {
+        uint8_t mask = 0xFF;
+        if (page == firstPage)
+        {
+            mask &= 0xFF << (y0 & 7);
+        }
+        if (page == lastPage)
+        {
+            mask &= 0xFF >> (7 - (y1 & 7));
+        }
+        apply(buffer[page * width + x], mask, color);
+    }
+}
+
+void PageRaster::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint8_t color)
+{
+    // 同 Adafruit_GFX：半径不超过短边一半 / As Adafruit_GFX: radius capped at half the short side
+    const int16_t maxRadius = ((w < h) ? w : h) / 2;
+    if (r > maxRadius)
+    {
+        r = maxRadius;
+    }
+    if (r < 0)
+    {
+        r = 0;
+    }
+
+    fillRect(x + r, y, w - 2 * r, h, color);
+    if (r == 0)
+    {
+        return;
+    }
+
+    // 按 GFX fillCircleHelper 的中点圆算法求每个边角列的半高，每列只填一次（反色时不会叠两次）
+    // Half-height of each corner column from GFX fillCircleHelper's midpoint circle; each column is filled
+    // once, so Invert never toggles a pixel twice
+    int16_t extent[33];
+    for (int16_t i = 0; i <= r && i < 33; i++)
+    {
+        extent[i] = -1;
+    }
+
+    int16_t f = 1 - r;
+    int16_t ddFx = 1;
+    int16_t ddFy = -2 * r;
+    int16_t cx = 0;
+    int16_t cy = r;
+    int16_t px = cx;
+    int16_t py = cy;
+    while (cx < cy)
+    {
+        if (f >= 0)
+        {
+            cy--;
+            ddFy += 2;
+            f += ddFy;
+        }
+        cx++;
+        ddFx += 2;
+        f += ddFx;
+        if (cx < cy + 1 && cx < 33 && cy > extent[cx])
+        {
+            extent[cx] = cy;
+        }
+        if (cy != py)
+        {
+            if (py < 33 && px > extent[py])
+            {
+                extent[py] = px;
+            }
+            py = cy;
+        }
+        px = cx;
+    }
+
+    // 列 dx 覆盖 [y + r - e, y + h - 1 - (r - e)] / Column dx covers [y + r - e, y + h - 1 - (r - e)]
+    const int16_t rightCenter = x + w - r - 1;
+    const int16_t leftCenter = x + r;
+    for (int16_t dx = 1; dx <= r && dx < 33; dx++)
+    {
+        const int16_t e = extent[dx];
+        if (e < 0)
+        {
+            continue;
+        }
+        const int16_t top = y + r - e;
+        const int16_t bottom = y + h - 1 - (r - e);
+        fillColumn(rightCenter + dx, top, bottom, color);
+        fillColumn(leftCenter - dx, top, bottom, color);
+    }
+}
+
+// 8x8 位矩阵转置（Hacker's Delight transpose8）：in[k] 的第 7-i 位 → out[i] 的第 7-k 位
+// 8x8 bit-matrix transpose (Hacker's Delight transpose8): bit 7-i of in[k] -> bit 7-k of out[i]
+static void transpose8(const uint8_t in[8], uint8_t out[8])
+{
+    uint32_t x = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | in[3];
+    uint32_t y = ((uint32_t)in[4] << 24) | ((uint32_t)in[5] << 16) | ((uint32_t)in[6] << 8) | in[7];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    out[0] = x >> 24;
+    out[1] = x >> 16;
+    out[2] = x >> 8;
+    out[3] = x;
+    out[4] = y >> 24;
+    out[5] = y >> 16;
+    out[6] = y >> 8;
+    out[7] = y;
+}
+
+void PageRaster::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint8_t color)
+{
+    const int16_t byteWidth = (w + 7) / 8;
+
+    // 只处理位图与屏幕重叠的页 / Only the pages where the bitmap overlaps the screen
+    int16_t top = y < 0 ? 0 : y;
+    int16_t bottom = y + h - 1;
+    if (bottom >= height)
+    {
+        bottom = height - 1;
+    }
+    if (top > bottom)
+    {
+        return;
+    }
+
+    for (int16_t page = top >> 3; page <= (bottom >> 3); page++)
+    {
+        uint8_t *pageRow = buffer + page * width;
+
+        // 本页第 k 位对应源行 base + k；超出位图或屏幕的行留空
+        // Bit k of this page is source row base + k; rows outside the bitmap or screen stay empty
+        const int16_t base = page * 8 - y;
+        const int16_t kFirst = (page * 8 < top) ? top - page * 8 : 0;
+        const int16_t kLast = (page * 8 + 7 > bottom) ? bottom - page * 8 : 7;
+
+        for (int16_t b = 0; b < byteWidth; b++)
+        {
+            const int16_t x0 = x + b * 8;
+            if (x0 >= width || x0 + 8 <= 0)
+            {
+                continue;
+            }
+
+            // 逆序收集 8 个源行字节，转置后 cols[i] 即第 i 列的整页字节（第 k 位 = 源行 base + k）
+            // Gather the 8 source row bytes in reverse so that after the transpose cols[i] is the page byte of
+            // column i (bit k = source row base + k)
+            uint8_t rows[8] = {0};
+            uint8_t any = 0;
+            for (int16_t k = kFirst; k <= kLast; k++)
+            {
+                rows[7 - k] = pgm_read_byte(bitmap + (base + k) * byteWidth + b);
+                any |= rows[7 - k];
+            }
+            if (any == 0)
+            {
+                continue; // 空白块整体跳过 / Skip empty blocks at once
+            }
+
+            uint8_t cols[8];
+            transpose8(rows, cols);
+
+            // 每列一次带掩码的字节运算，只改置位像素 / One masked byte operation per column; only set pixels change
+            const int16_t count = (w - b * 8) < 8 ? (w - b * 8) : 8;
+            for (int16_t i = 0; i < count; i++)
+            {
+                const int16_t px = x0 + i;
+                if (cols[i] != 0 && px >= 0 && px < width)
+                {
+                    apply(pageRow[px], cols[i], color);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include "Scheduler.h"
+#include <esp_timer.h>
+
+// Global scheduler instance / 调度器全局实例
+Scheduler scheduler;
+
+Scheduler::Scheduler()
+    : count(0)
+{
+}
+
+int64_t Scheduler::nowMs()
+{
+    return esp_timer_get_time() / 1000;
+}
+
+Scheduler::Handle Scheduler::add(const char *name, Callback callback, void *arg, bool deferrable)
+{
+    if (count >= MAX_TASKS)
+    {
+        Serial.printf("Scheduler: No slot for %s / 调度器槽位已满\n", name);
+        return INVALID;
+    }
+
+    Task &task = tasks[count];
+    task.name = name;
+    task.callback = callback;
+    task.arg = arg;
+    task.dueMs = 0;
+    task.periodMs = 0;
+    task.armed = false;
+    task.deferrable = deferrable;
+    return count++;
+}
+
+void Scheduler::arm(Handle handle, uint32_t delayMs, uint32_t periodMs)
+{
+    if (handle >= count)
+    {
+        return;
+    }
+
+    Task &task = tasks[handle];
+    task.dueMs = nowMs() + delayMs;
+    task.periodMs = periodMs;
+    task.armed = true;
+}
+
+void Scheduler::in(Handle handle, uint32_t delayMs)
+{
+    arm(handle, delayMs, 0);
+}
+
+void Scheduler::within(Handle handle, uint32_t delayMs)
+{
+    if (handle >= count)
+    {
+        return;
+    }
+
+    const Task &task = tasks[handle];
+    if (task.armed && task.dueMs <= nowMs() + delayMs)
+    {
+        return;
+    }
+    arm(handle, delayMs, task.armed ? task.periodMs : 0);
+}
+
+void Scheduler::every(Handle handle, uint32_t periodMs)
+{
+    arm(handle, periodMs, periodMs);
+}
+
+void Scheduler::cancel(Handle handle)
+{
+    if (handle < count)
+    {
+        tasks[handle].armed = false;
+    }
+}
+
+bool Scheduler::armed(Handle handle) const
+{
+    return handle < count && tasks[handle].armed;
+}
+
+void Scheduler::run()
+{
+    const int64_t now = nowMs();
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        Task &task = tasks[i];
+        if (!task.armed || task.dueMs > now)
+        {
+            continue;
+        }
+
+        // 先推进/撤销再回调，回调内的重新布防优先 / Advance or disarm first so a re-arm inside the callback wins
+        if (task.periodMs > 0)
+        {
+            task.dueMs += task.periodMs;
+            if (task.dueMs <= now)
+            {
+                task.dueMs = now + task.periodMs; // 落后超过一个周期时不补跑 / Skip missed periods instead of bursting
+            }
+        }
+        else
+        {
+            task.armed = false;
+        }
+
+        task.callback(task.arg);
+    }
+}
+
+uint32_t Scheduler::msUntilNext(bool includeDeferrable) const
+{
+    bool any = false;
+    int64_t earliest = INT64_MAX;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const Task &task = tasks[i];
+        if (task.armed && (includeDeferrable || !task.deferrable) && task.dueMs < earliest)
+        {
+            earliest = task.dueMs;
+            any = true;
+        }
+    }
+
+    if (!any)
+    {
+        return UINT32_MAX;
+    }
+
+    const int64_t untilMs = earliest - nowMs();
+    if (untilMs <= 0)
+    {
+        return 0;
+    }
+    return untilMs >= UINT32_MAX ? UINT32_MAX - 1 : (uint32_t)untilMs;
+}
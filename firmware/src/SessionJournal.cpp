@@ -0,0 +1,206 @@
+#include "SessionJournal.h"
+#include "Config.h"
+#include "Controllers.h"
+#include "JsonArena.h"
+#include <ArduinoJson.h>
+#include <esp_system.h>
+#include <esp32/rom/crc.h>
+
+// Global session journal / 会话记录全局实例
+SessionJournal sessionJournal;
+
+RTC_NOINIT_ATTR SessionJournal::Record SessionJournal::rtcRecord;
+
+static const char* resetReasonName(esp_reset_reason_t reason)
+{
+    switch (reason)
+    {
+    case ESP_RST_POWERON:
+        return "power_on";
+    case ESP_RST_SW:
+        return "software";
+    case ESP_RST_PANIC:
+        return "panic";
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT:
+        return "watchdog";
+    case ESP_RST_BROWNOUT:
+        return "brownout";
+    default:
+        return "other";
+    }
+}
+
+SessionJournal::SessionJournal()
+    : nvsHasRecord(false),
+      nvsRunning(false),
+      nvsWrittenAtUs(0),
+      interruptedValid(false),
+      interruptedSource(""),
+      reportTask(Scheduler::INVALID)
+{
+}
+
+void SessionJournal::begin()
+{
+    reportTask = scheduler.add("journal-report", onReport, this, true);
+
+    const Record rtc = rtcRecord;
+
+    Record nvs;
+    prefs.begin("session", true);
+    nvsHasRecord = prefs.getBytesLength("record") == sizeof(Record) &&
+                   prefs.getBytes("record", &nvs, sizeof(nvs)) == sizeof(nvs) &&
+                   isValid(nvs);
+    prefs.end();
+
+    // RTC 记录最新（每秒更新），断电后失效时退回 NVS / RTC is freshest; fall back to NVS after power loss
+    if (isValid(rtc))
+    {
+        interrupted = rtc;
+        interruptedSource = "rtc";
+        interruptedValid = true;
+    }
+    else if (nvsHasRecord)
+    {
+        interrupted = nvs;
+        interruptedSource = "nvs";
+        interruptedValid = true;
+    }
+
+    if (interruptedValid)
+    {
+        Serial.printf("SessionJournal: Interrupted session %s, %lu s (%s) / 发现中断的会话\n",
+                      interrupted.sessionId, (unsigned long)(interrupted.elapsedUs / 1000000), interruptedSource);
+    }
+}
+
+void SessionJournal::onReport(void* arg)
+{
+    SessionJournal* self = static_cast<SessionJournal*>(arg);
+    if (!networkController.isWiFiConnected())
+    {
+        return; // 周期任务，下个周期再试 / Periodic; try again next period
+    }
+
+    networkController.sendWebhookPayload(self->pendingReport);
+    self->pendingReport = "";
+    scheduler.cancel(self->reportTask);
+}
+
+void SessionJournal::record(const FocusSession& session)
+{
+    Record record;
+    memset(&record, 0, sizeof(record));
+    record.magic = MAGIC;
+    record.durationMin = (uint16_t)session.duration;
+    record.running = session.clock.running() ? 1 : 0;
+    record.elapsedUs = session.clock.elapsedUs();
+    copyText(record.sessionId, sizeof(record.sessionId), session.sessionId);
+    copyText(record.taskId, sizeof(record.taskId), session.taskId);
+    copyText(record.taskName, sizeof(record.taskName), session.taskName);
+    copyText(record.taskDisplayName, sizeof(record.taskDisplayName), session.taskDisplayName);
+    copyText(record.taskProjectId, sizeof(record.taskProjectId), session.taskProjectId);
+    seal(record);
+
+    // RTC 内存写入无磨损，每次都写 / RTC writes cost nothing, always write
+    rtcRecord = record;
+
+    // NVS：新会话或暂停/恢复立即写，计时进度合并到固定间隔 / NVS: phase changes at once, progress coalesced
+    const bool phaseChanged = !nvsHasRecord || nvsRunning != (record.running != 0) || nvsSessionId != session.sessionId;
+    const bool due = record.running && FocusClock::now() - nvsWrittenAtUs >= (int64_t)SESSION_NVS_INTERVAL * 1000000;
+    if (phaseChanged || due)
+    {
+        writeNvs(record);
+        nvsSessionId = session.sessionId;
+    }
+}
+
+void SessionJournal::clear()
+{
+    memset(&rtcRecord, 0, sizeof(rtcRecord));
+
+    if (nvsHasRecord)
+    {
+        prefs.begin("session", false);
+        prefs.remove("record");
+        prefs.end();
+        nvsHasRecord = false;
+        nvsSessionId = "";
+    }
+}
+
+FocusSession SessionJournal::takeInterrupted()
+{
+    FocusSession session;
+    if (!interruptedValid)
+    {
+        return session;
+    }
+    interruptedValid = false;
+
+    session.duration = interrupted.durationMin;
+    session.clock.accumulatedUs = interrupted.elapsedUs;
+    session.sessionId = interrupted.sessionId;
+    session.taskId = interrupted.taskId;
+    session.taskName = interrupted.taskName;
+    session.taskDisplayName = interrupted.taskDisplayName;
+    session.taskProjectId = interrupted.taskProjectId;
+
+    // 与 focus_paused 同口径：不计入统计，HA 收到后按暂停处理 / Same as focus_paused: not counted, HA treats it as a pause
+    ArenaJsonDocument doc(768);
+    doc["action"] = "stop";
+    doc["event"] = "focus_interrupted";
+    doc["session_id"] = session.sessionId;
+    doc["task_id"] = session.taskId;
+    doc["task_name"] = session.taskName;
+    doc["task_display_name"] = session.taskDisplayName;
+    doc["elapsed_seconds"] = session.elapsedSeconds();
+    doc["count_time"] = false;
+    doc["was_running"] = interrupted.running != 0;
+    doc["reset_reason"] = resetReasonName(esp_reset_reason());
+    doc["checkpoint"] = interruptedSource;
+    serializeJson(doc, pendingReport);
+    scheduler.every(reportTask, REPORT_RETRY_MS);
+
+    return session;
+}
+
+bool SessionJournal::isValid(const Record& record)
+{
+    return record.magic == MAGIC &&
+           record.crc == crc32_le(0, reinterpret_cast<const uint8_t*>(&record), offsetof(Record, crc));
+}
+
+void SessionJournal::seal(Record& record)
+{
+    record.crc = crc32_le(0, reinterpret_cast<const uint8_t*>(&record), offsetof(Record, crc));
+}
+
+void SessionJournal::copyText(char* dest, size_t size, const String& text)
+{
+    // 截断时退到 UTF-8 字符边界 / Back off to a UTF-8 boundary when truncating
+    size_t length = text.length();
+    if (length >= size)
+    {
+        length = size - 1;
+        while (length > 0 && (text[length] & 0xC0) == 0x80)
+        {
+            length--;
+        }
+    }
+    memcpy(dest, text.c_str(), length);
+    dest[length] = '\0';
+}
+
+void SessionJournal::writeNvs(const Record& record)
+{
+    prefs.begin("session", false);
+    prefs.putBytes("record", &record, sizeof(record));
+    prefs.end();
+
+    nvsHasRecord = true;
+    nvsRunning = record.running != 0;
+    nvsWrittenAtUs = FocusClock::now();
+}
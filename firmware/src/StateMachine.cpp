@@ -1,4 +1,7 @@
 #include "StateMachine.h"
+#include "Controllers.h"
+#include "EventQueue.h"
+#include "SessionJournal.h"
 
 // Global state machine instance / 状态机全局实例
 StateMachine stateMachine;
@@ -19,11 +22,37 @@ TaskListState StateMachine::taskListState;
 TaskListViewState StateMachine::taskListViewState;
 TimerState StateMachine::timerState;
 
+// 与 StateId 顺序一致 / Same order as StateId
+static State* const STATES[] = {
+    &StateMachine::startupState,
+    &StateMachine::provisionState,
+    &StateMachine::idleState,
+    &StateMachine::adjustState,
+    &StateMachine::resetState,
+    &StateMachine::sleepState,
+    &StateMachine::timerState,
+    &StateMachine::pausedState,
+    &StateMachine::doneState,
+    &StateMachine::taskListViewState,
+    &StateMachine::taskCompletePromptState,
+    &StateMachine::taskListState,
+    &StateMachine::durationSelectState,
+    &StateMachine::taskDetailState,
+};
+
+static_assert(sizeof(STATES) / sizeof(STATES[0]) == (size_t)StateId::Count, "STATES out of sync with StateId");
+
 StateMachine::StateMachine() {
     currentState = &startupState;  // Start with StartupState / 初始状态为启动态
+    currentId = StateId::Startup;
     stateMutex = xSemaphoreCreateMutex();  // Initialize the mutex / 创建互斥量
 }
 
+void StateMachine::begin() {
+    stateTask = scheduler.add("state", onStateTick, this);
+    timeoutTask = scheduler.add("state-timeout", onStateTimeout, this);
+}
+
 // Clean up the state and delete the mutex / 清理状态并释放互斥量
 StateMachine::~StateMachine() {
     if (stateMutex != NULL) {
@@ -36,18 +65,157 @@ void StateMachine::changeState(State* newState) {
     if (xSemaphoreTake(stateMutex, portMAX_DELAY) == pdTRUE) {
         transition = true;
         if (currentState != nullptr) {
+            // 截下旧画面，新状态的首次绘制即开始切换 / Snapshot the old screen; the new state's first draw starts the transition
+            displayController.beginTransition(Transitions::screenFor(currentId, idOf(newState)));
             currentState->exit();
         }
+        inputController.reset();  // 新状态不继承上个状态未完成的手势 / New state starts with no pending gesture
         currentState = newState;  // Assign the new state (static state) / 切换到新的静态状态
+        currentId = idOf(newState);
+        powerController.enterState(currentId);
+        inputController.setEncoderProfile(currentState->encoderProfile());
+        scheduler.cancel(timeoutTask);  // 超时属于上个状态 / Timeouts belong to the previous state
         currentState->enter();
+        checkpointSession();
+        requestUpdate();
         transition = false;
         xSemaphoreGive(stateMutex);  // Release the mutex / 释放互斥量
     }
 }
 
+void StateMachine::changeState(StateId id) {
+    changeState(stateFor(id));
+}
+
+void StateMachine::handleInput(const InputEvent& event) {
+    if (transition || currentState == nullptr) {
+        return;
+    }
+    if (!currentState->onInput(event)) {
+        if (event.gesture == Trigger::HoldRotate) {
+            // 没有按住旋转动作的状态当作普通旋转 / States without a hold-turn action treat it as a plain turn
+            InputEvent turn = event;
+            turn.gesture = Trigger::Rotate;
+            if (!currentState->onInput(turn)) {
+                dispatch(Trigger::Rotate);
+            }
+        } else {
+            dispatch(event.gesture);
+        }
+    }
+    requestUpdate();
+}
+
+bool StateMachine::dispatch(Trigger trigger) {
+    size_t count = 0;
+    const Transition* rows = Transitions::rowsFor(currentId, count);
+
+    for (size_t i = 0; i < count; i++) {
+        const Transition& row = rows[i];
+        if (row.trigger != trigger || (row.guard != nullptr && !row.guard())) {
+            continue;
+        }
+
+        Serial.printf("FSM: %s --%s--> %s\n",
+                      Transitions::stateName(row.from),
+                      Transitions::triggerName(trigger),
+                      Transitions::stateName(row.to));
+        if (row.action != nullptr) {
+            row.action();
+        }
+        changeState(row.to);
+        return true;
+    }
+
+    return false;
+}
+
+void StateMachine::dumpGraph(Print& out) {
+    size_t count = 0;
+    const Transition* rows = Transitions::all(count);
+
+    out.println("digraph focusdial {");
+    out.println("  rankdir=LR;");
+    for (size_t i = 0; i < count; i++) {
+        const Transition& row = rows[i];
+        out.printf("  \"%s\" -> \"%s\" [label=\"%s",
+                   Transitions::stateName(row.from),
+                   Transitions::stateName(row.to),
+                   Transitions::triggerName(row.trigger));
+        if (row.guard != nullptr) {
+            out.printf(" [%s]", row.guardName);
+        }
+        out.println("\"];");
+    }
+    out.println("}");
+}
+
+State* StateMachine::stateFor(StateId id) {
+    return STATES[(uint8_t)id];
+}
+
+StateId StateMachine::idOf(State* state) {
+    for (uint8_t i = 0; i < (uint8_t)StateId::Count; i++) {
+        if (STATES[i] == state) {
+            return (StateId)i;
+        }
+    }
+    return StateId::Count;
+}
+
+void StateMachine::checkpointSession() {
+    switch (currentId) {
+    case StateId::Startup:
+    case StateId::Provision:
+        // 启动/配网期间保留上次的记录，等待恢复 / Keep the previous record until it can be restored
+        break;
+    case StateId::Timer:
+    case StateId::TaskListView:
+        sessionJournal.record(timerState.getSession());
+        break;
+    case StateId::Paused:
+        sessionJournal.record(pausedState.getSession());
+        break;
+    default:
+        sessionJournal.clear();
+        break;
+    }
+}
+
 void StateMachine::update() {
-    if (!transition && currentState != nullptr) {
-        currentState->update();  // Call update on the current state / 调用当前状态的 update
+    if (transition || currentState == nullptr) {
+        return;
+    }
+
+    currentState->update();  // Call update on the current state / 调用当前状态的 update
+
+    // update() 可能已切换状态：按（新）当前状态的截止时间排下一次，已有更早的请求则保留
+    // update() may have changed state: schedule the (new) current state's deadline, keeping any earlier request
+    const unsigned long now = millis();
+    const long untilNext = (long)(currentState->nextWakeup(now) - now);
+    scheduler.within(stateTask, untilNext <= 0 ? 0 : (uint32_t)untilNext);
+}
+
+void StateMachine::requestUpdate() {
+    scheduler.within(stateTask, 0);
+}
+
+void StateMachine::armTimeout(const State* owner, uint32_t ms, Trigger trigger) {
+    if (owner != currentState) {
+        return;
+    }
+    timeoutTrigger = trigger;
+    scheduler.in(timeoutTask, ms);
+}
+
+void StateMachine::onStateTick(void* arg) {
+    static_cast<StateMachine*>(arg)->update();
+}
+
+void StateMachine::onStateTimeout(void* arg) {
+    StateMachine* self = static_cast<StateMachine*>(arg);
+    if (!self->transition) {
+        self->dispatch(self->timeoutTrigger);
     }
 }
 
@@ -63,3 +231,66 @@ State* StateMachine::getCurrentState()
 
     return state;
 }
+
+void StateMachine::waitForEvent()
+{
+    // 所有定时工作都在调度器中，只需等到最早的截止时间 / All timed work lives in the scheduler: wait for its earliest deadline
+    Event event;
+
+    // 空闲状态且网络无事可做：可延后任务（HTTP 轮询、堆采样）不单独唤醒；等待期间轻睡眠，输入边沿随时唤醒
+    // Idle state and quiet network: deferrable tasks (HTTP poll, heap sampling) don't wake us; the wait
+    // light-sleeps, and input edges wake the chip at any time
+    if (currentState != nullptr && currentState->allowsLightSleep() && networkController.canLightSleep() && !eventQueue.pending())
+    {
+        const uint32_t sleepMs = min(scheduler.msUntilNext(false), (uint32_t)LIGHT_SLEEP_MAX_MS);
+        if (sleepMs >= LIGHT_SLEEP_MIN_MS && powerController.beginSleepWait())
+        {
+            const bool woken = powerController.sleepWait(event, sleepMs);
+            powerController.endSleepWait();
+
+            if (woken)
+            {
+                do
+                {
+                    onEvent(event);
+                } while (eventQueue.wait(event, 0));
+            }
+            return;
+        }
+    }
+
+    const uint32_t waitMs = min(scheduler.msUntilNext(), MAX_WAIT_MS);
+
+    // 阻塞期间 CPU 交给 idle 任务；醒来后把积压的事件一并取走 / CPU idles while blocked; drain the backlog on wake
+    if (eventQueue.wait(event, waitMs))
+    {
+        do
+        {
+            onEvent(event);
+        } while (eventQueue.wait(event, 0));
+    }
+}
+
+void StateMachine::onEvent(const Event& event)
+{
+    // webhook 结果闪在灯环叠加层上，不打断当前状态的灯效 / Flash the webhook result on the LED overlay, over the state's own effect
+    if (event.type == EventType::WebhookOk || event.type == EventType::WebhookFailed)
+    {
+        const bool ok = event.type == EventType::WebhookOk;
+        ledController.flash(ok ? GREEN : RED, ok ? 1 : 2);
+        return;
+    }
+
+    // 计时结束：完成 webhook 已由定时器回调入队，这里只记下完成 / Session end: the timer callback already queued the webhook; just note completion
+    if (event.type == EventType::Timer)
+    {
+        timerState.onEndEvent();
+    }
+
+    // 输入由手势分发时请求重绘；其余事件（任务列表更新、计时结束、动画结束）直接请求
+    // Input requests a redraw when a gesture is dispatched; other events (task list, timer end, animation end) request it here
+    if (event.type != EventType::Input)
+    {
+        requestUpdate();
+    }
+}
@@ -0,0 +1,393 @@
+#include "TaskListCache.h"
+#include "states/TaskListState.h"
+
+#include <SPIFFS.h>
+
+static const char *CACHE_PATH = "/tasklist.bin";
+static const char *CACHE_TMP_PATH = "/tasklist.tmp";
+
+// Upper bounds to reject corrupt files before allocating / 读取上限，避免损坏文件导致大量分配
+static const uint16_t MAX_CACHED_PROJECTS = 64;
+static const uint16_t MAX_CACHED_TASKS = 256;
+static const uint16_t MAX_CACHED_SUBTASKS = 64;
+static const uint16_t MAX_STRING_BYTES = 512;
+
+// Task flag bits / 任务标志位
+static const uint8_t FLAG_COMPLETED = 0x01;
+static const uint8_t FLAG_REPEAT = 0x02;
+static const uint8_t FLAG_REMINDER = 0x04;
+static const uint8_t FLAG_DISPLAY_NAME_SAME = 0x08; // displayName == name，省略存储
+
+// ========== Binary writer / 二进制写入 ==========
+
+struct CacheWriter
+{
+    File &file;
+    bool ok;
+
+    explicit CacheWriter(File &f) : file(f), ok(true) {}
+
+    void bytes(const void *data, size_t len)
+    {
+        if (ok && len > 0 && file.write(static_cast<const uint8_t *>(data), len) != len)
+        {
+            ok = false;
+        }
+    }
+
+    void u8(uint8_t v) { bytes(&v, 1); }
+
+    void u16(uint16_t v)
+    {
+        uint8_t b[2] = {(uint8_t)(v & 0xFF), (uint8_t)(v >> 8)};
+        bytes(b, sizeof(b));
+    }
+
+    void u32(uint32_t v)
+    {
+        uint8_t b[4] = {(uint8_t)(v & 0xFF), (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+        bytes(b, sizeof(b));
+    }
+
+    void str(const String &s)
+    {
+        uint16_t len = s.length() > MAX_STRING_BYTES ? MAX_STRING_BYTES : (uint16_t)s.length();
+        u16(len);
+        bytes(s.c_str(), len);
+    }
+};
+
+// ========== Binary reader / 二进制读取 ==========
+
+struct CacheReader
+{
+    File &file;
+    bool ok;
+
+    explicit CacheReader(File &f) : file(f), ok(true) {}
+
+    void bytes(void *data, size_t len)
+    {
+        if (ok && len > 0 && file.read(static_cast<uint8_t *>(data), len) != len)
+        {
+            ok = false;
+        }
+    }
+
+    uint8_t u8()
+    {
+        uint8_t v = 0;
+        bytes(&v, 1);
+        return v;
+    }
+
+    uint16_t u16()
+    {
+        uint8_t b[2] = {0};
+        bytes(b, sizeof(b));
+        return (uint16_t)(b[0] | (b[1] << 8));
+    }
+
+    uint32_t u32()
+    {
+        uint8_t b[4] = {0};
+        bytes(b, sizeof(b));
+        return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    }
+
+    String str()
+    {
+        String out;
+        uint16_t len = u16();
+        if (!ok || len == 0)
+        {
+            return out;
+        }
+        if (len > MAX_STRING_BYTES)
+        {
+            ok = false;
+            return out;
+        }
+
+        out.reserve(len);
+        char chunk[64];
+        while (ok && len > 0)
+        {
+            size_t n = len > sizeof(chunk) ? sizeof(chunk) : len;
+            bytes(chunk, n);
+            if (ok)
+            {
+                out.concat(chunk, n);
+            }
+            len -= n;
+        }
+        return out;
+    }
+};
+
+static void writeTask(CacheWriter &w, const FocusTask &task)
+{
+    const bool sameDisplayName = (task.displayName == task.name);
+
+    uint8_t flags = 0;
+    if (task.isCompleted) flags |= FLAG_COMPLETED;
+    if (task.hasRepeat) flags |= FLAG_REPEAT;
+    if (task.hasReminder) flags |= FLAG_REMINDER;
+    if (sameDisplayName) flags |= FLAG_DISPLAY_NAME_SAME;
+
+    w.u8(flags);
+    w.str(task.id);
+    w.str(task.projectId);
+    w.str(task.name);
+    if (!sameDisplayName)
+    {
+        w.str(task.displayName);
+    }
+    w.u16((uint16_t)task.estimatedDuration);
+    w.u32(task.spentTodaySeconds);
+    w.str(task.completedAt);
+    w.u32(task.completedSpentSeconds);
+    w.u8((uint8_t)task.priority);
+    w.str(task.priorityFlag);
+    w.str(task.dueMmdd);
+    w.u32(task.dueYmd);
+    w.u16((uint16_t)task.subtasksTotal);
+    w.u16((uint16_t)task.subtasksDone);
+
+    uint16_t subCount = task.subtasks.size() > MAX_CACHED_SUBTASKS ? MAX_CACHED_SUBTASKS : (uint16_t)task.subtasks.size();
+    w.u16(subCount);
+    for (uint16_t i = 0; i < subCount; i++)
+    {
+        w.str(task.subtasks[i].id);
+        w.str(task.subtasks[i].title);
+        w.u8(task.subtasks[i].isCompleted ? 1 : 0);
+    }
+}
+
+static bool readTask(CacheReader &r, FocusTask &task)
+{
+    uint8_t flags = r.u8();
+    task.isCompleted = (flags & FLAG_COMPLETED) != 0;
+    task.hasRepeat = (flags & FLAG_REPEAT) != 0;
+    task.hasReminder = (flags & FLAG_REMINDER) != 0;
+
+    task.id = r.str();
+    task.projectId = r.str();
+    task.name = r.str();
+    task.displayName = (flags & FLAG_DISPLAY_NAME_SAME) ? task.name : r.str();
+    task.estimatedDuration = r.u16();
+    task.spentTodaySeconds = r.u32();
+    task.completedAt = r.str();
+    task.completedSpentSeconds = r.u32();
+    task.priority = r.u8();
+    task.priorityFlag = r.str();
+    task.dueMmdd = r.str();
+    task.dueYmd = r.u32();
+    task.subtasksTotal = r.u16();
+    task.subtasksDone = r.u16();
+
+    uint16_t subCount = r.u16();
+    if (subCount > MAX_CACHED_SUBTASKS)
+    {
+        return false;
+    }
+
+    task.subtasks.clear();
+    task.subtasks.reserve(subCount);
+    for (uint16_t i = 0; i < subCount && r.ok; i++)
+    {
+        FocusSubtask sub;
+        sub.id = r.str();
+        sub.title = r.str();
+        sub.isCompleted = r.u8() != 0;
+        task.subtasks.push_back(sub);
+    }
+
+    return r.ok;
+}
+
+// ========== TaskListCache ==========
+
+TaskListCache::TaskListCache() : mounted(false) {}
+
+bool TaskListCache::begin()
+{
+    if (mounted)
+    {
+        return true;
+    }
+
+    // true: format on mount failure (first boot) / 挂载失败时格式化（首次启动）
+    mounted = SPIFFS.begin(true);
+    if (!mounted)
+    {
+        Serial.println("TaskListCache: SPIFFS mount failed / SPIFFS 挂载失败");
+    }
+    return mounted;
+}
+
+bool TaskListCache::load(TaskListState &state)
+{
+    if (!begin() || !SPIFFS.exists(CACHE_PATH))
+    {
+        return false;
+    }
+
+    File file = SPIFFS.open(CACHE_PATH, "r");
+    if (!file)
+    {
+        return false;
+    }
+
+    CacheReader r(file);
+    if (r.u32() != MAGIC || r.u8() != FORMAT_VERSION)
+    {
+        Serial.println("TaskListCache: Unknown cache format, ignoring / 缓存格式不匹配，忽略");
+        file.close();
+        return false;
+    }
+
+    const uint32_t version = r.u32();
+    String selectedProjectId = r.str();
+    String selectedProjectName = r.str();
+
+    uint16_t projectCount = r.u16();
+    if (!r.ok || projectCount > MAX_CACHED_PROJECTS)
+    {
+        file.close();
+        return false;
+    }
+
+    std::vector<FocusProject> projects;
+    projects.reserve(projectCount);
+    for (uint16_t i = 0; i < projectCount && r.ok; i++)
+    {
+        FocusProject p;
+        p.id = r.str();
+        p.name = r.str();
+        projects.push_back(p);
+    }
+
+    uint16_t taskCount = r.u16();
+    if (!r.ok || taskCount > MAX_CACHED_TASKS)
+    {
+        file.close();
+        return false;
+    }
+
+    std::vector<FocusTask> pending;
+    std::vector<FocusTask> completed;
+    for (uint16_t i = 0; i < taskCount; i++)
+    {
+        FocusTask task;
+        if (!readTask(r, task))
+        {
+            break;
+        }
+        if (task.isCompleted)
+        {
+            completed.push_back(task);
+        }
+        else
+        {
+            pending.push_back(task);
+        }
+    }
+    file.close();
+
+    if (!r.ok)
+    {
+        Serial.println("TaskListCache: Cache truncated, ignoring / 缓存不完整，忽略");
+        return false;
+    }
+
+    // Only commit to state once the whole file parsed / 全部解析成功后才写入状态
+    state.listVersion = version;
+    state.selectedProjectId = selectedProjectId;
+    state.selectedProjectName = selectedProjectName;
+    state.projects.swap(projects);
+    state.pendingTasks.swap(pending);
+    state.completedTasks.swap(completed);
+
+    Serial.printf("TaskListCache: Loaded v%lu pending=%d completed=%d / 已读回缓存\n",
+                  (unsigned long)version,
+                  (int)state.pendingTasks.size(),
+                  (int)state.completedTasks.size());
+    return true;
+}
+
+bool TaskListCache::save(const TaskListState &state)
+{
+    if (!begin())
+    {
+        return false;
+    }
+
+    // Write to a temp file first so a power loss never leaves a half-written cache
+    // 先写临时文件再替换，掉电时不会留下半截缓存
+    File file = SPIFFS.open(CACHE_TMP_PATH, "w");
+    if (!file)
+    {
+        Serial.println("TaskListCache: Failed to open cache for writing / 打开缓存文件失败");
+        return false;
+    }
+
+    CacheWriter w(file);
+    w.u32(MAGIC);
+    w.u8(FORMAT_VERSION);
+    w.u32(state.listVersion);
+    w.str(state.selectedProjectId);
+    w.str(state.selectedProjectName);
+
+    uint16_t projectCount = state.projects.size() > MAX_CACHED_PROJECTS ? MAX_CACHED_PROJECTS : (uint16_t)state.projects.size();
+    w.u16(projectCount);
+    for (uint16_t i = 0; i < projectCount; i++)
+    {
+        w.str(state.projects[i].id);
+        w.str(state.projects[i].name);
+    }
+
+    size_t total = state.pendingTasks.size() + state.completedTasks.size();
+    uint16_t taskCount = total > MAX_CACHED_TASKS ? MAX_CACHED_TASKS : (uint16_t)total;
+    w.u16(taskCount);
+
+    uint16_t written = 0;
+    for (size_t i = 0; i < state.pendingTasks.size() && written < taskCount; i++, written++)
+    {
+        writeTask(w, state.pendingTasks[i]);
+    }
+    for (size_t i = 0; i < state.completedTasks.size() && written < taskCount; i++, written++)
+    {
+        writeTask(w, state.completedTasks[i]);
+    }
+
+    const size_t bytesWritten = file.size();
+    file.close();
+
+    if (!w.ok)
+    {
+        Serial.println("TaskListCache: Write failed / 写入缓存失败");
+        SPIFFS.remove(CACHE_TMP_PATH);
+        return false;
+    }
+
+    SPIFFS.remove(CACHE_PATH);
+    if (!SPIFFS.rename(CACHE_TMP_PATH, CACHE_PATH))
+    {
+        Serial.println("TaskListCache: Rename failed / 替换缓存文件失败");
+        return false;
+    }
+
+    Serial.printf("TaskListCache: Saved v%lu (%u bytes) / 缓存已保存\n",
+                  (unsigned long)state.listVersion, (unsigned)bytesWritten);
+    return true;
+}
+
+void TaskListCache::clear()
+{
+    if (begin())
+    {
+        SPIFFS.remove(CACHE_PATH);
+        SPIFFS.remove(CACHE_TMP_PATH);
+    }
+}
@@ -0,0 +1,349 @@
+#include "Transitions.h"
+#include "StateMachine.h"
+#include "Controllers.h"
+#include "SessionJournal.h"
+
+// ========== 动作辅助 / Action helpers ==========
+
+// 发送 stop 类 webhook（暂停/取消/完成共用）/ Send a "stop" webhook (shared by pause, cancel and complete)
+static void sendFocusStop(const FocusSession &session,
+                          const char *event,
+                          uint32_t elapsedSeconds,
+                          bool countTime,
+                          const char *cancelReason = nullptr)
+{
+    networkController.sendWebhookPayload(TimerState::focusStopPayload(session, event, elapsedSeconds, countTime, cancelReason));
+}
+
+// 有任务时为“是否完成任务”确认准备上下文 / Prepare the mark-done prompt when the session has a task
+static void preparePrompt(const FocusSession &session, uint32_t elapsedSeconds, bool countTime, bool isCanceled)
+{
+    if (!session.hasTask())
+    {
+        return;
+    }
+    StateMachine::taskCompletePromptState.setContext(
+        session.taskId,
+        session.taskName,
+        session.sessionId,
+        elapsedSeconds,
+        countTime,
+        isCanceled,
+        session.taskDisplayName,
+        session.taskProjectId);
+}
+
+static void cancelSession(const FocusSession &session, const char *cancelReason)
+{
+    const uint32_t elapsed = session.elapsedSeconds();
+    sendFocusStop(session, "focus_canceled", elapsed, false, cancelReason);
+    displayController.showCancel();
+    preparePrompt(session, elapsed, false, true);
+}
+
+// ========== 条件 / Guards ==========
+
+static bool isProvisioned() { return networkController.isWiFiProvisioned(); }
+static bool hasInterruptedSession() { return sessionJournal.hasInterrupted() && isProvisioned(); }
+static bool timerHasTask() { return StateMachine::timerState.getSession().hasTask(); }
+static bool pausedHasTask() { return StateMachine::pausedState.getSession().hasTask(); }
+static bool taskListHasSelection() { return StateMachine::taskListState.getSelectedTask() != nullptr; }
+
+// ========== 动作 / Actions ==========
+
+static void showCancel() { displayController.showCancel(); }
+
+static void restoreInterrupted()
+{
+    // 重启前的会话以暂停状态恢复，可继续或取消；暂停超时照常关闭会话
+    // The pre-reset session comes back paused: resume or cancel it; the pause timeout still closes it
+    StateMachine::pausedState.setSession(sessionJournal.takeInterrupted());
+}
+
+static void restartDevice()
+{
+    Serial.println("Restarting ... / 正在重启");
+    ESP.restart();
+}
+
+static void idleStartTimer()
+{
+    StateMachine::timerState.setTimer(StateMachine::idleState.getDefaultDuration());
+    displayController.showTimerStart();
+}
+
+static void idleBeginAdjust()
+{
+    StateMachine::adjustState.adjustTimer(StateMachine::idleState.getDefaultDuration());
+}
+
+static void timerPause()
+{
+    TimerState &timer = StateMachine::timerState;
+    timer.stopClock();
+    sendFocusStop(timer.getSession(), "focus_paused", timer.getSession().elapsedSeconds(), false);
+    displayController.showTimerPause();
+    StateMachine::pausedState.setSession(timer.getSession());
+}
+
+static void timerCancel()
+{
+    StateMachine::timerState.stopClock();
+    cancelSession(StateMachine::timerState.getSession(), nullptr);
+}
+
+static void timerOpenTaskList()
+{
+    // 只读查看：时钟继续运行、不发 webhook / Read-only view: the clock keeps running, no webhook
+    StateMachine::taskListViewState.setSession(StateMachine::timerState.getSession());
+}
+
+static void timerComplete()
+{
+    // focus_completed 已由结束定时器准时发出 / focus_completed was already sent on time by the end timer
+    StateMachine::timerState.stopClock();
+    const FocusSession &session = StateMachine::timerState.getSession();
+    const uint32_t full = (uint32_t)(session.duration * 60);
+    displayController.showTimerDone();
+    preparePrompt(session, full, true, false);
+}
+
+static void pausedResume()
+{
+    StateMachine::timerState.setSession(StateMachine::pausedState.getSession());
+    displayController.showTimerResume();
+}
+
+static void pausedCancel() { cancelSession(StateMachine::pausedState.getSession(), nullptr); }
+static void pausedTimeout() { cancelSession(StateMachine::pausedState.getSession(), "pause_timeout"); }
+
+static void viewResume()
+{
+    StateMachine::timerState.setSession(StateMachine::taskListViewState.getSession());
+}
+
+static void taskListOpenTask()
+{
+    StateMachine::durationSelectState.setTask(*StateMachine::taskListState.getSelectedTask());
+}
+
+// ========== 转移表 / Transition table ==========
+//
+// 按 (from, trigger) 排序；同组内自上而下取第一条 guard 通过的行，最后一行必须无 guard 作兜底。
+// Sorted by (from, trigger); the first row whose guard passes wins, and the last row of a group is the unguarded fallback.
+
+#define ROW(from, trigger, guard, action, to) \
+    {StateId::from, Trigger::trigger, guard, action, StateId::to, #guard}
+
+static constexpr Transition TABLE[] = {
+    ROW(Startup, Done, hasInterruptedSession, restoreInterrupted, Paused),
+    ROW(Startup, Done, isProvisioned, nullptr, Idle),
+    ROW(Startup, Done, nullptr, nullptr, Provision),
+
+    ROW(Provision, Done, nullptr, nullptr, Idle),
+
+    ROW(Idle, Press, nullptr, idleStartTimer, Timer),
+    ROW(Idle, DoublePress, nullptr, nullptr, TaskList),
+    ROW(Idle, LongPress, nullptr, nullptr, Reset),
+    ROW(Idle, Rotate, nullptr, idleBeginAdjust, Adjust),
+    ROW(Idle, Timeout, nullptr, nullptr, Sleep),
+
+    ROW(Adjust, Press, nullptr, nullptr, Idle),
+    ROW(Adjust, Timeout, nullptr, nullptr, Idle),
+
+    ROW(Reset, Press, nullptr, nullptr, Idle),
+    ROW(Reset, Done, nullptr, restartDevice, Idle),
+
+    ROW(Sleep, Press, nullptr, nullptr, Idle),
+    ROW(Sleep, LongPress, nullptr, nullptr, Idle),
+    ROW(Sleep, Rotate, nullptr, nullptr, Idle),
+
+    ROW(Timer, Press, nullptr, timerPause, Paused),
+    ROW(Timer, DoublePress, timerHasTask, timerCancel, TaskCompletePrompt),
+    ROW(Timer, DoublePress, nullptr, timerCancel, Idle),
+    ROW(Timer, LongPress, timerHasTask, timerCancel, TaskCompletePrompt),
+    ROW(Timer, LongPress, nullptr, timerCancel, Idle),
+    ROW(Timer, Rotate, nullptr, timerOpenTaskList, TaskListView),
+    ROW(Timer, Done, timerHasTask, timerComplete, TaskCompletePrompt),
+    ROW(Timer, Done, nullptr, timerComplete, Done),
+
+    ROW(Paused, Press, nullptr, pausedResume, Timer),
+    ROW(Paused, DoublePress, pausedHasTask, pausedCancel, TaskCompletePrompt),
+    ROW(Paused, DoublePress, nullptr, pausedCancel, Idle),
+    ROW(Paused, Timeout, pausedHasTask, pausedTimeout, TaskCompletePrompt),
+    ROW(Paused, Timeout, nullptr, pausedTimeout, Idle),
+
+    ROW(Done, Press, nullptr, nullptr, Idle),
+    ROW(Done, Timeout, nullptr, nullptr, Idle),
+
+    ROW(TaskListView, Press, nullptr, viewResume, Timer),
+    ROW(TaskListView, Timeout, nullptr, viewResume, Timer),
+    ROW(TaskListView, Done, nullptr, viewResume, Timer),
+
+    ROW(TaskCompletePrompt, Press, nullptr, nullptr, Idle),
+    ROW(TaskCompletePrompt, LongPress, nullptr, nullptr, Idle),
+
+    ROW(TaskList, Press, taskListHasSelection, taskListOpenTask, DurationSelect),
+    ROW(TaskList, Press, nullptr, nullptr, Idle),
+    ROW(TaskList, LongPress, nullptr, showCancel, Idle),
+    ROW(TaskList, Timeout, nullptr, nullptr, Idle),
+
+    ROW(DurationSelect, Press, nullptr, nullptr, Timer),
+    ROW(DurationSelect, DoublePress, nullptr, nullptr, TaskDetail),
+    ROW(DurationSelect, LongPress, nullptr, showCancel, TaskList),
+    ROW(DurationSelect, Timeout, nullptr, nullptr, TaskList),
+
+    ROW(TaskDetail, Press, nullptr, nullptr, TaskList),
+    ROW(TaskDetail, DoublePress, nullptr, nullptr, DurationSelect),
+    ROW(TaskDetail, LongPress, nullptr, showCancel, DurationSelect),
+    ROW(TaskDetail, Timeout, nullptr, nullptr, DurationSelect),
+};
+
+#undef ROW
+
+static constexpr size_t ROW_COUNT = sizeof(TABLE) / sizeof(TABLE[0]);
+static constexpr uint8_t STATE_COUNT = (uint8_t)StateId::Count;
+
+// ========== 编译期校验 / Compile-time checks ==========
+
+static constexpr unsigned rowKey(size_t i)
+{
+    return (unsigned)TABLE[i].from * (unsigned)Trigger::Count + (unsigned)TABLE[i].trigger;
+}
+
+static constexpr bool isSorted(size_t i)
+{
+    return i + 1 >= ROW_COUNT || (rowKey(i) <= rowKey(i + 1) && isSorted(i + 1));
+}
+
+static constexpr bool isLastOfGroup(size_t i)
+{
+    return i + 1 == ROW_COUNT || rowKey(i) != rowKey(i + 1);
+}
+
+// 仅组内最后一行无 guard：否则其后的行永远不可达，或该组可能无行命中
+// Only the last row of a group is unguarded: otherwise later rows are dead or the group may match nothing
+static constexpr bool fallbacksLast(size_t i)
+{
+    return i >= ROW_COUNT || (((TABLE[i].guard == nullptr) == isLastOfGroup(i)) && fallbacksLast(i + 1));
+}
+
+static constexpr uint32_t stateBit(StateId id)
+{
+    return 1UL << (uint8_t)id;
+}
+
+// 把 mask 中状态的一步可达状态并入 mask / Add every state one transition away from `mask`
+static constexpr uint32_t stepFrom(uint32_t mask, size_t i)
+{
+    return i >= ROW_COUNT ? mask
+                          : stepFrom((mask & stateBit(TABLE[i].from)) ? (mask | stateBit(TABLE[i].to)) : mask, i + 1);
+}
+
+static constexpr uint32_t reachable(uint32_t mask, uint8_t rounds)
+{
+    return rounds == 0 ? mask : reachable(stepFrom(mask, 0), rounds - 1);
+}
+
+static_assert(isSorted(0), "Transition table must be sorted by (from, trigger)");
+static_assert(fallbacksLast(0), "Each (from, trigger) group must end with exactly one unguarded row");
+static_assert(reachable(stateBit(StateId::Startup), STATE_COUNT) == (1UL << STATE_COUNT) - 1,
+              "Every state must be reachable from Startup");
+
+// 每个状态在表中的起始行，rowsFor 为 O(1) / First row of each state, so rowsFor is O(1)
+static constexpr size_t firstRow(uint8_t state, size_t i)
+{
+    return (i >= ROW_COUNT || (uint8_t)TABLE[i].from >= state) ? i : firstRow(state, i + 1);
+}
+
+static constexpr size_t ROW_BEGIN[] = {
+    firstRow(0, 0), firstRow(1, 0), firstRow(2, 0), firstRow(3, 0), firstRow(4, 0),
+    firstRow(5, 0), firstRow(6, 0), firstRow(7, 0), firstRow(8, 0), firstRow(9, 0),
+    firstRow(10, 0), firstRow(11, 0), firstRow(12, 0), firstRow(13, 0), firstRow(14, 0),
+};
+
+static_assert(sizeof(ROW_BEGIN) / sizeof(ROW_BEGIN[0]) == STATE_COUNT + 1, "ROW_BEGIN needs one entry per state plus the end");
+
+// ========== 屏幕切换 / Screen transitions ==========
+//
+// 任务流程按空间导航：前进向左推，返回向右推，详情页从右侧滑入。帧动画（如长按取消）开始时切换让位。
+// The task flow navigates spatially: forward pushes left, back pushes right, the detail page slides in
+// from the right. A frame animation (e.g. the long-press cancel) takes precedence over the transition.
+
+struct ScreenRow
+{
+    StateId from;
+    StateId to;
+    ScreenTransition type;
+};
+
+#define SCREEN(from, to, type) \
+    {StateId::from, StateId::to, ScreenTransition::type}
+
+static constexpr ScreenRow SCREEN_TABLE[] = {
+    SCREEN(TaskList, DurationSelect, PushLeft),
+    SCREEN(DurationSelect, Timer, PushLeft),
+    SCREEN(DurationSelect, TaskList, PushRight),
+    SCREEN(DurationSelect, TaskDetail, SlideLeft),
+    SCREEN(TaskDetail, DurationSelect, SlideRight),
+    SCREEN(TaskDetail, TaskList, PushRight),
+};
+
+#undef SCREEN
+
+static const char *const STATE_NAMES[] = {
+    "Startup", "Provision", "Idle", "Adjust", "Reset", "Sleep", "Timer",
+    "Paused", "Done", "TaskListView", "TaskCompletePrompt", "TaskList", "DurationSelect", "TaskDetail",
+};
+
+static const char *const TRIGGER_NAMES[] = {
+    "Press", "DoublePress", "LongPress", "Rotate", "HoldRotate", "Timeout", "Done",
+};
+
+static_assert(sizeof(STATE_NAMES) / sizeof(STATE_NAMES[0]) == STATE_COUNT, "STATE_NAMES out of sync with StateId");
+static_assert(sizeof(TRIGGER_NAMES) / sizeof(TRIGGER_NAMES[0]) == (size_t)Trigger::Count, "TRIGGER_NAMES out of sync with Trigger");
+
+// ========== 查询 / Lookup ==========
+
+namespace Transitions
+{
+    const Transition *rowsFor(StateId from, size_t &count)
+    {
+        const uint8_t index = (uint8_t)from;
+        if (index >= STATE_COUNT)
+        {
+            count = 0;
+            return nullptr;
+        }
+        count = ROW_BEGIN[index + 1] - ROW_BEGIN[index];
+        return TABLE + ROW_BEGIN[index];
+    }
+
+    const Transition *all(size_t &count)
+    {
+        count = ROW_COUNT;
+        return TABLE;
+    }
+
+    ScreenTransition screenFor(StateId from, StateId to)
+    {
+        for (const ScreenRow &row : SCREEN_TABLE)
+        {
+            if (row.from == from && row.to == to)
+            {
+                return row.type;
+            }
+        }
+        return ScreenTransition::None;
+    }
+
+    const char *stateName(StateId id)
+    {
+        return (uint8_t)id < STATE_COUNT ? STATE_NAMES[(uint8_t)id] : "?";
+    }
+
+    const char *triggerName(Trigger trigger)
+    {
+        return (uint8_t)trigger < (uint8_t)Trigger::Count ? TRIGGER_NAMES[(uint8_t)trigger] : "?";
+    }
+}
@@ -1,114 +1,265 @@
 #include "UIAnimation.h"
-#include <cmath>
 
 // ============================================================
-// AnimatedValue Implementation
+// AnimationPool Implementation
 // ============================================================
 
-AnimatedValue::AnimatedValue(float initialValue)
-    : current_(initialValue),
-      target_(initialValue),
-      speed_(1.0f),
-      threshold_(0.5f),
-      easing_(EasingType::UNLINEAR),
-      integral_(0.0f),
-      lastError_(0.0f)
-{
+// Gains in Q16.16 (0.08, 0.02, 0.005 of the OLED_UI float version)
+static const q16_t K_EASE = 5243;
+static const q16_t K_INTEGRAL = 1311;
+static const q16_t K_DERIVATIVE = 328;
+static const q16_t PID_INTEGRAL_LIMIT = 50 * Q16_ONE;
+
+static inline q16_t qmul(q16_t a, q16_t b) {
+    return (q16_t)(((int64_t)a * b) >> 16);
 }
 
-void AnimatedValue::setTarget(float target) {
-    target_ = target;
+static inline q16_t qdiv(q16_t a, q16_t b) {
+    return (q16_t)(((int64_t)a << 16) / b);
 }
 
-void AnimatedValue::snapTo(float value) {
-    current_ = value;
-    target_ = value;
-    integral_ = 0.0f;
-    lastError_ = 0.0f;
+static inline q16_t qabs(q16_t a) {
+    return a < 0 ? -a : a;
 }
 
-void AnimatedValue::update(unsigned long deltaMs) {
-    if (!isAnimating()) return;
+AnimationPool& AnimationPool::shared() {
+    static AnimationPool pool;
+    return pool;
+}
 
-    float error = target_ - current_;
+AnimationPool::AnimationPool()
+    : activeCount_(0),
+      used_(0)
+{
+    memset(activePos_, INVALID, sizeof(activePos_));
+}
 
-    // When close to target, snap to it (avoid infinite approach)
-    if (fabs(error) < threshold_) {
-        current_ = target_;
-        integral_ = 0.0f;
-        lastError_ = 0.0f;
-        return;
+AnimationPool::Slot AnimationPool::acquire(q16_t initialValue) {
+    for (Slot slot = 0; slot < CAPACITY; slot++) {
+        if (!(used_ & (1UL << slot))) {
+            used_ |= 1UL << slot;
+            current_[slot] = initialValue;
+            target_[slot] = initialValue;
+            integral_[slot] = 0;
+            lastError_[slot] = 0;
+            activePos_[slot] = INVALID;
+            configure(slot, Q16_ONE, Q16_ONE / 2, EasingType::UNLINEAR);
+            return slot;
+        }
     }
+    return INVALID;
+}
 
-    // Time factor (normalized to ~16ms baseline for 60fps)
-    float timeFactor = deltaMs / 16.0f;
-    if (timeFactor < 0.1f) timeFactor = 0.1f;  // Prevent division issues
-    if (timeFactor > 4.0f) timeFactor = 4.0f;  // Cap for stability
+void AnimationPool::release(Slot slot) {
+    if (slot >= CAPACITY) return;
+    deactivate(slot);
+    used_ &= ~(1UL << slot);
+}
 
-    switch (easing_) {
-        case EasingType::UNLINEAR: {
-            // OLED_UI style non-linear easing
-            // CurrentNum += 0.02f * Speed * Error
-            // Using higher coefficient for faster response (~150ms)
-            float delta = 0.08f * speed_ * error * timeFactor;
-            current_ += delta;
+void AnimationPool::configure(Slot slot, q16_t speed, q16_t threshold, EasingType easing) {
+    speed_[slot] = speed;
+    threshold_[slot] = threshold;
+    easing_[slot] = (uint8_t)easing;
+
+    // Derive the per-frame coefficients once, not per update
+    switch (easing) {
+        case EasingType::UNLINEAR:
+        case EasingType::PID:
+            gain_[slot] = qmul(K_EASE, speed);
             break;
+        case EasingType::LINEAR:
+            gain_[slot] = speed * 4;
+            break;
+    }
+    ki_[slot] = qmul(K_INTEGRAL, speed);
+    maxIntegral_[slot] = ki_[slot] > 0 && ((int64_t)PID_INTEGRAL_LIMIT << 16) / ki_[slot] < INT32_MAX
+                             ? qdiv(PID_INTEGRAL_LIMIT, ki_[slot])
+                             : INT32_MAX;
+}
+
+void AnimationPool::setTarget(Slot slot, q16_t target) {
+    target_[slot] = target;
+    if (qabs(target - current_[slot]) >= threshold_[slot]) {
+        activate(slot);
+    } else {
+        // Already within threshold: land on it without animating
+        current_[slot] = target;
+        deactivate(slot);
+    }
+}
+
+void AnimationPool::snapTo(Slot slot, q16_t value) {
+    current_[slot] = value;
+    target_[slot] = value;
+    integral_[slot] = 0;
+    lastError_[slot] = 0;
+    deactivate(slot);
+}
+
+void AnimationPool::activate(Slot slot) {
+    if (activePos_[slot] != INVALID) return;
+    activePos_[slot] = activeCount_;
+    active_[activeCount_++] = slot;
+}
+
+void AnimationPool::deactivate(Slot slot) {
+    const Slot pos = activePos_[slot];
+    if (pos == INVALID) return;
+
+    // Swap-remove keeps the active list dense
+    const Slot last = active_[--activeCount_];
+    active_[pos] = last;
+    activePos_[last] = pos;
+    activePos_[slot] = INVALID;
+}
+
+q16_t AnimationPool::timeFactor(unsigned long deltaMs) {
+    // Normalized to a 16 ms (60 fps) frame, clamped to 0.1..4.0 for stability
+    if (deltaMs >= 64) return 4 * Q16_ONE;
+    const q16_t factor = (q16_t)(deltaMs << 12);
+    return factor < Q16_ONE / 10 ? Q16_ONE / 10 : factor;
+}
+
+void AnimationPool::update(unsigned long deltaMs) {
+    if (activeCount_ == 0) return;
+
+    const q16_t factor = timeFactor(deltaMs);
+    for (uint8_t i = 0; i < activeCount_;) {
+        const Slot slot = active_[i];
+        if (step(slot, factor)) {
+            i++;
+        } else {
+            deactivate(slot);  // Swaps another slot into position i
         }
+    }
+}
 
-        case EasingType::PID: {
-            // PID controller for smoother motion
-            float Kp = 0.08f * speed_;
-            float Ki = 0.02f * speed_;
-            float Kd = 0.005f;
+void AnimationPool::updateOne(Slot slot, unsigned long deltaMs) {
+    if (slot >= CAPACITY || activePos_[slot] == INVALID) return;
+    if (!step(slot, timeFactor(deltaMs))) {
+        deactivate(slot);
+    }
+}
 
-            integral_ += error * timeFactor;
-            // Integral windup prevention
-            float maxIntegral = 50.0f / Ki;
-            integral_ = constrain(integral_, -maxIntegral, maxIntegral);
+bool AnimationPool::step(Slot slot, q16_t factor) {
+    q16_t current = current_[slot];
+    const q16_t target = target_[slot];
+    const q16_t error = target - current;
 
-            float derivative = (error - lastError_) / timeFactor;
-            lastError_ = error;
+    switch ((EasingType)easing_[slot]) {
+        case EasingType::UNLINEAR: {
+            // OLED_UI style: current += 0.08 * speed * error * timeFactor
+            q16_t delta = qmul(qmul(gain_[slot], error), factor);
+            if (delta == 0) delta = error > 0 ? 1 : -1;  // Never stall short of the target
+            current += delta;
+            break;
+        }
 
-            float output = Kp * error + Ki * integral_ + Kd * derivative;
-            current_ += output * timeFactor;
+        case EasingType::PID: {
+            int64_t integral = (int64_t)integral_[slot] + qmul(error, factor);
+            const q16_t limit = maxIntegral_[slot];
+            if (integral > limit) integral = limit;
+            if (integral < -limit) integral = -limit;
+            integral_[slot] = (q16_t)integral;
+
+            const q16_t derivative = qdiv(error - lastError_[slot], factor);
+            lastError_[slot] = error;
+
+            const q16_t output = qmul(gain_[slot], error) + qmul(ki_[slot], integral_[slot]) + qmul(K_DERIVATIVE, derivative);
+            q16_t delta = qmul(output, factor);
+            if (delta == 0) delta = error > 0 ? 1 : -1;
+            current += delta;
             break;
         }
 
         case EasingType::LINEAR: {
-            // Linear interpolation
-            float maxDelta = speed_ * 4.0f * timeFactor;
-            if (fabs(error) <= maxDelta) {
-                current_ = target_;
+            const q16_t maxDelta = qmul(gain_[slot], factor);
+            if (qabs(error) <= maxDelta) {
+                current = target;
             } else {
-                current_ += (error > 0 ? maxDelta : -maxDelta);
+                current += (error > 0 ? maxDelta : -maxDelta);
             }
             break;
         }
     }
+
+    // Settled: land exactly on the target and leave the active set
+    if (qabs(target - current) < threshold_[slot]) {
+        current_[slot] = target;
+        integral_[slot] = 0;
+        lastError_[slot] = 0;
+        return false;
+    }
+    current_[slot] = current;
+    return true;
+}
+
+// ============================================================
+// AnimatedValue Implementation
+// ============================================================
+
+AnimatedValue::AnimatedValue(float initialValue)
+    : slot_(AnimationPool::shared().acquire(toQ16(initialValue))),
+      fallback_(toQ16(initialValue))
+{
+}
+
+AnimatedValue::~AnimatedValue() {
+    AnimationPool::shared().release(slot_);
+}
+
+void AnimatedValue::setTarget(float target) {
+    if (slot_ == AnimationPool::INVALID) {
+        fallback_ = toQ16(target);
+        return;
+    }
+    AnimationPool::shared().setTarget(slot_, toQ16(target));
+}
+
+void AnimatedValue::snapTo(float value) {
+    if (slot_ == AnimationPool::INVALID) {
+        fallback_ = toQ16(value);
+        return;
+    }
+    AnimationPool::shared().snapTo(slot_, toQ16(value));
+}
+
+void AnimatedValue::update(unsigned long deltaMs) {
+    AnimationPool::shared().updateOne(slot_, deltaMs);
 }
 
 float AnimatedValue::getValue() const {
-    return current_;
+    return fromQ16(slot_ == AnimationPool::INVALID ? fallback_ : AnimationPool::shared().current(slot_));
+}
+
+int AnimatedValue::getPixel() const {
+    return roundQ16(slot_ == AnimationPool::INVALID ? fallback_ : AnimationPool::shared().current(slot_));
 }
 
 float AnimatedValue::getTarget() const {
-    return target_;
+    return fromQ16(slot_ == AnimationPool::INVALID ? fallback_ : AnimationPool::shared().target(slot_));
 }
 
 bool AnimatedValue::isAnimating() const {
-    return fabs(target_ - current_) >= threshold_;
+    return slot_ != AnimationPool::INVALID && AnimationPool::shared().isActive(slot_);
 }
 
 void AnimatedValue::setSpeed(float speed) {
-    speed_ = speed;
+    if (slot_ == AnimationPool::INVALID) return;
+    AnimationPool& pool = AnimationPool::shared();
+    pool.configure(slot_, toQ16(speed), pool.threshold(slot_), pool.easing(slot_));
 }
 
 void AnimatedValue::setEasing(EasingType easing) {
-    easing_ = easing;
+    if (slot_ == AnimationPool::INVALID) return;
+    AnimationPool& pool = AnimationPool::shared();
+    pool.configure(slot_, pool.speed(slot_), pool.threshold(slot_), easing);
 }
 
 void AnimatedValue::setThreshold(float threshold) {
-    threshold_ = threshold;
+    if (slot_ == AnimationPool::INVALID) return;
+    AnimationPool& pool = AnimationPool::shared();
+    pool.configure(slot_, pool.speed(slot_), toQ16(threshold), pool.easing(slot_));
 }
 
 // ============================================================
@@ -160,6 +311,160 @@ void AnimatedRect::setEasing(EasingType easing) {
     h.setEasing(easing);
 }
 
+// ============================================================
+// Timeline Implementation
+// ============================================================
+
+Timeline::Timeline()
+    : nodeCount_(0),
+      keyCount_(0),
+      startedAt_(0),
+      running_(false)
+{
+    clear();
+}
+
+void Timeline::clear() {
+    nodeCount_ = 0;
+    keyCount_ = 0;
+    running_ = false;
+    add(INVALID, PARALLEL);
+}
+
+Timeline::Node Timeline::add(Node parent, Kind kind) {
+    if (nodeCount_ >= MAX_NODES) return INVALID;
+    if (parent != INVALID && (parent >= nodeCount_ || nodes_[parent].kind == TRACK)) return INVALID;
+
+    const Node node = nodeCount_++;
+    NodeData& data = nodes_[node];
+    data.kind = kind;
+    data.firstChild = INVALID;
+    data.lastChild = INVALID;
+    data.nextSibling = INVALID;
+    data.firstKey = 0;
+    data.keyCount = 0;
+    data.curve = CurveType::LINEAR;
+    data.value = nullptr;
+    data.startMs = 0;
+    data.durationMs = 0;
+
+    // Append so children play in the order they were added
+    if (parent != INVALID) {
+        NodeData& p = nodes_[parent];
+        if (p.lastChild == INVALID) {
+            p.firstChild = node;
+        } else {
+            nodes_[p.lastChild].nextSibling = node;
+        }
+        p.lastChild = node;
+    }
+    return node;
+}
+
+Timeline::Node Timeline::sequence(Node parent) {
+    return add(parent, SEQUENCE);
+}
+
+Timeline::Node Timeline::parallel(Node parent) {
+    return add(parent, PARALLEL);
+}
+
+Timeline::Node Timeline::track(Node parent, AnimatedValue& value, const Keyframe* keys, uint8_t count, CurveType curve) {
+    if (count == 0 || keyCount_ + count > MAX_KEYFRAMES) return INVALID;
+
+    const Node node = add(parent, TRACK);
+    if (node == INVALID) return INVALID;
+
+    NodeData& data = nodes_[node];
+    data.value = &value;
+    data.curve = curve;
+    data.firstKey = keyCount_;
+    data.keyCount = count;
+    for (uint8_t i = 0; i < count; i++) {
+        keyAt_[keyCount_] = keys[i].atMs;
+        keyValue_[keyCount_] = toQ16(keys[i].value);
+        keyCount_++;
+    }
+    data.durationMs = keys[count - 1].atMs;
+    return node;
+}
+
+uint32_t Timeline::layout(Node node, uint32_t startMs) {
+    NodeData& data = nodes_[node];
+    data.startMs = startMs;
+    if (data.kind == TRACK) return data.durationMs;
+
+    uint32_t duration = 0;
+    for (Node child = data.firstChild; child != INVALID; child = nodes_[child].nextSibling) {
+        if (data.kind == SEQUENCE) {
+            duration += layout(child, startMs + duration);
+        } else {
+            const uint32_t childDuration = layout(child, startMs);
+            if (childDuration > duration) duration = childDuration;
+        }
+    }
+    data.durationMs = duration;
+    return duration;
+}
+
+void Timeline::start(int64_t nowMs) {
+    layout(ROOT, 0);
+    startedAt_ = nowMs;
+    running_ = true;
+    update(nowMs);
+}
+
+bool Timeline::update(int64_t nowMs) {
+    if (!running_) return false;
+
+    const uint32_t elapsed = (uint32_t)(nowMs - startedAt_);
+    for (Node node = 0; node < nodeCount_; node++) {
+        const NodeData& data = nodes_[node];
+        // Tracks that have not started yet keep their current value
+        if (data.kind == TRACK && elapsed >= data.startMs) {
+            apply(data, elapsed - data.startMs);
+        }
+    }
+
+    if (elapsed >= nodes_[ROOT].durationMs) {
+        running_ = false;
+    }
+    return running_;
+}
+
+void Timeline::apply(const NodeData& track, uint32_t elapsedMs) {
+    const uint8_t first = track.firstKey;
+    const uint8_t last = track.firstKey + track.keyCount - 1;
+
+    q16_t value;
+    if (elapsedMs <= keyAt_[first]) {
+        value = keyValue_[first];
+    } else if (elapsedMs >= keyAt_[last]) {
+        value = keyValue_[last];
+    } else {
+        uint8_t k = first;
+        while (keyAt_[k + 1] <= elapsedMs) k++;
+
+        const uint32_t span = keyAt_[k + 1] - keyAt_[k];
+        const q16_t t = curve(track.curve, (q16_t)(((uint32_t)(elapsedMs - keyAt_[k]) << 16) / span));
+        value = keyValue_[k] + qmul(keyValue_[k + 1] - keyValue_[k], t);
+    }
+    track.value->snapTo(fromQ16(value));
+}
+
+q16_t Timeline::curve(CurveType type, q16_t t) {
+    switch (type) {
+        case CurveType::EASE_OUT: {
+            const q16_t inv = Q16_ONE - t;
+            return Q16_ONE - qmul(inv, inv);
+        }
+        case CurveType::EASE_IN_OUT:
+            return qmul(qmul(t, t), 3 * Q16_ONE - 2 * t);
+        default:
+            return t;
+    }
+}
+
 // ============================================================
 // TaskListAnimationState Implementation
 // ============================================================
@@ -197,10 +502,8 @@ TaskListAnimationState::TaskListAnimationState()
 }
 
 void TaskListAnimationState::updateAll(unsigned long deltaMs) {
-    cursorY.update(deltaMs);
-    scrollOffset.update(deltaMs);
-    segmentHighlightX.update(deltaMs);
-    scrollbarY.update(deltaMs);
+    // One batched pass over every moving value; settled ones cost nothing
+    AnimationPool::shared().update(deltaMs);
 }
 
 bool TaskListAnimationState::isAnyAnimating() const {
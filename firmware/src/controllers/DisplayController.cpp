@@ -1,4 +1,7 @@
 #include "controllers/DisplayController.h"
+#include "Config.h"
+#include "EventQueue.h"
+#include "PageRaster.h"
 
 #include "fonts/Picopixel.h"
 #include "fonts/Org_01.h"
@@ -50,12 +53,14 @@ static void drawTaskListScrollBar(Adafruit_SSD1306& oled, int x, int y, int w, i
         return;
     }
 
+    PageRaster raster(oled.getBuffer(), oled.width(), oled.height());
+
     // 轨道
     oled.drawRoundRect(x, y, w, h, 2, 1);
 
     if (total <= visible) {
         // 不需要滚动，滚动块占满
-        oled.fillRoundRect(x + 1, y + 1, w - 2, h - 2, 1, 1);
+        raster.fillRoundRect(x + 1, y + 1, w - 2, h - 2, 1, 1);
         return;
     }
 
@@ -73,14 +78,32 @@ static void drawTaskListScrollBar(Adafruit_SSD1306& oled, int x, int y, int w, i
         knobY = innerY + (travel * displayOffset) / maxOffset;
     }
 
-    oled.fillRoundRect(x + 1, knobY, w - 2, knobH, 1, 1);
+    raster.fillRoundRect(x + 1, knobY, w - 2, knobH, 1, 1);
+}
+
+// 排序视图标签（Picopixel，显示在底栏右侧）/ Sort view label shown in the footer
+static const char* sortModeLabel(TaskSortMode mode) {
+    switch (mode) {
+        case TaskSortMode::Priority: return "PRI";
+        case TaskSortMode::Due: return "DUE";
+        case TaskSortMode::Spent: return "TIME";
+        default: return "";
+    }
 }
 
 DisplayController::DisplayController(uint8_t oledWidth, uint8_t oledHeight, uint8_t oledAddress)
-    : oled(oledWidth, oledHeight, &Wire, -1), animation(&oled) {}
+    : oled(oledWidth, oledHeight, &Wire, -1), animation(&oled), animationTask(Scheduler::INVALID),
+      frameBytes(0), i2cAddress(oledAddress), bus(Wire, oledAddress), bootFlushUs(0),
+      shownFrame(nullptr), shownValid(false), staging(nullptr),
+      digitFirstPage(0), digitPages(0), chromeCache(nullptr), chromeValid(0),
+      transitionType(ScreenTransition::None), transitionOffset(0.0f), transitionTask(Scheduler::INVALID),
+      transitionFrom(nullptr), transitionTo(nullptr), transitionToValid(false) {}
 
 void DisplayController::begin() {
-    if (!oled.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    // 整帧一次传输，须在 Adafruit 启动 Wire 之前 / One transfer per frame; must precede Adafruit starting Wire
+    bus.reserve((size_t)oled.width() * ((oled.height() + 7) / 8));
+
+    if (!oled.begin(SSD1306_SWITCHCAPVCC, i2cAddress)) {
         Serial.println(F("SSD1306 allocation failed"));
         for (;;);  // Loop forever if initialization fails
     }
@@ -95,22 +118,42 @@ void DisplayController::begin() {
     // oled.ssd1306_command(SSD1306_SETCONTRAST);
     // oled.ssd1306_command(128);
     
+    bus.begin(OLED_I2C_HZ);
+
+    animationTask = scheduler.add("display-anim", onAnimationFrame, this);
+    transitionTask = scheduler.add("display-transition", onTransitionFrame, this);
+
+    frameBytes = (size_t)oled.width() * ((oled.height() + 7) / 8);
+    transitionFrom = new uint8_t[frameBytes];
+    transitionTo = new uint8_t[frameBytes];
+    chromeCache = new uint8_t[frameBytes * CHROME_LAYER_COUNT];
+    shownFrame = new uint8_t[frameBytes];
+    staging = new uint8_t[frameBytes];
+    buildDigitAtlas();
+
+    // 清屏同时实测整帧刷新耗时 / Clear the panel and measure a full-frame flush
     oled.clearDisplay();
-    oled.display();
+    const uint32_t transfersBefore = bus.transactions();
+    const uint32_t flushStart = micros();
+    flush();
+    bootFlushUs = micros() - flushStart;
+    Serial.printf("DisplayController: %u B frame flushed in %lu us at %lu kHz, %lu transfers, %lu errors / 整帧刷新耗时\n",
+                  (unsigned)frameBytes, (unsigned long)bootFlushUs, (unsigned long)(bus.clockHz() / 1000),
+                  (unsigned long)(bus.transactions() - transfersBefore), (unsigned long)bus.errors());
     Serial.println("DisplayController initialized.");
 }
 
 void DisplayController::drawSplashScreen() {
     oled.clearDisplay();
 
-    oled.drawBitmap(16, 3, focusdial_logo, 99, 45, 1);
+    raster().drawBitmap(16, 3, focusdial_logo, 99, 45, 1);
     oled.setTextColor(1);
     oled.setTextSize(1);
     oled.setFont(&Picopixel);
     oled.setCursor(21, 60);
     oled.print("YOUTUBE/ @SALIMBENBOUZ");
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawIdleScreen(int duration, bool wifi) {
@@ -127,23 +170,18 @@ void DisplayController::drawIdleScreen(int duration, bool wifi) {
         lastBlinkTime = currentTime;
     }
 
-    oled.clearDisplay();
+    beginFrame(ChromeIdle);
 
-    // "PRESS TO START"
+    // Display WiFi icon based on WiFi state
     oled.setFont(&Picopixel);
     oled.setTextSize(1);
     oled.setTextColor(1);
-    oled.setCursor(40, 58);
-    oled.print("PRESS TO START");
-    oled.drawRoundRect(35, 51, 60, 11, 1, 1);
-
-    // Display WiFi icon based on WiFi state
     if (wifi) {
-        oled.drawBitmap(70, 3, icon_wifi_on, 5, 5, 1);
+        raster().drawBitmap(70, 3, icon_wifi_on, 5, 5, 1);
         oled.setCursor(54, 7);
         oled.print("WIFI");
     } else if (blinkState) {
-        oled.drawBitmap(70, 3, icon_wifi_off, 5, 5, 1);
+        raster().drawBitmap(70, 3, icon_wifi_off, 5, 5, 1);
         oled.setCursor(54, 7);
         oled.print("WIFI");
     }
@@ -170,26 +208,16 @@ void DisplayController::drawIdleScreen(int duration, bool wifi) {
         xRight += 20;
     }
 
-    oled.setTextColor(1);
-    oled.setTextSize(5);
-    oled.setFont(&Org_01);
-    oled.setCursor(xLeft, 36);
-    oled.print(left);
-
-    oled.setCursor(xRight, 36);
-    oled.print(right);
-
-    // Separator dots
-    oled.fillRect(62, 21, 5, 5, 1);
-    oled.fillRect(62, 31, 5, 5, 1);
+    drawBigNumber(left, xLeft);
+    drawBigNumber(right, xRight);
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawTimerScreen(int remainingSeconds) {
     if (isAnimationRunning()) return; 
 
-    oled.clearDisplay();
+    beginFrame(ChromeTimer);
 
     if (remainingSeconds < 0) {
         remainingSeconds = 0;
@@ -221,19 +249,13 @@ void DisplayController::drawTimerScreen(int remainingSeconds) {
     }
 
     // Draw the left value (hours or minutes)
-    oled.setTextColor(1);
-    oled.setTextSize(5);
-    oled.setFont(&Org_01);
-    oled.setCursor(xLeft, 36);
-    oled.print(left);
+    drawBigNumber(left, xLeft);
 
     // Draw the right value (minutes or seconds)
-    oled.setCursor(xRight, 36);
-    oled.print(right);
+    drawBigNumber(right, xRight);
 
-    // Separator dots
-    oled.fillRect(62, 31, 5, 5, 1);
-    oled.fillRect(62, 21, 5, 5, 1);
+    oled.setTextColor(1);
+    oled.setFont(&Org_01);
 
     sprintf(secondsStr, "%02d", seconds);
 
@@ -246,21 +268,20 @@ void DisplayController::drawTimerScreen(int remainingSeconds) {
     oled.setCursor(xSeconds, 58);
     oled.print(secondsStr);
 
-    // Draw icons and labels
-    oled.drawBitmap(61, 3, icon_star, 7, 7, 1);
+    // Unit labels follow the h:m / m:s split
     oled.setTextSize(1);
     oled.setCursor(27, 54);
     oled.print(hours > 0 ? "H" : "M");
     oled.setCursor(98, 54);
     oled.print(hours > 0 ? "M" : "S");
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawPausedScreen(int remainingSeconds) {
     if (isAnimationRunning()) return; 
 
-    oled.clearDisplay();
+    beginFrame(ChromePaused);
 
     if (remainingSeconds < 0) {
         remainingSeconds = 0;
@@ -292,16 +313,11 @@ void DisplayController::drawPausedScreen(int remainingSeconds) {
     }
 
     if ((millis() / 400) % 2 == 0) {
-        oled.setTextColor(1);
-        oled.setTextSize(5);
-        oled.setFont(&Org_01);
-        oled.setCursor(xLeft, 36);
-        oled.print(left);
-        oled.setCursor(xRight, 36);
-        oled.print(right);
+        drawBigNumber(left, xLeft);
+        drawBigNumber(right, xRight);
 
-        oled.fillRect(62, 31, 5, 5, 1);
-        oled.fillRect(62, 22, 5, 5, 1);
+        raster().fillRect(62, 31, 5, 5, 1);
+        raster().fillRect(62, 22, 5, 5, 1);
 
         oled.setFont(&Org_01);
         oled.setTextSize(1);
@@ -311,16 +327,7 @@ void DisplayController::drawPausedScreen(int remainingSeconds) {
         oled.print(hours > 0 ? "M" : "S");
     }
 
-    // Draw label and icon
-    oled.drawRoundRect(47, 51, 35, 11, 1, 1);
-    oled.setTextColor(1);
-    oled.setTextSize(1);
-    oled.setFont(&Picopixel);
-    oled.setCursor(53, 58);
-    oled.print("PAUSED");
-    oled.drawBitmap(60, 2, icon_pause, 9, 9, 1);
-
-    oled.display();
+    present();
 }
 
 void DisplayController::drawResetScreen(bool resetSelected) {
@@ -338,7 +345,7 @@ void DisplayController::drawResetScreen(bool resetSelected) {
     oled.print("ALL STORED SETTINGS WILL ");
     oled.setCursor(21, 40);
     oled.print("BE PERMANENTLY ERASED");
-    oled.drawBitmap(35, 4, icon_reset, 13, 16, 1);
+    raster().drawBitmap(35, 4, icon_reset, 13, 16, 1);
 
     // Change only the rectangle fill and text color based on selection
     const int boxY = 48;
@@ -349,7 +356,7 @@ void DisplayController::drawResetScreen(bool resetSelected) {
 
     if (resetSelected) {
         // "RESET" filled, "CANCEL" outlined
-        oled.fillRoundRect(resetX, boxY, boxW, boxH, 1, 1);
+        raster().fillRoundRect(resetX, boxY, boxW, boxH, 1, 1);
         oled.setTextColor(0);
         oled.setCursor(76, 56);
         oled.print("RESET");
@@ -360,7 +367,7 @@ void DisplayController::drawResetScreen(bool resetSelected) {
         oled.print("CANCEL");
     } else {
         // "CANCEL" filled, "RESET" outlined
-        oled.fillRoundRect(cancelX, boxY, boxW, boxH, 1, 1);
+        raster().fillRoundRect(cancelX, boxY, boxW, boxH, 1, 1);
         oled.setTextColor(0);
         oled.setCursor(31, 56);
         oled.print("CANCEL");
@@ -371,7 +378,7 @@ void DisplayController::drawResetScreen(bool resetSelected) {
         oled.print("RESET");
     }
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawDoneScreen() {
@@ -402,8 +409,8 @@ void DisplayController::drawDoneScreen() {
         oled.setCursor(85, 32);
         oled.print("00");
         // 分隔点居中
-        oled.fillRect(64, 17, 5, 5, 1);
-        oled.fillRect(64, 27, 5, 5, 1);
+        raster().fillRect(64, 17, 5, 5, 1);
+        raster().fillRect(64, 27, 5, 5, 1);
     }
 
     // "DONE" 标签居中显示
@@ -413,7 +420,7 @@ void DisplayController::drawDoneScreen() {
     const int boxX = (128 - boxW) / 2;  // 44
     const int boxY = 46;
 
-    oled.fillRoundRect(boxX, boxY, boxW, boxH, 2, 1);
+    raster().fillRoundRect(boxX, boxY, boxW, boxH, 2, 1);
 
     // 使用中文字体显示"完成"
     u8g2Fonts.setFont(u8g2_font_wqy12_t_gb2312);
@@ -425,16 +432,16 @@ void DisplayController::drawDoneScreen() {
     u8g2Fonts.print("完成");
 
     // 顶部星星图标居中
-    oled.drawBitmap(60, 3, icon_star, 7, 7, 1);
+    raster().drawBitmap(60, 3, icon_star, 7, 7, 1);
 
-    oled.display();
+    present();
 }
 
 
 void DisplayController::drawAdjustScreen(int duration) {
     if (isAnimationRunning()) return; 
 
-    oled.clearDisplay();
+    beginFrame(ChromeAdjust);
 
     oled.setTextColor(1);
     oled.setTextSize(4);
@@ -470,27 +477,313 @@ void DisplayController::drawAdjustScreen(int duration) {
     oled.setCursor(xMinute, 37);
     oled.print(minuteStr);
 
-    // Display labels
-    // Display labels
-    oled.setTextSize(1);
-    oled.setCursor(26, 55);
-    oled.print("HRS");
-    oled.setCursor(86, 55);
-    oled.print("MIN");
+    present();
+}
 
-    // Additional UI elements
-    oled.drawBitmap(0, 18, image_change_left, 7, 36, 1);
-    oled.drawRoundRect(36, 1, 57, 11, 1, 1);
-    oled.drawBitmap(121, 18, image_change_right, 7, 36, 1);
-    oled.setFont(&Picopixel);
-    oled.setCursor(41, 8);
-    oled.print("PRESS TO SAVE");
-    oled.drawBitmap(103, 3, icon_arrow_down, 5, 7, 1);
-    oled.drawBitmap(21, 3, icon_arrow_down, 5, 7, 1);
 
-    oled.display();
+void DisplayController::buildDigitAtlas() {
+    const GFXglyph* glyphs = Org_01.glyph;
+    const uint8_t width = oled.width();
+
+    // 所有数字共用的页范围 / Page range shared by all digits
+    int top = DIGIT_BASELINE;
+    int bottom = DIGIT_BASELINE;
+    for (uint8_t d = 0; d < 10; d++) {
+        const GFXglyph& g = glyphs['0' + d - Org_01.first];
+        const int glyphTop = DIGIT_BASELINE + g.yOffset * DIGIT_SCALE;
+        if (glyphTop < top) top = glyphTop;
+        if (glyphTop + g.height * DIGIT_SCALE > bottom) bottom = glyphTop + g.height * DIGIT_SCALE;
+    }
+    digitFirstPage = top / 8;
+    digitPages = (bottom - 1) / 8 - digitFirstPage + 1;
+    if (digitPages > DIGIT_MAX_PAGES) digitPages = DIGIT_MAX_PAGES;
+
+    oled.setTextColor(1);
+    oled.setTextSize(DIGIT_SCALE);
+    oled.setFont(&Org_01);
+    for (uint8_t d = 0; d < 10; d++) {
+        const GFXglyph& g = glyphs['0' + d - Org_01.first];
+        digitWidth[d] = std::min((uint8_t)(g.width * DIGIT_SCALE), (uint8_t)DIGIT_MAX_COLS);
+        digitAdvance[d] = g.xAdvance * DIGIT_SCALE;
+
+        oled.clearDisplay();
+        oled.setCursor(0, DIGIT_BASELINE);
+        oled.write('0' + d);
+
+        const uint8_t* buffer = oled.getBuffer();
+        for (uint8_t p = 0; p < digitPages; p++) {
+            memcpy(&digitAtlas[d][p * DIGIT_MAX_COLS], buffer + (digitFirstPage + p) * width, digitWidth[d]);
+        }
+    }
+    oled.clearDisplay();
+}
+
+void DisplayController::blitDigit(char c, int x) {
+    if (c < '0' || c > '9') return;
+    const uint8_t d = c - '0';
+    const int width = oled.width();
+
+    int first = 0;
+    int last = digitWidth[d];
+    if (x < 0) first = -x;
+    if (x + last > width) last = width - x;
+
+    uint8_t* buffer = oled.getBuffer();
+    for (uint8_t p = 0; p < digitPages; p++) {
+        uint8_t* dst = buffer + (digitFirstPage + p) * width + x;
+        const uint8_t* src = &digitAtlas[d][p * DIGIT_MAX_COLS];
+        for (int col = first; col < last; col++) {
+            dst[col] |= src[col];
+        }
+    }
+}
+
+void DisplayController::drawBigNumber(const char* text, int x) {
+    for (; *text; text++) {
+        blitDigit(*text, x);
+        if (*text >= '0' && *text <= '9') {
+            x += digitAdvance[*text - '0'];
+        }
+    }
+}
+
+void DisplayController::flush() {
+    const uint32_t errorsBefore = bus.errors();
+    bus.claim();
+    sendDirty();
+    if (bus.errors() == errorsBefore) {
+        return;
+    }
+
+    // 传输出错：屏上内容未知，下次整帧重发；超频时先退回 400 kHz 并立即重发
+    // Transfer errors: the panel content is unknown, so resend a full frame; above spec, drop to 400 kHz and resend now
+    shownValid = false;
+    if (bus.fallBack()) {
+        sendDirty();
+    }
+}
+
+void DisplayController::sendDirty() {
+    const uint8_t* buffer = oled.getBuffer();
+    const int width = oled.width();
+    const int pages = (oled.height() + 7) / 8;
+
+    if (!shownValid) {
+        bus.window(0, pages - 1, 0, width - 1);
+        bus.data(buffer, frameBytes);
+        memcpy(shownFrame, buffer, frameBytes);
+        shownValid = true;
+        return;
+    }
+
+    // 逐页找出变化的列段；相邻脏页合并为一个窗口比分开发送更省时则合并
+    // Find each page's changed column span; adjacent dirty pages share a window when that beats separate transfers
+    int groupStart = -1;
+    int gx0 = 0;
+    int gx1 = 0;
+    int groupBytes = 0;
+    for (int page = 0; page <= pages; page++) {
+        int x0 = width;
+        int x1 = -1;
+        if (page < pages) {
+            const uint8_t* now = buffer + page * width;
+            const uint8_t* shown = shownFrame + page * width;
+            x0 = 0;
+            while (x0 < width && now[x0] == shown[x0]) x0++;
+            if (x0 < width) {
+                x1 = width - 1;
+                while (now[x1] == shown[x1]) x1--;
+            }
+        }
+        const bool dirty = x1 >= 0;
+
+        if (dirty && groupStart >= 0) {
+            const int ux0 = std::min(gx0, x0);
+            const int ux1 = std::max(gx1, x1);
+            const int merged = (ux1 - ux0 + 1) * (page - groupStart + 1);
+            const int separate = groupBytes + (x1 - x0 + 1) + WINDOW_COST_BYTES;
+            if (merged <= separate) {
+                gx0 = ux0;
+                gx1 = ux1;
+                groupBytes = merged;
+                continue;
+            }
+        }
+
+        if (groupStart >= 0) {
+            sendWindow(groupStart, page - 1, gx0, gx1);
+            groupStart = -1;
+        }
+        if (dirty) {
+            groupStart = page;
+            gx0 = x0;
+            gx1 = x1;
+            groupBytes = x1 - x0 + 1;
+        }
+    }
 }
 
+void DisplayController::sendWindow(uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1) {
+    const uint8_t* buffer = oled.getBuffer();
+    const int width = oled.width();
+    const int columns = x1 - x0 + 1;
+
+    // 窗口内数据按页连续：整行宽度时帧缓冲本身就是连续的，否则先拼到 staging
+    // Window data runs page by page: contiguous in the frame buffer at full width, else gathered into staging
+    const uint8_t* data = buffer + page0 * width + x0;
+    if (columns != width && page1 != page0) {
+        uint8_t* out = staging;
+        for (int page = page0; page <= page1; page++) {
+            memcpy(out, buffer + page * width + x0, columns);
+            out += columns;
+        }
+        data = staging;
+    }
+
+    bus.window(page0, page1, x0, x1);
+    bus.data(data, (size_t)columns * (page1 - page0 + 1));
+
+    for (int page = page0; page <= page1; page++) {
+        memcpy(shownFrame + page * width + x0, buffer + page * width + x0, columns);
+    }
+}
+
+void DisplayController::writeStatus(JsonObject out) {
+    out["i2c_khz"] = bus.clockHz() / 1000;
+    out["i2c_transfers"] = bus.transactions();
+    out["i2c_errors"] = bus.errors();
+    out["boot_flush_us"] = bootFlushUs;
+}
+
+void DisplayController::benchmarkRaster(Print& out) {
+    static const int ITERATIONS = 200;
+
+    struct Case {
+        const char* name;
+        void (*gfx)(Adafruit_SSD1306& oled);
+        void (*page)(PageRaster& raster);
+    };
+    static const Case CASES[] = {
+        {"fillRect 120x12 (row)",
+         [](Adafruit_SSD1306& o) { o.fillRect(0, 21, 120, 12, 1); },
+         [](PageRaster& r) { r.fillRect(0, 21, 120, 12, 1); }},
+        {"fillRoundRect 118x14 r3",
+         [](Adafruit_SSD1306& o) { o.fillRoundRect(4, 19, 118, 14, 3, 1); },
+         [](PageRaster& r) { r.fillRoundRect(4, 19, 118, 14, 3, 1); }},
+        {"invert 120x12",
+         [](Adafruit_SSD1306& o) { o.fillRect(0, 21, 120, 12, SSD1306_INVERSE); },
+         [](PageRaster& r) { r.invertRect(0, 21, 120, 12); }},
+        {"fillRoundRect 4x30 r1 (knob)",
+         [](Adafruit_SSD1306& o) { o.fillRoundRect(123, 13, 4, 30, 1, 1); },
+         [](PageRaster& r) { r.fillRoundRect(123, 13, 4, 30, 1, 1); }},
+        {"drawBitmap 99x45 (logo)",
+         [](Adafruit_SSD1306& o) { o.drawBitmap(16, 3, focusdial_logo, 99, 45, 1); },
+         [](PageRaster& r) { r.drawBitmap(16, 3, focusdial_logo, 99, 45, 1); }},
+    };
+
+    // 切换缓冲启动时空闲，借作对照帧 / The transition buffer is idle at boot; borrow it for the reference frame
+    uint8_t* reference = transitionTo;
+    PageRaster page = raster();
+
+    out.println("PageRaster benchmark (us per call) / 绘制原语基准：");
+    for (const Case& c : CASES) {
+        oled.clearDisplay();
+        const uint32_t gfxStart = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            c.gfx(oled);
+        }
+        const uint32_t gfxUs = micros() - gfxStart;
+        memcpy(reference, oled.getBuffer(), frameBytes);
+
+        oled.clearDisplay();
+        const uint32_t pageStart = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            c.page(page);
+        }
+        const uint32_t pageUs = micros() - pageStart;
+        const bool match = memcmp(reference, oled.getBuffer(), frameBytes) == 0;
+
+        out.printf("  %-30s gfx %7.2f  page %7.2f  x%.1f  %s\n", c.name,
+                   gfxUs / (float)ITERATIONS, pageUs / (float)ITERATIONS,
+                   pageUs > 0 ? gfxUs / (float)pageUs : 0.0f, match ? "match" : "MISMATCH");
+    }
+
+    oled.clearDisplay();
+    shownValid = false;
+    flush();
+}
+
+void DisplayController::beginFrame(ChromeLayer layer) {
+    uint8_t* cache = chromeCache + (size_t)layer * frameBytes;
+    const uint8_t bit = 1 << layer;
+
+    if (!(chromeValid & bit)) {
+        oled.clearDisplay();
+        drawChrome(layer);
+        memcpy(cache, oled.getBuffer(), frameBytes);
+        chromeValid |= bit;
+        return;
+    }
+    memcpy(oled.getBuffer(), cache, frameBytes);
+}
+
+// 各界面不随数据变化的部分，只在首次绘制时执行 / The parts of each screen that never change; runs on first draw only
+void DisplayController::drawChrome(ChromeLayer layer) {
+    oled.setTextColor(1);
+    oled.setTextSize(1);
+
+    switch (layer) {
+        case ChromeIdle:
+            // "PRESS TO START"
+            oled.setFont(&Picopixel);
+            oled.setCursor(40, 58);
+            oled.print("PRESS TO START");
+            oled.drawRoundRect(35, 51, 60, 11, 1, 1);
+
+            // Separator dots
+            raster().fillRect(62, 21, 5, 5, 1);
+            raster().fillRect(62, 31, 5, 5, 1);
+            break;
+
+        case ChromeTimer:
+            // Separator dots
+            raster().fillRect(62, 31, 5, 5, 1);
+            raster().fillRect(62, 21, 5, 5, 1);
+            raster().drawBitmap(61, 3, icon_star, 7, 7, 1);
+            break;
+
+        case ChromePaused:
+            // Draw label and icon
+            oled.drawRoundRect(47, 51, 35, 11, 1, 1);
+            oled.setFont(&Picopixel);
+            oled.setCursor(53, 58);
+            oled.print("PAUSED");
+            raster().drawBitmap(60, 2, icon_pause, 9, 9, 1);
+            break;
+
+        case ChromeAdjust:
+            // Display labels
+            oled.setFont(&Org_01);
+            oled.setCursor(26, 55);
+            oled.print("HRS");
+            oled.setCursor(86, 55);
+            oled.print("MIN");
+
+            // Additional UI elements
+            raster().drawBitmap(0, 18, image_change_left, 7, 36, 1);
+            oled.drawRoundRect(36, 1, 57, 11, 1, 1);
+            raster().drawBitmap(121, 18, image_change_right, 7, 36, 1);
+            oled.setFont(&Picopixel);
+            oled.setCursor(41, 8);
+            oled.print("PRESS TO SAVE");
+            raster().drawBitmap(103, 3, icon_arrow_down, 5, 7, 1);
+            raster().drawBitmap(21, 3, icon_arrow_down, 5, 7, 1);
+            break;
+
+        default:
+            break;
+    }
+}
 
 void DisplayController::drawProvisionScreen() {
     if (isAnimationRunning()) return;
@@ -507,12 +800,13 @@ void DisplayController::drawProvisionScreen() {
     u8g2Fonts.print("再连接设备热点");
     u8g2Fonts.setCursor(18, 62);
     u8g2Fonts.print("完成无线配网");
-    oled.drawBitmap(39, 4, provision_logo, 51, 23, 1);
+    raster().drawBitmap(39, 4, provision_logo, 51, 23, 1);
 
-    oled.display();
+    present();
 }
 
-void DisplayController::drawTaskListScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted) {
+void DisplayController::drawTaskListScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted,
+                                           const uint16_t* order, TaskSortMode sortMode, char jumpInitial) {
     if (isAnimationRunning()) return;
 
     oled.clearDisplay();
@@ -562,7 +856,7 @@ void DisplayController::drawTaskListScreen(const String& projectName, const std:
         u8g2Fonts.print(title);
         u8g2Fonts.setCursor(subX < 0 ? 0 : subX, 52);
         u8g2Fonts.print(sub);
-        oled.display();
+        present();
         return;
     }
 
@@ -584,12 +878,13 @@ void DisplayController::drawTaskListScreen(const String& projectName, const std:
 
     for (int i = 0; i < MAX_VISIBLE && (displayOffset + i) < (int)tasks.size(); i++) {
         int taskIndex = displayOffset + i;
+        const FocusTask& task = tasks[order ? order[taskIndex] : taskIndex];
         const bool isSelected = (taskIndex == selectedIndex);
         const int cardY = LIST_TOP + (i * (CARD_H + CARD_GAP));
         const int textY = cardY + TEXT_BASELINE_OFFSET;
 
         if (isSelected) {
-            oled.fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
+            raster().fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         } else {
             oled.drawRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         }
@@ -601,13 +896,13 @@ void DisplayController::drawTaskListScreen(const String& projectName, const std:
 
         // 任务名（UTF-8 安全截断）
         // 以 name 为主（支持中文），display_name 仅做兼容兜底
-        String name = tasks[taskIndex].name;
+        String name = task.name;
         if (name.isEmpty()) {
-            name = tasks[taskIndex].displayName;
+            name = task.displayName;
         }
 
         if (name.isEmpty()) {
-            String suffix = tasks[taskIndex].id;
+            String suffix = task.id;
             if (suffix.length() > 4) {
                 suffix = suffix.substring(suffix.length() - 4);
             }
@@ -625,25 +920,25 @@ void DisplayController::drawTaskListScreen(const String& projectName, const std:
         oled.setTextSize(1);
         oled.setTextColor(isSelected ? 0 : 1);
 
-        String dateStr = showingCompleted ? tasks[taskIndex].completedAt : tasks[taskIndex].dueMmdd;
+        String dateStr = showingCompleted ? task.completedAt : task.dueMmdd;
         if (dateStr.isEmpty()) {
             dateStr = "--.--";
         }
         char priorityChar = '-';
-        if (!tasks[taskIndex].priorityFlag.isEmpty()) {
-            priorityChar = tasks[taskIndex].priorityFlag[0];
+        if (!task.priorityFlag.isEmpty()) {
+            priorityChar = task.priorityFlag[0];
         } else {
-            const int p = tasks[taskIndex].priority;
+            const int p = task.priority;
             if (p >= 5) priorityChar = 'H';
             else if (p >= 3) priorityChar = 'M';
             else if (p >= 1) priorityChar = 'L';
         }
-        const char repeatChar = tasks[taskIndex].hasRepeat ? 'R' : '-';
-        const char reminderChar = tasks[taskIndex].hasReminder ? 'A' : '-';
+        const char repeatChar = task.hasRepeat ? 'R' : '-';
+        const char reminderChar = task.hasReminder ? 'A' : '-';
 
         char subBuf[10] = {0};
-        if (tasks[taskIndex].subtasksTotal > 0) {
-            snprintf(subBuf, sizeof(subBuf), "%d/%d", tasks[taskIndex].subtasksDone, tasks[taskIndex].subtasksTotal);
+        if (task.subtasksTotal > 0) {
+            snprintf(subBuf, sizeof(subBuf), "%d/%d", task.subtasksDone, task.subtasksTotal);
         }
 
         char rightLabel[24] = {0};
@@ -657,7 +952,7 @@ void DisplayController::drawTaskListScreen(const String& projectName, const std:
     }
 
     // ===== Footer（信息条）=====
-    const FocusTask& selectedTask = tasks[selectedIndex];
+    const FocusTask& selectedTask = tasks[order ? order[selectedIndex] : selectedIndex];
 
     char info[32] = {0};
     if (showingCompleted) {
@@ -675,20 +970,33 @@ void DisplayController::drawTaskListScreen(const String& projectName, const std:
     const int barY = 54;
     const int barW = 120;
     const int barH = 10;
-    oled.drawRoundRect(barX, barY, barW, barH, 3, 1);
+
+    // 跳转模式：反色信息条显示当前首字母 / Jump mode: inverted bar showing the current initial
+    if (jumpInitial != 0) {
+        raster().fillRoundRect(barX, barY, barW, barH, 3, 1);
+        snprintf(info, sizeof(info), "JUMP  < %c >", jumpInitial);
+    } else {
+        oled.drawRoundRect(barX, barY, barW, barH, 3, 1);
+    }
 
     oled.setFont(&Picopixel);
     oled.setTextSize(1);
-    oled.setTextColor(1);
+    oled.setTextColor(jumpInitial != 0 ? 0 : 1);
     oled.setCursor(barX + 6, 62);
     oled.print(info);
 
+    const char* sortLabel = sortModeLabel(sortMode);
+    if (sortLabel[0] != '\0') {
+        oled.setCursor(barX + barW - 6 - (int)strlen(sortLabel) * 4, 62);
+        oled.print(sortLabel);
+    }
+
     // ===== Scrollbar =====
     const int total = (int)tasks.size();
     const int visible = (total < MAX_VISIBLE) ? total : MAX_VISIBLE;
     drawTaskListScrollBar(oled, 123, 16, 4, 36, displayOffset, total, visible);
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawTaskCompletePromptScreen(const String& taskName, bool markDoneSelected, bool isCanceled) {
@@ -737,7 +1045,7 @@ void DisplayController::drawTaskCompletePromptScreen(const String& taskName, boo
     const int textY = boxY + 11;
 
     if (markDoneSelected) {
-        oled.fillRoundRect(yesX, boxY, boxW, boxH, 2, 1);
+        raster().fillRoundRect(yesX, boxY, boxW, boxH, 2, 1);
         oled.drawRoundRect(noX, boxY, boxW, boxH, 2, 1);
         u8g2Fonts.setFont(u8g2_font_wqy12_t_gb2312);
         u8g2Fonts.setFontMode(1);
@@ -751,7 +1059,7 @@ void DisplayController::drawTaskCompletePromptScreen(const String& taskName, boo
         u8g2Fonts.print("NO");
     } else {
         oled.drawRoundRect(yesX, boxY, boxW, boxH, 2, 1);
-        oled.fillRoundRect(noX, boxY, boxW, boxH, 2, 1);
+        raster().fillRoundRect(noX, boxY, boxW, boxH, 2, 1);
         u8g2Fonts.setFont(u8g2_font_wqy12_t_gb2312);
         u8g2Fonts.setFontMode(1);
         u8g2Fonts.setForegroundColor(1);
@@ -766,26 +1074,138 @@ void DisplayController::drawTaskCompletePromptScreen(const String& taskName, boo
         u8g2Fonts.setBackgroundColor(0);
     }
 
-    oled.display();
+    present();
 }
 
 void DisplayController::clear() {
     oled.clearDisplay();
-    oled.display();
+    present();
 }
 
 void DisplayController::showAnimation(const byte frames[][288], int frameCount, bool loop, bool reverse, unsigned long durationMs, int width, int height) {
+    // 帧动画直接刷屏，屏上内容不再等于影子帧 / The animation writes the panel directly, so the shadow no longer matches
+    shownValid = false;
+
+    // 帧动画直接画在屏上，切换让位 / Frame animations draw straight to the screen; the transition yields
+    if (isTransitionRunning()) {
+        scheduler.cancel(transitionTask);
+        transitionType = ScreenTransition::None;
+    }
     animation.start(&frames[0][0], frameCount, loop, reverse, durationMs, width, height); // Pass array as pointer
+    scheduler.every(animationTask, animation.getFrameDelay());
 }
 
-void DisplayController::updateAnimation() {
-    animation.update();
+void DisplayController::onAnimationFrame(void* arg) {
+    DisplayController* self = static_cast<DisplayController*>(arg);
+    self->animation.update();
+    if (!self->animation.isRunning()) {
+        // 动画结束：撤销帧任务，并唤醒状态重绘被动画挡住的界面 / Done: stop frames and let the state redraw its screen
+        scheduler.cancel(self->animationTask);
+        eventQueue.post(EventType::Animation);
+    }
 }
 
 bool DisplayController::isAnimationRunning() {
     return animation.isRunning();
 }
 
+void DisplayController::beginTransition(ScreenTransition type) {
+    // 帧动画优先（如长按取消）/ A frame animation (e.g. the long-press cancel) takes precedence
+    if (type == ScreenTransition::None || transitionFrom == nullptr || isAnimationRunning()) {
+        return;
+    }
+
+    // 连续切换时从当前拼合画面接着走 / Chained transitions continue from the composed frame on screen
+    memcpy(transitionFrom, oled.getBuffer(), frameBytes);
+    transitionToValid = false;
+    transitionType = type;
+
+    const Keyframe keys[] = {
+        {0, 0.0f},
+        {TRANSITION_MS, (float)oled.width()},
+    };
+    transitionTimeline.clear();
+    transitionTimeline.track(Timeline::ROOT, transitionOffset, keys, 2, CurveType::EASE_OUT);
+    transitionTimeline.start(Scheduler::nowMs());
+
+    scheduler.every(transitionTask, TRANSITION_FRAME_MS);
+}
+
+void DisplayController::onTransitionFrame(void* arg) {
+    DisplayController* self = static_cast<DisplayController*>(arg);
+    if (!self->transitionTimeline.update(Scheduler::nowMs())) {
+        self->finishTransition();
+        return;
+    }
+
+    // 新画面尚未绘制时保持旧画面 / Hold the old screen until the incoming one has been drawn
+    if (self->transitionToValid) {
+        self->composeTransition();
+        self->flush();
+    }
+}
+
+void DisplayController::finishTransition() {
+    scheduler.cancel(transitionTask);
+    transitionType = ScreenTransition::None;
+
+    if (transitionToValid) {
+        memcpy(oled.getBuffer(), transitionTo, frameBytes);
+        flush();
+    }
+}
+
+void DisplayController::composeTransition() {
+    const int width = oled.width();
+    const int pages = (oled.height() + 7) / 8;
+    int offset = transitionOffset.getPixel();
+    if (offset < 0) offset = 0;
+    if (offset > width) offset = width;
+
+    // 页格式下一个字节是一列 8 个像素，水平平移即整字节拷贝 / In page layout a byte is one 8-pixel column, so a horizontal shift is a byte copy
+    uint8_t* out = oled.getBuffer();
+    for (int page = 0; page < pages; page++) {
+        uint8_t* row = out + page * width;
+        const uint8_t* from = transitionFrom + page * width;
+        const uint8_t* to = transitionTo + page * width;
+
+        switch (transitionType) {
+            case ScreenTransition::PushLeft:
+                memcpy(row, from + offset, width - offset);
+                memcpy(row + width - offset, to, offset);
+                break;
+            case ScreenTransition::PushRight:
+                memcpy(row, to + width - offset, offset);
+                memcpy(row + offset, from, width - offset);
+                break;
+            case ScreenTransition::SlideLeft:
+                memcpy(row, from, width - offset);
+                memcpy(row + width - offset, to, offset);
+                break;
+            case ScreenTransition::SlideRight:
+                memcpy(row, to, offset);
+                memcpy(row + offset, from, width - offset);
+                break;
+            default:
+                memcpy(row, to, width);
+                break;
+        }
+    }
+}
+
+void DisplayController::present() {
+    if (!isTransitionRunning()) {
+        flush();
+        return;
+    }
+
+    // 切换中：这次绘制成为新画面，由当前偏移拼合后再刷新 / Mid-transition: this draw becomes the incoming frame, composed at the current offset
+    memcpy(transitionTo, oled.getBuffer(), frameBytes);
+    transitionToValid = true;
+    composeTransition();
+    flush();
+}
+
 void DisplayController::showConfirmation() {
     showAnimation(animation_tick, 20);
 }
@@ -865,8 +1285,8 @@ void DisplayController::drawDurationSelectScreen(const String& taskName, int dur
     oled.print("MIN");
 
     // 左右箭头图标
-    oled.drawBitmap(0, 18, image_change_left, 7, 36, 1);
-    oled.drawBitmap(121, 18, image_change_right, 7, 36, 1);
+    raster().drawBitmap(0, 18, image_change_left, 7, 36, 1);
+    raster().drawBitmap(121, 18, image_change_right, 7, 36, 1);
 
     // 顶部提示框："PRESS TO START"
     oled.drawRoundRect(32, 1, 65, 11, 1, 1);
@@ -875,13 +1295,14 @@ void DisplayController::drawDurationSelectScreen(const String& taskName, int dur
     oled.print("PRESS TO START");
 
     // 顶部箭头图标
-    oled.drawBitmap(103, 3, icon_arrow_down, 5, 7, 1);
-    oled.drawBitmap(21, 3, icon_arrow_down, 5, 7, 1);
+    raster().drawBitmap(103, 3, icon_arrow_down, 5, 7, 1);
+    raster().drawBitmap(21, 3, icon_arrow_down, 5, 7, 1);
 
-    oled.display();
+    present();
 }
 
-void DisplayController::drawTaskListViewScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted) {
+void DisplayController::drawTaskListViewScreen(const String& projectName, const std::vector<FocusTask>& tasks, int selectedIndex, int displayOffset, bool showingCompleted,
+                                               const uint16_t* order, TaskSortMode sortMode) {
     if (isAnimationRunning()) return;
 
     oled.clearDisplay();
@@ -891,7 +1312,7 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
     setupChineseFont(u8g2Fonts, 1);
 
     // VIEW 徽标（Picopixel）
-    oled.fillRoundRect(4, 0, 22, 14, 4, 1);
+    raster().fillRoundRect(4, 0, 22, 14, 4, 1);
     oled.setFont(&Picopixel);
     oled.setTextSize(1);
     oled.setTextColor(0);
@@ -910,9 +1331,9 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
     oled.drawLine(segX + segHalfW, segY + 2, segX + segHalfW, segY + segH - 3, 1);
 
     if (showingCompleted) {
-        oled.fillRoundRect(segX + segHalfW + 1, segY + 1, segHalfW - 2, segH - 2, segR - 1, 1);
+        raster().fillRoundRect(segX + segHalfW + 1, segY + 1, segHalfW - 2, segH - 2, segR - 1, 1);
     } else {
-        oled.fillRoundRect(segX + 1, segY + 1, segHalfW - 2, segH - 2, segR - 1, 1);
+        raster().fillRoundRect(segX + 1, segY + 1, segHalfW - 2, segH - 2, segR - 1, 1);
     }
 
     const String leftLabel = "待办";
@@ -948,7 +1369,7 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
         oled.setTextColor(1);
         oled.setCursor(38, 62);
         oled.print("CLICK BACK");
-        oled.display();
+        present();
         return;
     }
 
@@ -971,12 +1392,13 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
 
     for (int i = 0; i < MAX_VISIBLE && (displayOffset + i) < (int)tasks.size(); i++) {
         int taskIndex = displayOffset + i;
+        const FocusTask& task = tasks[order ? order[taskIndex] : taskIndex];
         const bool isSelected = (taskIndex == safeIndex);
         const int cardY = LIST_TOP + (i * (CARD_H + CARD_GAP));
         const int textY = cardY + TEXT_BASELINE_OFFSET;
 
         if (isSelected) {
-            oled.fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
+            raster().fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         } else {
             oled.drawRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         }
@@ -986,12 +1408,12 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
         oled.fillTriangle(arrowX, arrowY, arrowX + 4, arrowY - 3, arrowX + 4, arrowY + 3, isSelected ? 0 : 1);
 
         // 任务名
-        String name = tasks[taskIndex].name;
+        String name = task.name;
         if (name.isEmpty()) {
-            name = tasks[taskIndex].displayName;
+            name = task.displayName;
         }
         if (name.isEmpty()) {
-            String suffix = tasks[taskIndex].id;
+            String suffix = task.id;
             if (suffix.length() > 4) {
                 suffix = suffix.substring(suffix.length() - 4);
             }
@@ -1008,25 +1430,25 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
         oled.setTextSize(1);
         oled.setTextColor(isSelected ? 0 : 1);
 
-        String dateStr = showingCompleted ? tasks[taskIndex].completedAt : tasks[taskIndex].dueMmdd;
+        String dateStr = showingCompleted ? task.completedAt : task.dueMmdd;
         if (dateStr.isEmpty()) {
             dateStr = "--.--";
         }
         char priorityChar = '-';
-        if (!tasks[taskIndex].priorityFlag.isEmpty()) {
-            priorityChar = tasks[taskIndex].priorityFlag[0];
+        if (!task.priorityFlag.isEmpty()) {
+            priorityChar = task.priorityFlag[0];
         } else {
-            const int p = tasks[taskIndex].priority;
+            const int p = task.priority;
             if (p >= 5) priorityChar = 'H';
             else if (p >= 3) priorityChar = 'M';
             else if (p >= 1) priorityChar = 'L';
         }
-        const char repeatChar = tasks[taskIndex].hasRepeat ? 'R' : '-';
-        const char reminderChar = tasks[taskIndex].hasReminder ? 'A' : '-';
+        const char repeatChar = task.hasRepeat ? 'R' : '-';
+        const char reminderChar = task.hasReminder ? 'A' : '-';
 
         char subBuf[10] = {0};
-        if (tasks[taskIndex].subtasksTotal > 0) {
-            snprintf(subBuf, sizeof(subBuf), "%d/%d", tasks[taskIndex].subtasksDone, tasks[taskIndex].subtasksTotal);
+        if (task.subtasksTotal > 0) {
+            snprintf(subBuf, sizeof(subBuf), "%d/%d", task.subtasksDone, task.subtasksTotal);
         }
 
         char rightLabel[24] = {0};
@@ -1046,12 +1468,18 @@ void DisplayController::drawTaskListViewScreen(const String& projectName, const
     oled.setCursor(38, 62);
     oled.print("CLICK BACK");
 
+    const char* sortLabel = sortModeLabel(sortMode);
+    if (sortLabel[0] != '\0') {
+        oled.setCursor(118 - (int)strlen(sortLabel) * 4, 62);
+        oled.print(sortLabel);
+    }
+
     // ===== Scrollbar =====
     const int total = (int)tasks.size();
     const int visible = (total < MAX_VISIBLE) ? total : MAX_VISIBLE;
     drawTaskListScrollBar(oled, 123, 16, 4, 36, displayOffset, total, visible);
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawProjectSelectScreen(const std::vector<FocusProject>& projects, int selectedIndex, int displayOffset, const String& selectedProjectId, bool readOnly) {
@@ -1064,7 +1492,7 @@ void DisplayController::drawProjectSelectScreen(const std::vector<FocusProject>&
 
     int headerLeft = 4;
     if (readOnly) {
-        oled.fillRoundRect(4, 0, 22, 14, 4, 1);
+        raster().fillRoundRect(4, 0, 22, 14, 4, 1);
         oled.setFont(&Picopixel);
         oled.setTextSize(1);
         oled.setTextColor(0);
@@ -1112,7 +1540,7 @@ void DisplayController::drawProjectSelectScreen(const std::vector<FocusProject>&
         oled.setTextColor(1);
         oled.setCursor(34, 62);
         oled.print("DBL BACK");
-        oled.display();
+        present();
         return;
     }
 
@@ -1139,7 +1567,7 @@ void DisplayController::drawProjectSelectScreen(const std::vector<FocusProject>&
         const int textY = cardY + TEXT_BASELINE_OFFSET;
 
         if (isSelected) {
-            oled.fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
+            raster().fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         } else {
             oled.drawRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         }
@@ -1189,7 +1617,7 @@ void DisplayController::drawProjectSelectScreen(const std::vector<FocusProject>&
     const int visible = (total < MAX_VISIBLE) ? total : MAX_VISIBLE;
     drawTaskListScrollBar(oled, 123, 16, 4, 36, displayOffset, total, visible);
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawTaskDetailScreen(const String& projectName, const FocusTask& task, int selectedIndex, int displayOffset) {
@@ -1258,7 +1686,7 @@ void DisplayController::drawTaskDetailScreen(const String& projectName, const Fo
         const int textY = cardY + TEXT_BASELINE_OFFSET;
 
         if (isSelected) {
-            oled.fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
+            raster().fillRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         } else {
             oled.drawRoundRect(CARD_X, cardY, CARD_W, CARD_H, CARD_R, 1);
         }
@@ -1272,7 +1700,7 @@ void DisplayController::drawTaskDetailScreen(const String& projectName, const Fo
             // Checkbox
             oled.drawRect(CHECK_X, cardY + CHECK_Y_OFFSET, 7, 7, color);
             if (checked) {
-                oled.fillRect(CHECK_X + 2, cardY + CHECK_Y_OFFSET + 2, 3, 3, color);
+                raster().fillRect(CHECK_X + 2, cardY + CHECK_Y_OFFSET + 2, 3, 3, color);
             }
 
             String subTitle = sub.title;
@@ -1329,7 +1757,7 @@ void DisplayController::drawTaskDetailScreen(const String& projectName, const Fo
     const int visible = (total < MAX_VISIBLE) ? total : MAX_VISIBLE;
     drawTaskListScrollBar(oled, 123, 16, 4, 36, displayOffset, total, visible);
 
-    oled.display();
+    present();
 }
 
 // ============================================================
@@ -1349,13 +1777,6 @@ void DisplayController::drawSegmentControlAnimated(
     // Draw separator line
     oled.drawLine(segX + segHalfW, segY + 2, segX + segHalfW, segY + segH - 3, 1);
 
-    // Draw animated highlight block
-    oled.fillRoundRect(
-        (int)highlightX, segY + 1,
-        segHalfW - 2, segH - 2,
-        segR - 1, 1
-    );
-
     // Draw labels
     setupChineseFont(u8g2Fonts, 1);
 
@@ -1365,19 +1786,20 @@ void DisplayController::drawSegmentControlAnimated(
     const int16_t leftCenterX = segX + (segHalfW / 2);
     const int16_t rightCenterX = segX + segHalfW + (segHalfW / 2);
 
-    // Determine text color based on highlight position
-    float midPoint = segX + segHalfW / 2.0f + segHalfW / 2.0f;
-    bool highlightOnLeft = (highlightX < midPoint);
-
-    u8g2Fonts.setForegroundColor(highlightOnLeft ? 0 : 1);
     int16_t leftW = u8g2Fonts.getUTF8Width(leftLabel.c_str());
     u8g2Fonts.setCursor(leftCenterX - leftW / 2, labelY);
     u8g2Fonts.print(leftLabel);
 
-    u8g2Fonts.setForegroundColor(highlightOnLeft ? 1 : 0);
     int16_t rightW = u8g2Fonts.getUTF8Width(rightLabel.c_str());
     u8g2Fonts.setCursor(rightCenterX - rightW / 2, labelY);
     u8g2Fonts.print(rightLabel);
+
+    // Invert the animated highlight block over the labels, so a label half under it is split cleanly mid-slide
+    raster().fillRoundRect(
+        (int)highlightX, segY + 1,
+        segHalfW - 2, segH - 2,
+        segR - 1, PageRaster::Invert
+    );
 }
 
 void DisplayController::drawScrollBarAnimated(
@@ -1389,7 +1811,7 @@ void DisplayController::drawScrollBarAnimated(
     oled.drawRoundRect(x, y, w, h, 2, 1);
 
     // Draw animated knob
-    oled.fillRoundRect(x + 1, (int)knobY, w - 2, knobH, 1, 1);
+    raster().fillRoundRect(x + 1, (int)knobY, w - 2, knobH, 1, 1);
 }
 
 void DisplayController::drawTaskListScreenAnimated(
@@ -1450,7 +1872,7 @@ void DisplayController::drawTaskListScreenAnimated(
         u8g2Fonts.print(title);
         u8g2Fonts.setCursor(subX < 0 ? 0 : subX, 52);
         u8g2Fonts.print(sub);
-        oled.display();
+        present();
         return;
     }
 
@@ -1490,7 +1912,7 @@ void DisplayController::drawTaskListScreenAnimated(
 
         // Draw selection highlight (full width bar, no border)
         if (isSelected) {
-            oled.fillRect(0, yPos, 120, LINE_HEIGHT, 1);
+            raster().fillRect(0, yPos, 120, LINE_HEIGHT, 1);
         }
 
         // Task name (left side)
@@ -1555,7 +1977,7 @@ void DisplayController::drawTaskListScreenAnimated(
         );
     }
 
-    oled.display();
+    present();
 }
 
 void DisplayController::drawTaskListViewScreenAnimated(
@@ -1595,7 +2017,7 @@ void DisplayController::drawTaskListViewScreenAnimated(
     // Animated highlight
     float highlightX = animState.segmentHighlightX.getValue();
     float adjustedHighlightX = highlightX + 4;  // Offset for VIEW mode
-    oled.fillRoundRect(
+    raster().fillRoundRect(
         (int)adjustedHighlightX, segY + 1,
         segHalfW - 2, segH - 2,
         segR - 1, 1
@@ -1653,7 +2075,7 @@ void DisplayController::drawTaskListViewScreenAnimated(
         u8g2Fonts.print(title);
         u8g2Fonts.setCursor(subX < 0 ? 0 : subX, 52);
         u8g2Fonts.print(sub);
-        oled.display();
+        present();
         return;
     }
 
@@ -1693,7 +2115,7 @@ void DisplayController::drawTaskListViewScreenAnimated(
 
         // Draw selection highlight (full width bar, no border)
         if (isSelected) {
-            oled.fillRect(0, yPos, 120, LINE_HEIGHT, 1);
+            raster().fillRect(0, yPos, 120, LINE_HEIGHT, 1);
         }
 
         // Task name (left side)
@@ -1758,5 +2180,5 @@ void DisplayController::drawTaskListViewScreenAnimated(
         );
     }
 
-    oled.display();
+    present();
 }
@@ -1,141 +1,427 @@
 #include "controllers/InputController.h"
+#include "EventQueue.h"
 #include <Arduino.h>
+#include <driver/gpio.h>
+#include <hal/gpio_ll.h>
 
 static InputController *instancePtr = nullptr; // Global pointer for the ISR / ISR 使用的全局指针
+static portMUX_TYPE wakeMux = portMUX_INITIALIZER_UNLOCKED; // 布防状态在主循环与 ISR 之间切换 / Guards wakeArmed between loop and ISR
 
-void InputController::handleEncoderInterrupt()
-{
-    if (instancePtr)
-    {
-        instancePtr->encoder.tick();
-    }
-}
+// 正交编码状态转移方向表（旧状态 << 2 | 新状态），与 RotaryEncoder 库一致
+// Quadrature direction table indexed by (old << 2 | new), same as the RotaryEncoder library
+static const int8_t KNOBDIR[16] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
+
+// 加速曲线：{slowMs, fastMs, maxSteps} / Acceleration curves: {slowMs, fastMs, maxSteps}
+const EncoderProfile ENCODER_PRECISE = {0, 0, 1};
+const EncoderProfile ENCODER_LIST = {80, 20, 4};   // 快转一格最多跳 4 行 / Up to 4 rows per detent
+const EncoderProfile ENCODER_VALUE = {80, 15, 6};  // 快转一格最多 6 个步长（30 分钟）/ Up to 6 steps (30 min) per detent
 
-void InputController::handleButtonInterrupt()
+// 中断只记录时间与电平，解码在主循环完成 / The ISR only records time and levels; decoding runs in the loop
+void IRAM_ATTR InputController::handleInterrupt()
 {
     if (instancePtr)
     {
-        instancePtr->button.tick();
+        // 电平中断会持续触发，先换回边沿 / A level interrupt keeps firing; switch back to edges first
+        portENTER_CRITICAL_ISR(&wakeMux);
+        if (instancePtr->wakeArmed)
+        {
+            instancePtr->restoreEdgeInterrupts();
+        }
+        portEXIT_CRITICAL_ISR(&wakeMux);
+
+        InputEdge edge = {(uint32_t)micros(), instancePtr->readLevels()};
+        instancePtr->edges.push(edge);
+        eventQueue.postFromISR(EventType::Input);
     }
 }
 
 InputController::InputController(uint8_t buttonPin, uint8_t encoderPinA, uint8_t encoderPinB)
-    : button(buttonPin, true),
-      encoder(encoderPinA, encoderPinB, RotaryEncoder::LatchMode::TWO03),
-      lastPosition(0),
-      buttonPin(buttonPin),
+    : buttonPin(buttonPin),
       encoderPinA(encoderPinA),
-      encoderPinB(encoderPinB)
+      encoderPinB(encoderPinB),
+      wakeArmed(false),
+      rawPressed(false),
+      stablePressed(false),
+      stableAtUs(0),
+      rawAtUs(0),
+      phase(ButtonPhase::Idle),
+      phaseAtUs(0),
+      quadState(0),
+      quadPosition(0),
+      detentPosition(0),
+      pendingDelta(0),
+      pendingDeltaUs(0),
+      encoderProfile(&ENCODER_PRECISE),
+      lastDetentUs(0),
+      lastDetentDir(0),
+      latencyLastUs(0),
+      latencyMaxUs(0),
+      latencyAvgUs(0),
+      latencyEvents(0)
 {
-
-    // Attach click, double-click, and long-press handlers using OneButton library / 通过 OneButton 绑定单击、双击、长按回调
-    button.attachClick([](void *scope)
-                       { static_cast<InputController *>(scope)->onButtonClick(); }, this);
-    button.attachDoubleClick([](void *scope)
-                             { static_cast<InputController *>(scope)->onButtonDoubleClick(); }, this);
-    button.attachLongPressStart([](void *scope)
-                                { static_cast<InputController *>(scope)->onButtonLongPress(); }, this);
-
     instancePtr = this; // Set the global instance pointer to this instance / 记录当前实例供中断使用
 }
 
 void InputController::begin()
 {
-    button.setDebounceMs(20);
-    button.setClickMs(150);
-    button.setPressMs(400);
-    lastPosition = encoder.getPosition();
-
     pinMode(buttonPin, INPUT_PULLUP);
     pinMode(encoderPinA, INPUT_PULLUP);
     pinMode(encoderPinB, INPUT_PULLUP);
 
-    // Set up interrupts for encoder handling / 配置编码器中断
-    attachInterrupt(digitalPinToInterrupt(encoderPinA), handleEncoderInterrupt, CHANGE);
-    attachInterrupt(digitalPinToInterrupt(encoderPinB), handleEncoderInterrupt, CHANGE);
+    const uint8_t levels = readLevels();
+    quadState = levels & (LEVEL_A | LEVEL_B);
+    rawPressed = stablePressed = (levels & LEVEL_BUTTON) == 0; // 低电平为按下 / Active low
+    stableAtUs = rawAtUs = micros();
+
+    // 三个引脚共用一个中断：每个边沿都带上全部电平 / One ISR for all pins; every edge carries all levels
+    attachInterrupt(digitalPinToInterrupt(encoderPinA), handleInterrupt, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(encoderPinB), handleInterrupt, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(buttonPin), handleInterrupt, CHANGE);
+
+    tickTask = scheduler.add("input", onTick, this);
+}
+
+void InputController::onTick(void *arg)
+{
+    static_cast<InputController *>(arg)->update();
+}
 
-    // Set up interrupt for button handling / 配置按键中断
-    attachInterrupt(digitalPinToInterrupt(buttonPin), handleButtonInterrupt, CHANGE); // Interrupt on button state change / 按键状态变化触发
+uint8_t IRAM_ATTR InputController::readLevels() const
+{
+    return (digitalRead(encoderPinA) ? LEVEL_A : 0) |
+           (digitalRead(encoderPinB) ? LEVEL_B : 0) |
+           (digitalRead(buttonPin) ? LEVEL_BUTTON : 0);
 }
 
 void InputController::update()
 {
-    button.tick();
-    encoder.tick();
+    // 按原始时间顺序回放边沿，主循环再忙也不丢步进 / Replay edges in order with their original times
+    InputEdge edge;
+    while (edges.pop(edge))
+    {
+        decodeEdge(edge);
+    }
+
+    const uint32_t now = micros();
+    settleButton(now);
+    expireGesture(now);
+    flushRotation();
+
+    // 下一个手势截止时间 / Next gesture deadline
+    const uint32_t untilMs = msUntilNextTick();
+    if (untilMs == UINT32_MAX)
+    {
+        scheduler.cancel(tickTask);
+    }
+    else
+    {
+        scheduler.in(tickTask, untilMs);
+    }
+}
+
+void InputController::decodeEdge(const InputEdge &edge)
+{
+    // 先让时间走到该边沿：到期的去抖/单击/长按先判定 / Advance time to this edge first
+    settleButton(edge.us);
+    expireGesture(edge.us);
+
+    decodeEncoder(edge.levels, edge.us);
+
+    const bool pressed = (edge.levels & LEVEL_BUTTON) == 0;
+    if (pressed != rawPressed)
+    {
+        rawPressed = pressed;
+        rawAtUs = edge.us;
+        settleButton(edge.us);
+    }
+}
+
+void InputController::decodeEncoder(uint8_t levels, uint32_t us)
+{
+    const uint8_t state = levels & (LEVEL_A | LEVEL_B);
+    if (state == quadState)
+    {
+        return;
+    }
+
+    quadPosition += KNOBDIR[state | (quadState << 2)];
+    quadState = state;
+
+    // TWO03：在 00 与 11 两个锁定位各计一步 / TWO03: one detent at each of the 00 and 11 latch states
+    if (state == 0 || state == (LEVEL_A | LEVEL_B))
+    {
+        const int detent = quadPosition >> 1;
+        if (detent != detentPosition)
+        {
+            // 长按判定前按住转动：之前的普通旋转先报出，之后的步进归入 HoldRotate，本次按下不再算单击/长按
+            // Turned while held before the long press: report earlier plain rotation, then count detents as
+            // HoldRotate; this press no longer becomes a click or long press
+            if (phase == ButtonPhase::Down)
+            {
+                flushRotation();
+                phase = ButtonPhase::Turning;
+            }
+
+            if (pendingDelta == 0)
+            {
+                pendingDeltaUs = us;
+            }
+            pendingDelta += accelerate(detent > detentPosition ? 1 : -1, us) * abs(detent - detentPosition);
+            detentPosition = detent;
+        }
+    }
+}
+
+int InputController::accelerate(int dir, uint32_t us)
+{
+    // 用中断记录的边沿时间计算间隔，主循环延迟不影响加速判断 / Intervals use ISR edge times, so loop delays do not skew them
+    uint8_t steps = 1;
+    if (dir == lastDetentDir)
+    {
+        steps = encoderProfile->stepsFor((us - lastDetentUs) / 1000);
+    }
+    lastDetentUs = us;
+    lastDetentDir = dir;
+    return dir * steps;
+}
+
+void InputController::settleButton(uint32_t nowUs)
+{
+    // 锁定式去抖：接受一次变化后 20 ms 内忽略抖动 / Lock-out debounce: ignore bounce for 20 ms after a change
+    if (rawPressed == stablePressed || nowUs - stableAtUs < DEBOUNCE_US)
+    {
+        return;
+    }
+
+    const uint32_t at = (rawAtUs - stableAtUs >= DEBOUNCE_US) ? rawAtUs : stableAtUs + DEBOUNCE_US;
+    acceptButton(rawPressed, at);
+}
+
+void InputController::acceptButton(bool pressed, uint32_t us)
+{
+    expireGesture(us);
 
-    // Check encoder position and calculate delta / 计算编码器增量
-    int currentPosition = encoder.getPosition();
-    int delta = currentPosition - lastPosition;
+    stablePressed = pressed;
+    stableAtUs = us;
 
-    if (delta != 0)
+    switch (phase)
     {
-        onEncoderRotate(delta);
-        lastPosition = currentPosition;
+    case ButtonPhase::Idle:
+        if (pressed)
+        {
+            phase = ButtonPhase::Down;
+            phaseAtUs = us;
+        }
+        break;
+
+    case ButtonPhase::Down:
+        if (!pressed)
+        {
+            phase = ButtonPhase::Up;
+            phaseAtUs = us;
+        }
+        break;
+
+    case ButtonPhase::Up:
+        if (pressed)
+        {
+            phase = ButtonPhase::DownAgain;
+            phaseAtUs = us;
+        }
+        break;
+
+    case ButtonPhase::DownAgain:
+        if (!pressed)
+        {
+            phase = ButtonPhase::Idle;
+            flushRotation();
+            emit(Trigger::DoublePress, 0, us);
+        }
+        break;
+
+    case ButtonPhase::Held:
+        if (!pressed)
+        {
+            phase = ButtonPhase::Idle;
+        }
+        break;
+
+    case ButtonPhase::Turning:
+        if (!pressed)
+        {
+            flushRotation();
+            phase = ButtonPhase::Idle;
+        }
+        break;
     }
 }
 
-// Register state-specific handlers / 注册当前状态的处理器
-void InputController::onPressHandler(std::function<void()> handler)
+void InputController::expireGesture(uint32_t nowUs)
 {
-    pressHandler = handler;
+    if (phase == ButtonPhase::Down && nowUs - phaseAtUs >= LONG_PRESS_US)
+    {
+        phase = ButtonPhase::Held;
+        flushRotation();
+        emit(Trigger::LongPress, 0, phaseAtUs + LONG_PRESS_US);
+    }
+    else if (phase == ButtonPhase::Up && nowUs - phaseAtUs >= CLICK_US)
+    {
+        // 双击窗口结束仍未再按：单击 / Double-click window closed without a second press: single click
+        phase = ButtonPhase::Idle;
+        flushRotation();
+        emit(Trigger::Press, 0, phaseAtUs + CLICK_US);
+    }
 }
 
-void InputController::onDoublePressHandler(std::function<void()> handler)
+void InputController::flushRotation()
 {
-    doublePressHandler = handler;
+    if (pendingDelta != 0)
+    {
+        const int delta = pendingDelta;
+        pendingDelta = 0;
+        emit(phase == ButtonPhase::Turning ? Trigger::HoldRotate : Trigger::Rotate, delta, pendingDeltaUs);
+    }
 }
 
-void InputController::onLongPressHandler(std::function<void()> handler)
+uint32_t InputController::msUntilNextTick()
 {
-    longPressHandler = handler;
+    if (!edges.empty())
+    {
+        return 0;
+    }
+
+    // 最近的去抖/单击/长按截止时间 / Nearest debounce, click or long-press deadline
+    const uint32_t now = micros();
+    bool pending = false;
+    int32_t untilUs = INT32_MAX;
+    if (rawPressed != stablePressed)
+    {
+        pending = true;
+        untilUs = min(untilUs, (int32_t)(stableAtUs + DEBOUNCE_US - now));
+    }
+    if (phase == ButtonPhase::Down)
+    {
+        pending = true;
+        untilUs = min(untilUs, (int32_t)(phaseAtUs + LONG_PRESS_US - now));
+    }
+    else if (phase == ButtonPhase::Up)
+    {
+        pending = true;
+        untilUs = min(untilUs, (int32_t)(phaseAtUs + CLICK_US - now));
+    }
+
+    if (!pending)
+    {
+        return UINT32_MAX;
+    }
+    return untilUs <= 0 ? 0 : ((uint32_t)untilUs + 999) / 1000;
 }
 
-void InputController::onEncoderRotateHandler(std::function<void(int delta)> handler)
+void InputController::setInputSink(void (*sink)(const InputEvent &event))
 {
-    encoderRotateHandler = handler;
+    inputSink = sink;
 }
 
-// Method to release all handlers / 清空所有回调
-void InputController::releaseHandlers()
+void InputController::reset()
 {
-    pressHandler = nullptr;
-    doublePressHandler = nullptr;
-    longPressHandler = nullptr;
-    encoderRotateHandler = nullptr;
+    // 保留去抖电平与编码器位置，仅丢弃未完成的手势 / Keep debounce level and encoder position, drop gestures in flight
+    phase = stablePressed ? ButtonPhase::Held : ButtonPhase::Idle;
+    pendingDelta = 0;
+    lastDetentDir = 0;
+}
 
-    button.reset();                       // Reset button state machine / 重置按键状态机
-    lastPosition = encoder.getPosition(); // Reset encoder position tracking / 重置编码器位置记录
+void InputController::armWakeup()
+{
+    // ESP32 的 GPIO 唤醒只支持电平触发：每个引脚等待离开当前电平。中断保持开启，读电平与布防之间的变化会立刻触发；
+    // 三个引脚在同一临界区内布防，ISR 不会看到只布防了一半的状态
+    // ESP32 GPIO wakeup is level-triggered only: each pin waits to leave its current level. Interrupts stay
+    // enabled, so a change between reading and arming fires at once; all pins arm in one critical section
+    // so the ISR never sees a half-armed set
+    portENTER_CRITICAL(&wakeMux);
+    wakeArmed = true;
+    const uint8_t pins[] = {encoderPinA, encoderPinB, buttonPin};
+    for (uint8_t pin : pins)
+    {
+        gpio_ll_wakeup_enable(&GPIO, (gpio_num_t)pin, digitalRead(pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+    portEXIT_CRITICAL(&wakeMux);
 }
 
-// Internal event handlers that call the registered state handlers / 内部事件转发到状态回调
-void InputController::onButtonClick()
+void InputController::disarmWakeup()
 {
-    if (pressHandler != nullptr)
+    // 等待超时未触发：恢复边沿中断 / Timed out without an edge: restore edge interrupts
+    portENTER_CRITICAL(&wakeMux);
+    if (wakeArmed)
     {
-        pressHandler();
+        restoreEdgeInterrupts();
     }
+    portEXIT_CRITICAL(&wakeMux);
 }
 
-void InputController::onButtonDoubleClick()
+void InputController::recordWakeEdge()
 {
-    if (doublePressHandler != nullptr)
+    // ISR 与主循环在同一核上，临界区内压入边沿不会与 ISR 交错 / The ISR runs on the loop's core, so pushing inside the critical section cannot interleave with it
+    portENTER_CRITICAL(&wakeMux);
+    const bool missed = wakeArmed;
+    if (missed)
+    {
+        restoreEdgeInterrupts();
+        InputEdge edge = {(uint32_t)micros(), readLevels()};
+        edges.push(edge);
+    }
+    portEXIT_CRITICAL(&wakeMux);
+
+    if (missed)
     {
-        doublePressHandler();
+        eventQueue.post(EventType::Input);
     }
 }
 
-void InputController::onButtonLongPress()
+// 只写寄存器（gpio_ll 内联），可在 ISR 中调用 / Register writes only (inline gpio_ll), safe from the ISR
+void IRAM_ATTR InputController::restoreEdgeInterrupts()
 {
-    if (longPressHandler != nullptr)
+    wakeArmed = false;
+    const uint8_t pins[] = {encoderPinA, encoderPinB, buttonPin};
+    for (uint8_t pin : pins)
     {
-        longPressHandler();
+        gpio_ll_wakeup_disable(&GPIO, (gpio_num_t)pin);
+        gpio_ll_set_intr_type(&GPIO, (gpio_num_t)pin, GPIO_INTR_ANYEDGE);
     }
 }
 
-void InputController::onEncoderRotate(int delta)
+void InputController::setEncoderProfile(const EncoderProfile &profile)
+{
+    encoderProfile = &profile;
+}
+
+InputLatencyStats InputController::getLatencyStats() const
+{
+    InputLatencyStats stats;
+    stats.lastUs = latencyLastUs;
+    stats.maxUs = latencyMaxUs;
+    stats.avgUs = latencyAvgUs;
+    stats.events = latencyEvents;
+    stats.overflows = edges.overflowCount();
+    return stats;
+}
+
+// Forward a gesture to the sink and time it / 将手势转发给接收函数并统计延迟
+void InputController::emit(Trigger gesture, int delta, uint32_t timestampUs)
 {
-    if (encoderRotateHandler != nullptr)
+    if (inputSink == nullptr)
+    {
+        return;
+    }
+
+    InputEvent event = {gesture, delta, timestampUs};
+    inputSink(event);
+
+    const uint32_t latency = micros() - timestampUs;
+    latencyLastUs = latency;
+    if (latency > latencyMaxUs)
     {
-        encoderRotateHandler(delta); // Pass delta to the handler / 将增量传递给回调
+        latencyMaxUs = latency;
     }
+    latencyAvgUs = (latencyEvents == 0) ? latency : (uint32_t)((int32_t)latencyAvgUs + ((int32_t)latency - (int32_t)latencyAvgUs) / 8);
+    latencyEvents++;
 }
@@ -1,245 +1,426 @@
 #include "controllers/LedController.h"
 
+// gamma 2.6 校正表：线性强度 → PWM 占空 / Gamma 2.6 table: linear intensity to PWM duty
+static const uint8_t GAMMA8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
+      3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
+      7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
+     13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
+     20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+     30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
+     42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
+     58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
+     76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
+     97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
+    122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
+    150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
+    182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+    218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,
+};
+
 LEDController::LEDController(uint8_t ledPin, uint16_t numLeds, uint8_t brightness)
-    : leds(numLeds, ledPin),
+    : leds(ledPin, numLeds),
       numLeds(numLeds),
       brightness(brightness),
-      currentAnimation(None),
-      lastUpdateTime(0),
-      currentStep(0),
-      currentCycle(0),
-      decayStarted(false) {}
+      frameTask(Scheduler::INVALID),
+      baseFrame(new uint32_t[numLeds]()),
+      fadeFrom(new uint32_t[numLeds]()),
+      layerFrame(new uint32_t[numLeds]()),
+      fadeStartMs(0),
+      fading(false),
+      baseRendered(false),
+      frames(0)
+{
+    memset(&base, 0, sizeof(base));
+    memset(&overlay, 0, sizeof(overlay));
+}
 
 void LEDController::begin()
 {
     leds.begin();
     leds.setBrightness(brightness);
     leds.show();
+
+    frameTask = scheduler.add("led", onFrame, this);
+}
+
+void LEDController::onFrame(void *arg)
+{
+    static_cast<LEDController *>(arg)->renderFrame();
+}
+
+void LEDController::buildRamp(Layer &layer, uint32_t color, uint8_t peak)
+{
+    const uint32_t r = (color >> 16 & 0xFF) * peak / 255;
+    const uint32_t g = (color >> 8 & 0xFF) * peak / 255;
+    const uint32_t b = (color & 0xFF) * peak / 255;
+
+    for (int i = 0; i < 256; i++)
+    {
+        layer.ramp[i] = NeoPixelRmt::Color(r * GAMMA8[i] / 255, g * GAMMA8[i] / 255, b * GAMMA8[i] / 255);
+    }
+}
+
+LEDController::Layer &LEDController::beginBase(AnimationType type)
+{
+    // 旧画面已上屏：以它为快照开始淡出。同一次状态切换里 exit() 与 enter() 先后设置基础层时，
+    // 中间那个从未出帧，保留原快照即可，不会闪黑。
+    // The old base is on the ring: fade out from a snapshot of it. When exit() and enter() both set the
+    // base during one transition, the middle one never rendered, so the original snapshot is kept.
+    if (baseRendered)
+    {
+        memcpy(fadeFrom, baseFrame, numLeds * sizeof(uint32_t));
+        fadeStartMs = Scheduler::nowMs();
+        fading = true;
+    }
+    baseRendered = false;
+
+    base.type = type;
+    base.startMs = Scheduler::nowMs();
+    base.floor = BREATH_FLOOR;
+    return base;
+}
+
+void LEDController::requestFrame()
+{
+    // 在本轮调度中合成，调用方可以连续设置几层 / Composite on this scheduler pass so callers can set several layers first
+    scheduler.in(frameTask, 0);
 }
 
-void LEDController::update()
+void LEDController::renderFrame()
 {
-    switch (currentAnimation)
+    const int64_t now = Scheduler::nowMs();
+
+    uint32_t untilNext = renderLayer(base, now, baseFrame);
+    baseRendered = true;
+
+    if (fading)
+    {
+        const uint32_t fadeMs = (uint32_t)(now - fadeStartMs);
+        if (fadeMs >= CROSSFADE_MS)
+        {
+            fading = false;
+        }
+        else
+        {
+            const uint32_t weight = fadeMs * 256 / CROSSFADE_MS;
+            for (uint16_t i = 0; i < numLeds; i++)
+            {
+                baseFrame[i] = mix(fadeFrom[i], baseFrame[i], weight);
+            }
+            untilNext = min(untilNext, min((uint32_t)CROSSFADE_FRAME_MS, CROSSFADE_MS - fadeMs));
+        }
+    }
+
+    if (overlay.type != None)
+    {
+        const uint32_t overlayNext = renderLayer(overlay, now, layerFrame);
+        for (uint16_t i = 0; i < numLeds; i++)
+        {
+            leds.setPixelColor(i, blend(baseFrame[i], layerFrame[i], overlay.blend));
+        }
+
+        // 播完的叠加层最后一帧为黑，移除不改变画面 / A finished overlay ends black, so dropping it changes nothing
+        if (overlayNext == UINT32_MAX)
+        {
+            overlay.type = None;
+        }
+        untilNext = min(untilNext, overlayNext);
+    }
+    else
+    {
+        for (uint16_t i = 0; i < numLeds; i++)
+        {
+            leds.setPixelColor(i, baseFrame[i]);
+        }
+    }
+
+    if (leds.show())
+    {
+        frames++;
+    }
+
+    // 所有层都不再变化时不排下一帧 / No next frame once every layer is final
+    if (untilNext != UINT32_MAX)
+    {
+        scheduler.in(frameTask, untilNext);
+    }
+}
+
+uint32_t LEDController::renderLayer(const Layer &layer, int64_t nowMs, uint32_t *out)
+{
+    const uint32_t elapsedMs = (uint32_t)(nowMs - layer.startMs);
+
+    uint32_t nextMs;
+    switch (layer.type)
     {
     case FillAndDecay:
-        handleFillAndDecay();
+        nextMs = renderFillAndDecay(layer, elapsedMs, out);
         break;
     case Spinner:
-        handleSpinner();
+        nextMs = renderSpinner(layer, elapsedMs, out);
         break;
     case Breath:
-        handleBreath();
+        nextMs = renderBreath(layer, elapsedMs, out);
         break;
+    case Solid:
+        fillFrame(out, layer.color);
+        return UINT32_MAX;
     default:
-        break;
+        fillFrame(out, 0);
+        return UINT32_MAX;
     }
+
+    // 播完后纯函数继续给出最后一帧 / Once finished, the pure function keeps returning the final frame
+    if (nextMs == ANIMATION_END)
+    {
+        return UINT32_MAX;
+    }
+    return nextMs > elapsedMs ? nextMs - elapsedMs : 0;
 }
 
 void LEDController::startFillAndDecay(uint32_t color, uint32_t totalDuration)
 {
-    stopCurrentAnimation();
-    currentAnimation = FillAndDecay;
-    animationColor = color;
-    animationDuration = totalDuration;
-    currentStep = 0;
-    pixelIndex = 0;
-    brightnessLevel = brightness;
-    lastUpdateTime = millis();
+    Layer &layer = beginBase(FillAndDecay);
+    layer.color = color;
+    layer.duration = totalDuration;
+    buildRamp(layer, color, brightness);
+    requestFrame();
 }
 
 void LEDController::setSpinner(uint32_t color, int cycles)
 {
-    stopCurrentAnimation();
-    currentAnimation = Spinner;
-    animationColor = color;
-    animationCycles = cycles;
-    currentCycle = 0;
-    currentStep = 0;
-    lastUpdateTime = millis();
+    Layer &layer = beginBase(Spinner);
+    layer.color = color;
+    layer.cycles = cycles;
+    buildRamp(layer, color, 255);
+    requestFrame();
 }
 
 void LEDController::setBreath(uint32_t color, int cycles, bool endFilled, uint32_t speed)
 {
-    stopCurrentAnimation();
-    currentAnimation = Breath;
-    animationColor = color;
-    animationCycles = cycles;
-    this->endFilled = endFilled;
-    animationSpeed = speed;
-    currentCycle = 0;
-    currentStep = 0;
-    lastUpdateTime = millis();
+    Layer &layer = beginBase(Breath);
+    layer.color = color;
+    layer.cycles = cycles;
+    layer.endFilled = endFilled;
+    layer.speed = speed > 0 ? speed : 1;
+    buildRamp(layer, color, 255);
+    requestFrame();
 }
 
 void LEDController::setSolid(uint32_t color)
 {
-    stopCurrentAnimation();
-    leds.fill(color);
-    leds.show();
+    Layer &layer = beginBase(Solid);
+    layer.color = color;
+    requestFrame();
 }
 
 void LEDController::turnOff()
 {
-    stopCurrentAnimation();
-    leds.clear();
-    leds.show();
+    setSolid(0);
+}
+
+void LEDController::flash(uint32_t color, int pulses, BlendMode mode)
+{
+    overlay.type = Breath;
+    overlay.startMs = Scheduler::nowMs();
+    overlay.color = color;
+    overlay.cycles = pulses > 0 ? pulses : 1;
+    overlay.endFilled = false;
+    overlay.speed = FLASH_STEP_MS;
+    overlay.floor = 0;
+    overlay.blend = mode;
+    buildRamp(overlay, color, brightness);
+    requestFrame();
 }
 
-uint32_t LEDController::scaleColor(uint32_t color, uint8_t brightnessLevel)
+void LEDController::fillFrame(uint32_t *out, uint32_t color)
 {
-    uint8_t r = (color >> 16 & 0xFF) * brightnessLevel / 255;
-    uint8_t g = (color >> 8 & 0xFF) * brightnessLevel / 255;
-    uint8_t b = (color & 0xFF) * brightnessLevel / 255;
-    return leds.Color(r, g, b);
+    for (uint16_t i = 0; i < numLeds; i++)
+    {
+        out[i] = color;
+    }
 }
 
-void LEDController::handleFillAndDecay()
+uint32_t LEDController::mix(uint32_t from, uint32_t to, uint32_t weight)
 {
-    uint32_t fillDuration = 300; // Initial fill duration / 初始快速填充时长
-    uint32_t decayDuration = animationDuration - fillDuration;
-    uint32_t totalSteps = (numLeds + 1) * brightness;
-    uint32_t stepDuration = decayDuration / totalSteps;
+    uint32_t result = 0;
+    for (int shift = 0; shift <= 16; shift += 8)
+    {
+        const int32_t a = from >> shift & 0xFF;
+        const int32_t b = to >> shift & 0xFF;
+        result |= (uint32_t)(a + (b - a) * (int32_t)weight / 256) << shift;
+    }
+    return result;
+}
 
-    if (currentStep < numLeds)
+uint32_t LEDController::blend(uint32_t below, uint32_t above, BlendMode mode)
+{
+    switch (mode)
+    {
+    case Replace:
+        return above != 0 ? above : below;
+    case Lighten:
+    case Add:
     {
-        // Quick fill phase / 快速填充阶段
-        uint32_t stepDurationFill = fillDuration / numLeds;
-        if (millis() - lastUpdateTime >= stepDurationFill)
+        uint32_t result = 0;
+        for (int shift = 0; shift <= 16; shift += 8)
         {
-            leds.setPixelColor(currentStep, scaleColor(animationColor, brightness));
-            leds.show();
-            currentStep++;
-            lastUpdateTime = millis();
+            const uint32_t a = below >> shift & 0xFF;
+            const uint32_t b = above >> shift & 0xFF;
+            const uint32_t c = mode == Add ? min(a + b, (uint32_t)255) : max(a, b);
+            result |= c << shift;
         }
+        return result;
     }
-    else
+    default:
+        return below;
+    }
+}
+
+uint32_t LEDController::nextRampChange(const Layer &layer, uint32_t sub)
+{
+    uint32_t k = sub + 1;
+    while (k < 255 && layer.ramp[255 - k] == layer.ramp[255 - sub])
+    {
+        k++;
+    }
+    return k;
+}
+
+uint32_t LEDController::renderFillAndDecay(const Layer &layer, uint32_t elapsedMs, uint32_t *out)
+{
+    // 先用 FILL_MS 逐颗点亮，再把剩余时间均分给每颗灯从满亮衰减到熄灭（0 号灯最后熄灭）
+    // Light the ring over FILL_MS, then split the remaining time evenly: each LED fades out in turn, LED 0 last
+    // 计划时长短于填充时间时填满即熄灭（不再发生无符号下溢）/ Shorter than the fill: go dark once full (no unsigned underflow)
+    const uint32_t decayMs = layer.duration > FILL_MS ? layer.duration - FILL_MS : 0;
+    const uint64_t span = (uint64_t)numLeds * 255;
+
+    // pos 以 1/255 颗灯为单位；按 pos 换算出输出变化的时刻 / pos counts 1/255 of an LED; convert it back to a deadline
+    auto decayAt = [&](uint64_t pos) -> uint32_t {
+        return FILL_MS + (uint32_t)((pos * decayMs + span - 1) / span);
+    };
+
+    if (elapsedMs < FILL_MS)
     {
-        // Initialize decay phase / 初始化衰减阶段
-        if (!decayStarted)
+        const uint32_t lit = min((uint32_t)numLeds, 1 + elapsedMs * numLeds / FILL_MS);
+        fillFrame(out, 0);
+        for (uint32_t i = 0; i < lit; i++)
         {
-            decayStarted = true;
-            pixelIndex = 1;
-            brightnessLevel = brightness;
-            lastUpdateTime = millis();
+            out[i] = layer.ramp[255];
         }
-
-        // Decay phase / 衰减阶段
-        if (millis() - lastUpdateTime >= stepDuration)
+        if (lit < numLeds)
         {
-            lastUpdateTime = millis();
+            return (lit * FILL_MS + numLeds - 1) / numLeds;
+        }
+        return decayMs > 0 ? decayAt(nextRampChange(layer, 0)) : FILL_MS;
+    }
 
-            if (brightnessLevel > 0)
-            {
-                brightnessLevel--;
-                leds.setPixelColor(pixelIndex, scaleColor(animationColor, brightnessLevel));
-                leds.show();
-            }
-            else
-            {
-                leds.setPixelColor(pixelIndex, 0);
-                leds.show();
-                pixelIndex++;
-                brightnessLevel = brightness;
-            }
+    const uint64_t pos = decayMs > 0 ? (uint64_t)(elapsedMs - FILL_MS) * span / decayMs : span;
+    if (pos >= span)
+    {
+        fillFrame(out, 0);
+        return ANIMATION_END;
+    }
 
-            if (pixelIndex > numLeds)
-            {
-                stopCurrentAnimation();
-            }
-        }
+    // slot 号灯正在衰减，之前的已熄灭 / LED `slot` is fading, earlier ones are out
+    const uint32_t slot = pos / 255;
+    const uint32_t sub = pos % 255;
+    for (uint32_t s = 0; s < numLeds; s++)
+    {
+        const uint16_t pixel = (s + 1 < numLeds) ? s + 1 : 0;
+        out[pixel] = s < slot ? 0 : (s == slot ? layer.ramp[255 - sub] : layer.ramp[255]);
+    }
+
+    // 跳过查找表里相同的输出，直接排到下一次可见变化 / Skip LUT entries with the same output to the next visible change
+    if (layer.ramp[255 - sub] != 0)
+    {
+        return decayAt((uint64_t)slot * 255 + nextRampChange(layer, sub)); // 255：本颗熄灭 / 255: this LED goes out
+    }
+    if (slot + 1 >= numLeds)
+    {
+        return ANIMATION_END; // 最后一颗已暗 / The last LED is already dark
     }
+    return decayAt(min((uint64_t)(slot + 1) * 255 + nextRampChange(layer, 0), span)); // 等下一颗开始变暗 / Wait for the next LED to dim
 }
 
-void LEDController::handleSpinner()
+uint32_t LEDController::renderSpinner(const Layer &layer, uint32_t elapsedMs, uint32_t *out)
 {
-    uint32_t stepDuration = 100;
-    if (millis() - lastUpdateTime >= stepDuration)
+    uint32_t step = elapsedMs / SPINNER_STEP_MS;
+    bool last = false;
+    if (layer.cycles != -1)
     {
-        leds.clear();
-        for (int i = 0; i < numLeds; i++)
+        const uint32_t lastStep = (uint32_t)layer.cycles * numLeds - 1;
+        if (step >= lastStep)
         {
-            leds.setPixelColor((i + currentStep) % numLeds, scaleColor(animationColor, i * 255 / numLeds));
+            step = lastStep;
+            last = true;
         }
-        leds.show();
-        currentStep++;
-        lastUpdateTime = millis();
+    }
 
-        if (currentStep >= numLeds)
-        {
-            currentStep = 0;
-            currentCycle++;
-            if (animationCycles != -1 && currentCycle >= animationCycles)
-            {
-                stopCurrentAnimation();
-            }
-        }
+    const uint32_t head = step % numLeds;
+    for (uint32_t i = 0; i < numLeds; i++)
+    {
+        out[(i + head) % numLeds] = layer.ramp[i * 255 / numLeds];
     }
+    return last ? ANIMATION_END : (step + 1) * SPINNER_STEP_MS;
+}
+
+uint8_t LEDController::breathLevel(const Layer &layer, uint32_t step)
+{
+    const uint32_t raw = (step <= 127) ? step * 2 : (BREATH_STEPS - step) * 2;
+    return layer.floor + raw * (255 - layer.floor) / 255;
 }
 
-void LEDController::handleBreath()
+uint32_t LEDController::renderBreath(const Layer &layer, uint32_t elapsedMs, uint32_t *out)
 {
-    if (millis() - lastUpdateTime >= animationSpeed)
+    const uint32_t step = elapsedMs / layer.speed;
+
+    // endFilled 时最后半个周期改为补满 / With endFilled the last half cycle becomes a fill
+    const bool finite = layer.cycles != -1;
+    uint32_t endStep = 0;
+    if (finite)
     {
-        // Calculate brightness with minimum threshold to prevent complete dimming
-        // 计算亮度，设置最小阈值避免完全熄灭
-        uint8_t rawBrightness = (currentStep <= 127) ? currentStep * 2 : (255 - currentStep) * 2;
-        const uint8_t minBrightness = 25; // Minimum brightness ~10% (避免完全熄灭的最小亮度)
-        uint8_t fadeBrightness = map(rawBrightness, 0, 255, minBrightness, 255);
+        int cycles = (layer.endFilled && layer.cycles > 0) ? layer.cycles - 1 : layer.cycles;
+        endStep = (uint32_t)max(cycles, 1) * BREATH_STEPS;
+    }
 
-        for (int i = 0; i < numLeds; i++)
+    if (finite && step >= endStep)
+    {
+        if (layer.endFilled)
         {
-            leds.setPixelColor(i, scaleColor(animationColor, fadeBrightness));
+            fillFrame(out, layer.color);
         }
-        leds.show();
-        currentStep++;
-
-        if (currentStep >= 255)
+        else
         {
-            currentStep = 0;
-            currentCycle++;
-
-            // Adjust the number of cycles if `endFilled` is true / 若 endFilled 为真，最后补半个循环填充
-            int effectiveCycles = animationCycles;
-            if (endFilled && effectiveCycles > 0)
-            {
-                effectiveCycles--;
-            }
-
-            if (effectiveCycles != -1 && currentCycle >= effectiveCycles)
-            {
-                if (endFilled)
-                {
-                    // Additional half cycle to fill the LEDs / 额外半个循环补满 LED
-                    for (int i = 0; i < numLeds; i++)
-                    {
-                        leds.setPixelColor(i, animationColor);
-                    }
-                    leds.show();
-                }
-                else
-                {
-                    turnOff();
-                }
-                stopCurrentAnimation();
-            }
+            fillFrame(out, 0);
         }
-        lastUpdateTime = millis();
+        return ANIMATION_END;
     }
-}
 
-void LEDController::stopCurrentAnimation()
-{
-    currentAnimation = None;
-    currentStep = 0;
-    currentCycle = 0;
-    pixelIndex = 0;
-    brightnessLevel = brightness;
-    decayStarted = false;
-    lastUpdateTime = millis();
+    const uint32_t output = layer.ramp[breathLevel(layer, step % BREATH_STEPS)];
+    fillFrame(out, output);
+
+    // 最多向前看一个周期 / Look ahead at most one cycle
+    uint32_t next = step + 1;
+    while ((!finite || next < endStep) && next - step < BREATH_STEPS && layer.ramp[breathLevel(layer, next % BREATH_STEPS)] == output)
+    {
+        next++;
+    }
+    return next * layer.speed;
 }
 
 void LEDController::printDebugInfo()
 {
-    Serial.printf("Anim: %d, Step: %d, Cycle: %d, PixelIdx: %d, Leds numb: %d, Brightness: %d, Color: 0x%06X, Dur: %lu, Speed: %lu, Cycles: %d, EndFilled: %d / 动画调试信息\n",
-                  currentAnimation, currentStep, currentCycle, pixelIndex, numLeds, brightness, animationColor, animationDuration, animationSpeed, animationCycles, endFilled);
+    const int64_t now = Scheduler::nowMs();
+    Serial.printf("Base: %d, Elapsed: %ld ms, Color: 0x%06X, Dur: %lu, Speed: %lu, Cycles: %d, EndFilled: %d, Fading: %d / 基础层\n",
+                  base.type, (long)(now - base.startMs), base.color, (unsigned long)base.duration, (unsigned long)base.speed,
+                  base.cycles, base.endFilled, fading);
+    Serial.printf("Overlay: %d, Elapsed: %ld ms, Color: 0x%06X, Blend: %d / 叠加层\n",
+                  overlay.type, (long)(now - overlay.startMs), overlay.color, overlay.blend);
+    Serial.printf("Leds numb: %d, Brightness: %d, Frames: %lu, shown: %lu, dropped: %lu, suppressed: %lu / 帧统计\n",
+                  numLeds, brightness, (unsigned long)frames, (unsigned long)leds.framesShown(),
+                  (unsigned long)leds.framesDropped(), (unsigned long)leds.framesSuppressed());
 }
@@ -1,5 +1,11 @@
 #include "Config.h"
+#include "EventQueue.h"
+#include "JsonArena.h"
 #include "controllers/NetworkController.h"
+#include "controllers/InputController.h"
+#include "controllers/PowerController.h"
+#include "Controllers.h"
+#include "StateMachine.h"
 
 #include <WiFi.h>
 #include <WiFiClientSecure.h>
@@ -8,6 +14,7 @@
 #include <BluetoothA2DPSink.h>
 #include <ArduinoJson.h>
 #include <esp_bt.h>
+#include <esp32/rom/crc.h>
 #include <memory>
 
 NetworkController *NetworkController::instance = nullptr;
@@ -17,15 +24,20 @@ NetworkController::NetworkController()
       btPaired(false),
       bluetoothActive(false),
       bluetoothAttempted(false),
+      provisioningMode(false),
       lastBluetoothtAttempt(0),
       bluetoothTaskHandle(nullptr),
-      webhookQueue(nullptr),
       webhookTaskHandle(nullptr),
-      provisioningMode(false),
+      webhookQueue(nullptr),
+      webhookBusy(false),
       apiServer(nullptr),
       apiServerStarted(false),
-      lastTaskListJson(""),
-      onTaskListUpdate(nullptr)
+      lastTaskListHash(0),
+      taskListLoaded(false),
+      onTaskListUpdate(nullptr),
+      minLargestFreeBlock(UINT32_MAX),
+      pollTask(Scheduler::INVALID),
+      heapTask(Scheduler::INVALID)
 {
 
     instance = this;
@@ -78,6 +90,22 @@ void NetworkController::begin()
     }
 
     // API Server will be started lazily after WiFi is connected / 在 WiFi 连接后再延迟启动 API 服务器
+    pollTask = scheduler.add("net-poll", onPoll, this, true);
+    heapTask = scheduler.add("heap", onHeapSample, this, true);
+    scheduler.in(pollTask, 0);
+    scheduler.every(heapTask, HEAP_SAMPLE_INTERVAL);
+}
+
+void NetworkController::onPoll(void *arg)
+{
+    NetworkController *self = static_cast<NetworkController *>(arg);
+    self->update();
+    scheduler.in(self->pollTask, self->msUntilNextPoll());
+}
+
+void NetworkController::onHeapSample(void *arg)
+{
+    static_cast<NetworkController *>(arg)->sampleHeap();
 }
 
 void NetworkController::update()
@@ -94,6 +122,29 @@ void NetworkController::update()
     }
 }
 
+uint32_t NetworkController::msUntilNextPoll()
+{
+    return apiServerStarted ? API_POLL_INTERVAL : WIFI_POLL_INTERVAL;
+}
+
+bool NetworkController::canLightSleep()
+{
+    if (provisioningMode || bluetoothActive || !apiServerStarted || !isWiFiConnected())
+    {
+        return false;
+    }
+    return !webhookBusy && uxQueueMessagesWaiting(webhookQueue) == 0;
+}
+
+void NetworkController::sampleHeap()
+{
+    const uint32_t largest = ESP.getMaxAllocHeap();
+    if (largest < minLargestFreeBlock)
+    {
+        minLargestFreeBlock = largest;
+    }
+}
+
 bool NetworkController::isWiFiProvisioned()
 {
     // Check for stored WiFi credentials / 检查是否已有 WiFi 凭据
@@ -121,6 +172,7 @@ void NetworkController::startProvisioning()
     bluetoothActive = true;  // Enable Bluetooth for pairing / 开启蓝牙用于配对
     provisioningMode = true; // Indicate we are in provisioning mode / 记录当前为配网模式
     initializeBluetooth();
+    notifyBluetoothTask();
     wifiProvisioner.setupAccessPointAndServer();
 }
 
@@ -175,12 +227,22 @@ void NetworkController::startBluetooth()
     if (btPaired)
     { // Only start if paired
         bluetoothActive = true;
+        notifyBluetoothTask();
     }
 }
 
 void NetworkController::stopBluetooth()
 {
     bluetoothActive = false; // Stop Bluetooth activity / 停止蓝牙活动
+    notifyBluetoothTask();
+}
+
+void NetworkController::notifyBluetoothTask()
+{
+    if (bluetoothTaskHandle != nullptr)
+    {
+        xTaskNotifyGive(bluetoothTaskHandle);
+    }
 }
 
 void NetworkController::btConnectionStateCallback(esp_a2d_connection_state_t state, void *obj)
@@ -204,6 +266,8 @@ void NetworkController::btConnectionStateCallback(esp_a2d_connection_state_t sta
         Serial.println("Bluetooth device disconnected. / 蓝牙设备已断开");
         // No need to set flags; task loop will handle reconnection logic based on is_connected() / 标志位由任务循环处理
     }
+
+    self->notifyBluetoothTask();
 }
 
 void NetworkController::saveBluetoothPairedState(bool paired)
@@ -243,7 +307,7 @@ void NetworkController::bluetoothTask(void *param)
             }
 
             // If Bluetooth is active but not connected, attempt reconnect every 2 seconds / 蓝牙应当激活但未连接时，每 2 秒重连
-            if (self->bluetoothActive && !self->a2dp_sink.is_connected() && (millis() - self->lastBluetoothtAttempt >= 2000))
+            if (self->bluetoothActive && !self->a2dp_sink.is_connected() && (millis() - self->lastBluetoothtAttempt >= BT_RECONNECT_INTERVAL))
             {
                 Serial.println("Attempting Bluetooth reconnect... / 尝试重新连接蓝牙");
                 self->a2dp_sink.start("Focus Dial", true);
@@ -259,13 +323,16 @@ void NetworkController::bluetoothTask(void *param)
             }
         }
 
-        vTaskDelay(100 / portTICK_PERIOD_MS);
+        // 不再每 100 ms 轮询：标志/连接状态变化时被通知，仅在等待重连时定时醒来
+        // No 100 ms polling: notified on flag or link changes, timed wakeups only while a reconnect is pending
+        const bool reconnecting = !self->provisioningMode && self->bluetoothActive && !self->a2dp_sink.is_connected();
+        ulTaskNotifyTake(pdTRUE, reconnecting ? pdMS_TO_TICKS(BT_RECONNECT_INTERVAL) : portMAX_DELAY);
     }
 }
 
 void NetworkController::sendWebhookAction(const String &action)
 {
-    DynamicJsonDocument doc(128);
+    ArenaJsonDocument doc(128);
     doc["action"] = action;
 
     String payload;
@@ -313,7 +380,10 @@ void NetworkController::webhookTask(void *param)
 
             // Send the webhook request and check the response
             // 发送 webhook 请求并检查结果
+            self->webhookBusy = true;
             bool success = self->sendWebhookRequest(String(payload));
+            self->webhookBusy = false;
+            eventQueue.post(success ? EventType::WebhookOk : EventType::WebhookFailed);
             if (success)
             {
                 Serial.println("Webhook payload sent successfully. / webhook 发送成功");
@@ -544,7 +614,7 @@ void NetworkController::handleFactoryReset()
 
 // ========== HTTP API Server / HTTP API 服务器 ==========
 
-void NetworkController::setTaskListUpdateCallback(std::function<void(const String&)> callback)
+void NetworkController::setTaskListUpdateCallback(std::function<bool(JsonDocument&)> callback)
 {
     onTaskListUpdate = callback;
 }
@@ -585,9 +655,18 @@ void NetworkController::setupApiServer()
 
     apiServer = new WebServer(80);
 
+    // 最小调制解调器睡眠：射频按 DTIM 醒来，自动轻睡眠（PowerController）期间保持关联，API 仍可达
+    // Minimum modem sleep: the radio wakes per DTIM, so the station stays associated and the API reachable
+    // under automatic light sleep (PowerController)
+    WiFi.setSleep(WIFI_PS_MIN_MODEM);
+
     apiServer->on("/api/tasklist", HTTP_POST, [this]() { handleAPITaskList(); });
     apiServer->on("/api/status", HTTP_GET, [this]() { handleAPIStatus(); });
 
+    // WebServer 默认不保存请求头，需显式声明 / WebServer only keeps explicitly collected headers
+    static const char *headerKeys[] = {"If-None-Match"};
+    apiServer->collectHeaders(headerKeys, 1);
+
     apiServer->begin();
     apiServerStarted = true;
     Serial.printf("API Server started on http://%s:80 / API 服务器已启动\n", WiFi.localIP().toString().c_str());
@@ -607,9 +686,34 @@ void NetworkController::handleAPITaskList()
         return;
     }
 
-    // 基础 JSON 校验（避免明显错误）/ Basic JSON validation
-    // 任务列表 payload 可能包含 projects + subtasks，需更大缓冲区避免误判 invalid json
-    DynamicJsonDocument doc(24576);
+    // If-None-Match：HA 声明本次内容哈希，与当前一致则无需再计算 / Client-declared hash of this body
+    if (taskListLoaded && apiServer->hasHeader("If-None-Match"))
+    {
+        String tag = apiServer->header("If-None-Match");
+        tag.replace("W/", "");
+        tag.replace("\"", "");
+        tag.trim();
+        if (tag.equalsIgnoreCase(taskListETag()))
+        {
+            apiServer->sendHeader("ETag", "\"" + taskListETag() + "\"");
+            apiServer->send(200, "application/json", "{\"status\":\"unchanged\"}");
+            return;
+        }
+    }
+
+    // 内容未变化时直接返回，跳过 JSON 解析与列表重建 / Short-circuit identical pushes
+    // CRC-32 由 ROM 实现，HA 侧可用 zlib.crc32 计算同一值 / ROM CRC-32, matches Python zlib.crc32
+    const uint32_t bodyHash = crc32_le(0, reinterpret_cast<const uint8_t *>(body.c_str()), body.length());
+    if (taskListLoaded && bodyHash == lastTaskListHash)
+    {
+        apiServer->sendHeader("ETag", "\"" + taskListETag() + "\"");
+        apiServer->send(200, "application/json", "{\"status\":\"unchanged\"}");
+        return;
+    }
+
+    // 基础 JSON 校验（避免明显错误）；文档直接交给回调，不再二次解析
+    // Basic JSON validation; the document is handed to the callback instead of being parsed twice
+    ArenaJsonDocument doc(JsonArena::CAPACITY);
     DeserializationError error = deserializeJson(doc, body);
     if (error)
     {
@@ -623,13 +727,20 @@ void NetworkController::handleAPITaskList()
         return;
     }
 
-    lastTaskListJson = body;
-
-    if (onTaskListUpdate)
+    // 仅在列表被接受后记录哈希，旧版本推送不能覆盖当前内容的 ETag
+    // Record the hash only once the list is accepted so a stale push cannot take over the current ETag
+    if (onTaskListUpdate && !onTaskListUpdate(doc))
     {
-        onTaskListUpdate(body);
+        // 带上当前版本，HA 时钟回拨后可据此接续 / Include the current version so HA can continue from it after a clock step back
+        apiServer->send(409, "application/json",
+                        "{\"status\":\"stale\",\"version\":" + String(StateMachine::taskListState.listVersion) + "}");
+        return;
     }
+    lastTaskListHash = bodyHash;
+    taskListLoaded = true;
+    eventQueue.post(EventType::Network);
 
+    apiServer->sendHeader("ETag", "\"" + taskListETag() + "\"");
     apiServer->send(200, "application/json", "{\"status\":\"ok\"}");
 }
 
@@ -640,11 +751,42 @@ void NetworkController::handleAPIStatus()
         return;
     }
 
-    DynamicJsonDocument doc(256);
+    sampleHeap();
+
+    ArenaJsonDocument doc(2048);
     doc["wifi_connected"] = isWiFiConnected();
-    doc["tasklist_loaded"] = !lastTaskListJson.isEmpty();
+    doc["tasklist_loaded"] = taskListLoaded;
+    // HA 可对比该哈希，内容一致时跳过推送 / HA compares this hash to skip identical pushes
+    doc["tasklist_hash"] = taskListLoaded ? taskListETag() : String("");
+    doc["tasklist_version"] = StateMachine::taskListState.listVersion;
+
+    // 碎片化观测：最大可分配块越来越小说明堆在碎片化 / Shrinking largest block means the heap is fragmenting
+    doc["heap_free"] = ESP.getFreeHeap();
+    doc["heap_largest_block"] = ESP.getMaxAllocHeap();
+    doc["heap_largest_block_min"] = minLargestFreeBlock;
+    doc["json_arena_peak"] = JsonArena::instance().peakUsage();
+    doc["json_arena_fallbacks"] = JsonArena::instance().fallbackCount();
+
+    // 输入延迟：手势可判定 → 状态处理完成 / Input latency: gesture recognisable -> handled by the state
+    const InputLatencyStats input = inputController.getLatencyStats();
+    doc["input_latency_us"] = input.lastUs;
+    doc["input_latency_avg_us"] = input.avgUs;
+    doc["input_latency_max_us"] = input.maxUs;
+    doc["input_events"] = input.events;
+    doc["input_edge_overflows"] = input.overflows;
+
+    // 各状态驻留时间、轻睡眠占比与估算电流 / Per-state residency, light-sleep ratio and estimated current
+    powerController.writeStatus(doc["power"].to<JsonObject>());
+    displayController.writeStatus(doc["display"].to<JsonObject>());
 
     String out;
     serializeJson(doc, out);
     apiServer->send(200, "application/json", out);
 }
+
+String NetworkController::taskListETag() const
+{
+    char buf[9];
+    snprintf(buf, sizeof(buf), "%08lx", (unsigned long)lastTaskListHash);
+    return String(buf);
+}
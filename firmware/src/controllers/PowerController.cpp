@@ -0,0 +1,161 @@
+#include "Config.h"
+#include "EventQueue.h"
+#include "controllers/PowerController.h"
+#include "Controllers.h"
+
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+PowerController::PowerController()
+    : currentId(StateId::Startup),
+      enteredAtUs(0),
+      rejects(0),
+      autoLightSleep(false),
+      awakeLock(nullptr),
+      sleepStartUs(0)
+{
+    memset(residency, 0, sizeof(residency));
+}
+
+void PowerController::begin()
+{
+    enteredAtUs = esp_timer_get_time();
+
+    // 引脚在等待期间按电平布防，此处只打开 GPIO 唤醒源 / Pins are armed per wait; this only enables the GPIO source
+    esp_sleep_enable_gpio_wakeup();
+
+    // 先创建并持有锁，再打开自动轻睡眠，启动阶段不会睡 / Hold the lock before enabling sleep so startup never sleeps
+    esp_err_t err = esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "awake", &awakeLock);
+    if (err == ESP_OK)
+    {
+        esp_pm_lock_acquire(awakeLock);
+
+        esp_pm_config_esp32_t config = {};
+        config.max_freq_mhz = getCpuFrequencyMhz();
+        config.min_freq_mhz = PM_MIN_FREQ_MHZ;
+        config.light_sleep_enable = true;
+        err = esp_pm_configure(&config);
+    }
+    else
+    {
+        awakeLock = nullptr;
+    }
+
+    autoLightSleep = err == ESP_OK;
+    if (!autoLightSleep)
+    {
+        Serial.printf("PowerController: Automatic light sleep unavailable (%s), sleeping manually / 自动轻睡眠不可用，改为手动轻睡眠\n",
+                      esp_err_to_name(err));
+    }
+}
+
+bool PowerController::beginSleepWait()
+{
+    // 串口在轻睡眠中停止时钟，先发完缓冲 / The UART clock stops in light sleep; drain it first
+    Serial.flush();
+
+    // RMT 时钟在睡眠中停止，先让灯环发完 / The RMT clock stops while asleep; let the ring finish first
+    if (!ledController.waitIdle(LED_IDLE_WAIT_MS))
+    {
+        rejects++;
+        return false;
+    }
+
+    inputController.armWakeup();
+    if (eventQueue.pending())
+    {
+        // 布防前刚到的事件：不睡，直接处理 / An event slipped in before arming: skip sleeping
+        inputController.disarmWakeup();
+        return false;
+    }
+
+    sleepStartUs = esp_timer_get_time();
+    if (autoLightSleep)
+    {
+        esp_pm_lock_release(awakeLock);
+    }
+    return true;
+}
+
+bool PowerController::sleepWait(Event &event, uint32_t ms)
+{
+    if (autoLightSleep)
+    {
+        // 主循环阻塞期间芯片自行睡眠 / The chip sleeps on its own while the loop blocks
+        return eventQueue.wait(event, ms);
+    }
+
+    esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+    esp_light_sleep_start();
+
+    // 唤醒引脚可能在中断恢复前就回到原电平，ISR 没有触发时补记一条边沿
+    // The wake pin may return to its old level before interrupts resume; record the edge if the ISR missed it
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO)
+    {
+        inputController.recordWakeEdge();
+    }
+    return eventQueue.wait(event, 0);
+}
+
+void PowerController::endSleepWait()
+{
+    if (autoLightSleep)
+    {
+        esp_pm_lock_acquire(awakeLock);
+    }
+    inputController.disarmWakeup();
+
+    Residency &r = residency[(size_t)currentId];
+    r.sleepUs += (uint64_t)(esp_timer_get_time() - sleepStartUs);
+    r.wakeups++;
+}
+
+void PowerController::enterState(StateId id)
+{
+    const int64_t now = esp_timer_get_time();
+    residency[(size_t)currentId].totalUs += (uint64_t)(now - enteredAtUs);
+    enteredAtUs = now;
+    currentId = id;
+}
+
+float PowerController::estimateMa(uint64_t totalUs, uint64_t sleepUs)
+{
+    if (totalUs == 0)
+    {
+        return 0;
+    }
+    const float sleepRatio = (float)sleepUs / (float)totalUs;
+    return POWER_LIGHT_SLEEP_MA * sleepRatio + POWER_ACTIVE_MA * (1.0f - sleepRatio);
+}
+
+void PowerController::writeStatus(JsonObject out)
+{
+    // 结算当前状态到此刻，不改变其起点 / Include the current state up to now without restarting it
+    const uint64_t openUs = (uint64_t)(esp_timer_get_time() - enteredAtUs);
+
+    uint64_t allTotalUs = 0;
+    uint64_t allSleepUs = 0;
+    for (uint8_t i = 0; i < (uint8_t)StateId::Count; i++)
+    {
+        const Residency &r = residency[i];
+        const uint64_t totalUs = r.totalUs + (i == (uint8_t)currentId ? openUs : 0);
+        if (totalUs == 0)
+        {
+            continue;
+        }
+        allTotalUs += totalUs;
+        allSleepUs += r.sleepUs;
+
+        JsonObject state = out["states"][Transitions::stateName((StateId)i)].to<JsonObject>();
+        state["seconds"] = (uint32_t)(totalUs / 1000000);
+        state["sleep_pct"] = (uint8_t)(r.sleepUs * 100 / totalUs);
+        state["wakeups"] = r.wakeups;
+        state["current_ma_est"] = roundf(estimateMa(totalUs, r.sleepUs) * 10) / 10;
+    }
+
+    out["state"] = Transitions::stateName(currentId);
+    out["current_ma_est"] = roundf(estimateMa(allTotalUs, allSleepUs) * 10) / 10;
+    out["auto_light_sleep"] = autoLightSleep;
+    out["light_sleep_rejects"] = rejects;
+}
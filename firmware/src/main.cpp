@@ -1,5 +1,8 @@
 #include <Arduino.h>
 #include "Config.h"
+#include "EventQueue.h"
+#include "Scheduler.h"
+#include "SessionJournal.h"
 #include "StateMachine.h"
 #include "Controllers.h"
 
@@ -8,34 +11,58 @@ DisplayController displayController(OLED_WIDTH, OLED_HEIGHT, OLED_ADDR);
 LEDController ledController(LED_PIN, NUM_LEDS, LED_BRIGHTNESS);
 InputController inputController(BUTTON_PIN, ENCODER_A_PIN, ENCODER_B_PIN);
 NetworkController networkController;
+PowerController powerController;
 Preferences preferences;
 
 void setup() {
     Serial.begin(115200);
+    eventQueue.begin();
     
     // Initialize controllers / 初始化各控制器
     inputController.begin();
     displayController.begin();
     ledController.begin();
     networkController.begin();
+    powerController.begin();
+    stateMachine.begin();
+
+    // 读取上次重启前未结束的专注会话 / Pick up a focus session cut short by the last reset
+    sessionJournal.begin();
+
+    // Restore last task list from flash before HA pushes a fresh one / 在 HA 推送前先从闪存恢复任务列表
+    StateMachine::taskListState.loadFromCache();
 
     // Register HTTP API callbacks / 注册 HTTP API 回调
-    networkController.setTaskListUpdateCallback([](const String& jsonTaskList) {
+    networkController.setTaskListUpdateCallback([](JsonDocument& doc) {
         Serial.println("Callback: Received task list / 回调：收到任务列表");
-        StateMachine::taskListState.updateTaskList(jsonTaskList);
 
         // 静默更新任务列表：仅刷新缓存，不自动切换界面（避免推送后直接跳转到任务清单）
+        return StateMachine::taskListState.updateTaskList(doc);
     });
 
+    // 所有手势经状态机分发：先给当前状态，再给转移表 / All gestures go through the state machine: state first, then the table
+    inputController.setInputSink([](const InputEvent& event) { stateMachine.handleInput(event); });
+
+#if DUMP_STATE_GRAPH
+    stateMachine.dumpGraph(Serial);
+#endif
+
+#if BENCH_PAGE_RASTER
+    displayController.benchmarkRaster(Serial);
+#endif
+
     // Startup state / 进入启动状态
     stateMachine.changeState(&StateMachine::startupState);
 }
 
 void loop() {
-    // Always handle HTTP API requests regardless of state / 无论何种状态都处理 HTTP API 请求
-    networkController.update();
-    // Update state machine / 轮询状态机
-    stateMachine.update();
-    // If any animation needs to run / 若有动画需要更新则刷新
-    displayController.updateAnimation();
+    // Sleep until an input/network event or the nearest deadline / 阻塞到输入/网络事件或最近的截止时间，不再空转
+    stateMachine.waitForEvent();
+
+    // 先解码中断边沿（手势会请求状态重绘）/ Decode ISR edges first; gestures request a state redraw
+    inputController.update();
+
+    // 运行到期的定时任务：HTTP 轮询、LED/屏幕动画帧、状态节拍与超时……
+    // Run due tasks: HTTP polling, LED/display frames, state ticks and timeouts...
+    scheduler.run();
 }
@@ -3,8 +3,7 @@
 #include "states/DurationSelectState.h"
 
 DurationSelectState::DurationSelectState()
-    : duration(DEFAULT_TIMER),
-      lastActivity(0)
+    : duration(DEFAULT_TIMER)
 {
 }
 
@@ -14,16 +13,21 @@ void DurationSelectState::enter()
     Serial.printf("Task: %s, Default duration: %d min\n",
                   selectedTask.name.c_str(), duration);
 
-    lastActivity = millis();
+    stateMachine.armTimeout(this, SELECT_TIMEOUT * 1000);
 
     // LED: 琥珀色呼吸灯表示调节模式 / Amber breathing for adjustment mode
     ledController.setBreath(AMBER, -1, false, 5);
+}
 
+bool DurationSelectState::onInput(const InputEvent& event)
+{
+    switch (event.gesture)
+    {
     // 旋钮调节时长 / Encoder adjusts duration
-    inputController.onEncoderRotateHandler([this](int delta) {
-        lastActivity = millis();
+    case Trigger::Rotate:
+        stateMachine.armTimeout(this, SELECT_TIMEOUT * 1000);
 
-        duration += (delta * DURATION_STEP);
+        duration += (event.delta * DURATION_STEP);
 
         // 边界检查 / Bounds check
         if (duration < DURATION_MIN) {
@@ -33,61 +37,46 @@ void DurationSelectState::enter()
         }
 
         Serial.printf("DurationSelect: Adjusted to %d min\n", duration);
-    });
+        return true;
 
     // 单击确认开始计时 / Click to confirm and start timer
-    inputController.onPressHandler([this]() {
+    case Trigger::Press:
         Serial.printf("DurationSelect: Confirmed %d min for task '%s'\n",
                       duration, selectedTask.name.c_str());
 
         // 设置定时器并启动 / Set timer and start
         StateMachine::timerState.setTimer(
             duration,
-            0,
             selectedTask.id,
             selectedTask.name,
             "",
             selectedTask.displayName,
             selectedTask.projectId);
 
-        displayController.showTimerStart();
-        stateMachine.changeState(&StateMachine::timerState);
-    });
+        // 计时界面由屏幕切换推入，不再播放开始动画 / The timer screen is pushed in by the screen transition instead of the start animation
+        return false;
 
     // 双击查看任务详情（子任务）/ Double press to view task detail (subtasks)
-    inputController.onDoublePressHandler([this]() {
+    case Trigger::DoublePress:
         Serial.println("DurationSelect: Double press - task detail / 双击进入任务详情");
         StateMachine::taskDetailState.setTask(selectedTask, StateMachine::taskListState.selectedProjectName);
-        stateMachine.changeState(&StateMachine::taskDetailState);
-    });
-
-    // 长按取消返回任务列表 / Long press to cancel and return to task list
-    inputController.onLongPressHandler([]() {
-        Serial.println("DurationSelect: Canceled, returning to task list");
-        displayController.showCancel();
-        stateMachine.changeState(&StateMachine::taskListState);
-    });
+        return false;
+
+    // 长按取消返回任务列表由转移表处理 / Long press (cancel to task list) is handled by the transition table
+    default:
+        return false;
+    }
 }
 
 void DurationSelectState::update()
 {
-    inputController.update();
-    ledController.update();
-
     // 绘制时长选择界面 / Draw duration select screen
     displayController.drawDurationSelectScreen(selectedTask.name, duration);
-
-    // 超时返回任务列表 / Timeout returns to task list
-    if (millis() - lastActivity >= (SELECT_TIMEOUT * 1000)) {
-        Serial.println("DurationSelect: Timeout, returning to task list");
-        stateMachine.changeState(&StateMachine::taskListState);
-    }
 }
 
 void DurationSelectState::exit()
 {
     Serial.println("Exiting DurationSelect State / 离开时长选择状态");
-    inputController.releaseHandlers();
     ledController.turnOff();
 }
 
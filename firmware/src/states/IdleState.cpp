@@ -1,11 +1,12 @@
 #include "StateMachine.h"
 #include "Controllers.h"
+#include "JsonArena.h"
 #include <ArduinoJson.h>
 
 // 静态成员初始化 / Static member initialization
 bool IdleState::bootCompleted = false;
 
-IdleState::IdleState() : defaultDuration(0), lastActivity(0)
+IdleState::IdleState() : defaultDuration(0)
 {
 
     if (nvs_flash_init() != ESP_OK)
@@ -37,7 +38,7 @@ void IdleState::enter()
         bootCompleted = true;
         Serial.println("Idle State: First boot - sending device_online event / 首次启动，发送上线事件");
 
-        DynamicJsonDocument doc(256);
+        ArenaJsonDocument doc(256);
         doc["event"] = "device_online";
         doc["action"] = "request_tasks";
 
@@ -46,60 +47,26 @@ void IdleState::enter()
         networkController.sendWebhookPayload(payload);
     }
 
-    // Register state-specific handlers / 注册状态回调
-    inputController.onPressHandler([this]()
-                                   {
-                                       Serial.println("Idle State: Button pressed / 空闲状态：按键按下");
-                                       StateMachine::timerState.setTimer(this->defaultDuration, 0);
-                                       displayController.showTimerStart();
-                                       stateMachine.changeState(&StateMachine::timerState); // Start timer / 切换到计时状态
-                                   });
+    // 单击开始计时、双击任务列表、长按重置、旋钮调整由转移表处理
+    // Press/double/long/rotate are handled by the transition table
 
-    inputController.onDoublePressHandler([]()
-                                         {
-                                             Serial.println("Idle State: Button double pressed / 空闲状态：双击");
-                                             stateMachine.changeState(&StateMachine::taskListState); // Show task list / 进入任务列表
-                                         });
-
-    inputController.onLongPressHandler([this]()
-                                       {
-                                           Serial.println("Idle State: Button long pressed / 空闲状态：长按");
-                                           stateMachine.changeState(&StateMachine::resetState); // Transition to Reset State / 切换到重置状态
-                                       });
-
-    inputController.onEncoderRotateHandler([this](int delta)
-                                           {
-                                               Serial.println("Idle State: Encoder turned / 空闲状态：旋钮转动");
-                                               StateMachine::adjustState.adjustTimer(this->defaultDuration);
-                                               stateMachine.changeState(&StateMachine::adjustState); // Transition to Adjust State / 切换到调整状态
-                                           });
-
-    lastActivity = millis(); // Activity timer / 记录最近操作时间
+    stateMachine.armTimeout(this, SLEEP_TIMOUT * 60 * 1000); // 无操作超时进入休眠 / Sleep when left alone
 }
 
 void IdleState::update()
 {
-    static unsigned long lastUpdateTime = 0;
-
-    // Controllers updates / 控制器轮询
-    inputController.update();
-    ledController.update();
-    networkController.update();
-
     displayController.drawIdleScreen(defaultDuration, networkController.isWiFiConnected());
+}
 
-    // Check if sleep timeout is reached / 是否达到休眠超时
-    if (millis() - lastActivity >= (SLEEP_TIMOUT * 60 * 1000))
-    {
-        Serial.println("Idle State: Activity timeout / 空闲状态：超时进入休眠");
-        stateMachine.changeState(&StateMachine::sleepState); // Transition to Sleep State / 切换到休眠状态
-    }
+unsigned long IdleState::nextWakeup(unsigned long now)
+{
+    // WiFi 断开时图标闪烁需要默认节拍，否则每秒刷新一次即可 / Blinking WiFi icon needs the default tick
+    return now + (networkController.isWiFiConnected() ? IDLE_TICK_MS : STATE_TICK_MS);
 }
 
 void IdleState::exit()
 {
     Serial.println("Exiting Idle State / 离开空闲状态");
-    inputController.releaseHandlers();
     ledController.turnOff();
 }
 
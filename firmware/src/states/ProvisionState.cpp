@@ -4,7 +4,6 @@
 void ProvisionState::enter()
 {
     Serial.println("Entering Provision State / 进入配网状态");
-    inputController.releaseHandlers();
     displayController.drawProvisionScreen();
     ledController.setSolid(AMBER);
     networkController.startProvisioning();
@@ -12,13 +11,12 @@ void ProvisionState::enter()
 
 void ProvisionState::update()
 {
-    ledController.update();
     if (networkController.isWiFiProvisioned() && networkController.isWiFiConnected())
     {
         Serial.println("Provisioning Complete, WiFi Connected / 配网完成，WiFi 已连接");
         displayController.showConnected();
         networkController.stopProvisioning();
-        stateMachine.changeState(&StateMachine::idleState);
+        stateMachine.dispatch(Trigger::Done);
     }
 }
 
@@ -8,30 +8,15 @@ void SleepState::enter()
     ledController.turnOff();
     displayController.clear();
 
-    // Register state-specific handlers / 注册状态回调
-    inputController.onPressHandler([]()
-                                   {
-        Serial.println("Sleep State: Button pressed / 休眠状态：按键按下");
-        stateMachine.changeState(&StateMachine::idleState); });
-
-    inputController.onLongPressHandler([]()
-                                       {
-        Serial.println("Sleep State: long pressed / 休眠状态：长按");
-        stateMachine.changeState(&StateMachine::idleState); });
-
-    inputController.onEncoderRotateHandler([this](int delta)
-                                           {
-        Serial.println("Sleep State: Encoder turned / 休眠状态：旋钮转动");
-        stateMachine.changeState(&StateMachine::idleState); });
+    // 任意输入唤醒由转移表处理 / Any input wakes via the transition table
 }
 
 void SleepState::update()
 {
-    inputController.update();
+    // 输入由主循环统一轮询，唤醒依赖中断事件 / Input is polled by the main loop, woken by interrupts
 }
 
 void SleepState::exit()
 {
     Serial.println("Exiting Sleep State / 离开休眠状态");
-    inputController.releaseHandlers();
 }
@@ -1,8 +1,6 @@
 #include "StateMachine.h"
 #include "Controllers.h"
 
-StartupState::StartupState() : startEnter(0) {}
-
 void StartupState::enter()
 {
     Serial.println("Entering Splash State / 进入启动闪屏状态");
@@ -10,24 +8,12 @@ void StartupState::enter()
     displayController.drawSplashScreen();
     ledController.setSpinner(TEAL, -1);
 
-    startEnter = millis();
+    // 闪屏结束：已配网进入空闲，否则进入配网 / Splash over: idle when provisioned, otherwise provisioning
+    stateMachine.armTimeout(this, SPLASH_DURATION * 1000, Trigger::Done);
 }
 
 void StartupState::update()
 {
-    ledController.update();
-
-    if (millis() - startEnter >= (SPLASH_DURATION * 1000))
-    {
-        if (networkController.isWiFiProvisioned())
-        {
-            stateMachine.changeState(&StateMachine::idleState); // Transition to Idle / 进入空闲状态
-        }
-        else
-        {
-            stateMachine.changeState(&StateMachine::provisionState); // Trigger Provision / 进入配网状态
-        }
-    }
 }
 
 void StartupState::exit()
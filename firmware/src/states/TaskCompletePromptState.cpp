@@ -1,5 +1,6 @@
 #include "StateMachine.h"
 #include "Controllers.h"
+#include "JsonArena.h"
 #include "states/TaskCompletePromptState.h"
 #include <ArduinoJson.h>
 
@@ -38,51 +39,55 @@ void TaskCompletePromptState::enter()
     Serial.println("Entering TaskCompletePrompt State / 进入任务结束确认状态");
 
     ledController.setBreath(isCanceled ? MAGENTA : GREEN, -1, true, 5);
+}
 
+bool TaskCompletePromptState::onInput(const InputEvent& event)
+{
+    switch (event.gesture)
+    {
     // 旋钮选择：顺时针=YES，逆时针=NO / Encoder: CW=YES, CCW=NO
-    inputController.onEncoderRotateHandler([this](int delta) {
-        if (delta > 0) {
+    case Trigger::Rotate:
+        if (event.delta > 0) {
             markDoneSelected = true;
-        } else if (delta < 0) {
+        } else if (event.delta < 0) {
             markDoneSelected = false;
         }
-    });
+        return true;
 
-    auto confirm = [this]() {
-        DynamicJsonDocument doc(512);
-        doc["action"] = "focus_result";
-        doc["event"] = "task_done_decision";
-        doc["session_id"] = sessionId;
-        doc["project_id"] = taskProjectId;
-        doc["task_id"] = taskId;
-        doc["task_name"] = taskName;
-        doc["task_display_name"] = taskDisplayName;
-        doc["mark_task_done"] = markDoneSelected;
-        doc["end_type"] = isCanceled ? "canceled" : "completed";
-        // 添加专注时长，用于 HA 统计
-        doc["elapsed_seconds"] = elapsedSeconds;
-        doc["count_time"] = countTime;
+    // 按键确认；长按也视为确认当前选择 / Press to confirm; long press also confirms the current selection
+    case Trigger::Press:
+    case Trigger::LongPress:
+        sendDecision();
+        return false;
 
-        String payload;
-        serializeJson(doc, payload);
-        networkController.sendWebhookPayload(payload);
-
-        stateMachine.changeState(&StateMachine::idleState);
-    };
+    default:
+        return false;
+    }
+}
 
-    // 按键确认 / Press to confirm
-    inputController.onPressHandler(confirm);
+void TaskCompletePromptState::sendDecision()
+{
+    ArenaJsonDocument doc(512);
+    doc["action"] = "focus_result";
+    doc["event"] = "task_done_decision";
+    doc["session_id"] = sessionId;
+    doc["project_id"] = taskProjectId;
+    doc["task_id"] = taskId;
+    doc["task_name"] = taskName;
+    doc["task_display_name"] = taskDisplayName;
+    doc["mark_task_done"] = markDoneSelected;
+    doc["end_type"] = isCanceled ? "canceled" : "completed";
+    // 添加专注时长，用于 HA 统计
+    doc["elapsed_seconds"] = elapsedSeconds;
+    doc["count_time"] = countTime;
 
-    // 长按也视为确认当前选择 / Long press also confirms current selection
-    inputController.onLongPressHandler(confirm);
+    String payload;
+    serializeJson(doc, payload);
+    networkController.sendWebhookPayload(payload);
 }
 
 void TaskCompletePromptState::update()
 {
-    inputController.update();
-    ledController.update();
-    networkController.update();
-
     // 优先显示中文任务名（taskName），displayName 仅做兼容兜底
     String nameToShow = taskName;
     if (nameToShow.isEmpty()) {
@@ -102,6 +107,5 @@ void TaskCompletePromptState::update()
 void TaskCompletePromptState::exit()
 {
     Serial.println("Exiting TaskCompletePrompt State / 离开任务结束确认状态");
-    inputController.releaseHandlers();
     ledController.turnOff();
 }
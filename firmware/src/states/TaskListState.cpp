@@ -1,11 +1,173 @@
 #include "StateMachine.h"
+#include "ListScroll.h"
 #include "Controllers.h"
+#include "JsonArena.h"
 #include "states/TaskListState.h"
+#include "pinyin_initials.h"
 #include <ArduinoJson.h>
+#include <algorithm>
+
+static const char JUMP_OTHER = '#';  // 数字/非一级汉字等归为一组 / Digits, uncommon CJK etc.
+
+// 单个码点的跳转分组：字母取大写，一级汉字查拼音首字母，数字/其他汉字归 '#'，符号/emoji 返回 0（跳过）
+// Initial for one codepoint: letters upper-cased, CJK via pinyin table, digits/other CJK '#', symbols/emoji 0 (skipped)
+static char codepointInitial(uint32_t cp)
+{
+    if (cp < 0x80) {
+        if (cp >= 'a' && cp <= 'z') return (char)(cp - 'a' + 'A');
+        if (cp >= 'A' && cp <= 'Z') return (char)cp;
+        if (cp >= '0' && cp <= '9') return JUMP_OTHER;
+        return 0;
+    }
+    if (cp < 0x4E00 || cp > 0x9FFF) {
+        return 0;
+    }
+
+    int lo = 0;
+    int hi = PINYIN_TABLE_SIZE - 1;
+    while (lo <= hi) {
+        const int mid = (lo + hi) / 2;
+        const uint16_t v = pgm_read_word(&pinyin_codepoints[mid]);
+        if (v == cp) {
+            return (char)pgm_read_byte(&pinyin_initials[mid]);
+        }
+        if (v < cp) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return JUMP_OTHER;
+}
+
+// 任务名的首字母：跳过开头的空格/符号/emoji（如 "🍅学习" → X）
+// Task initial: skip leading spaces/symbols/emoji (e.g. "🍅学习" -> X)
+static char taskInitial(const FocusTask& task)
+{
+    const String& name = task.name.isEmpty() ? task.displayName : task.name;
+    const uint8_t* p = (const uint8_t*)name.c_str();
+
+    while (*p) {
+        uint32_t cp;
+        int len;
+        if (p[0] < 0x80) {
+            cp = p[0];
+            len = 1;
+        } else if ((p[0] & 0xE0) == 0xC0) {
+            cp = p[0] & 0x1F;
+            len = 2;
+        } else if ((p[0] & 0xF0) == 0xE0) {
+            cp = p[0] & 0x0F;
+            len = 3;
+        } else if ((p[0] & 0xF8) == 0xF0) {
+            cp = p[0] & 0x07;
+            len = 4;
+        } else {
+            p++;  // 非法首字节 / Invalid lead byte
+            continue;
+        }
+
+        int i = 1;
+        for (; i < len && (p[i] & 0xC0) == 0x80; i++) {
+            cp = (cp << 6) | (p[i] & 0x3F);
+        }
+        if (i < len) {
+            p += i;  // 截断的序列 / Truncated sequence
+            continue;
+        }
+
+        const char initial = codepointInitial(cp);
+        if (initial != 0) {
+            return initial;
+        }
+        p += len;
+    }
+    return JUMP_OTHER;
+}
+
+// 为一个排序视图构建跳转表：一次遍历记录每个首字母的第一行
+// Build the jump table for one view: single pass recording the first row of each initial
+static void buildJumpTable(const std::vector<char>& initials, const std::vector<uint16_t>& index,
+                           std::vector<TaskListState::JumpEntry>& table)
+{
+    static const int SLOTS = 27;  // A-Z + '#'
+    int firstRow[SLOTS];
+    for (int i = 0; i < SLOTS; i++) {
+        firstRow[i] = -1;
+    }
+
+    for (size_t row = 0; row < initials.size(); row++) {
+        const char c = initials[index.empty() ? row : index[row]];
+        const int slot = (c == JUMP_OTHER) ? SLOTS - 1 : (c - 'A');
+        if (firstRow[slot] < 0) {
+            firstRow[slot] = (int)row;
+        }
+    }
+
+    table.clear();
+    for (int i = 0; i < SLOTS; i++) {
+        if (firstRow[i] >= 0) {
+            TaskListState::JumpEntry e;
+            e.initial = (i == SLOTS - 1) ? JUMP_OTHER : (char)('A' + i);
+            e.row = (uint16_t)firstRow[i];
+            table.push_back(e);
+        }
+    }
+}
+
+// 截止日期比较：按 YYYYMMDD 比较，跨年时一月不会排到十二月之前；旧版 HA 未下发时退回 MM.DD；无截止日期排在最后
+// Due compare: YYYYMMDD, so January never sorts before December across a year boundary; falls back to MM.DD
+// when an older HA does not send it; tasks without a due date go last
+static bool dueBefore(const FocusTask& a, const FocusTask& b)
+{
+    if (a.dueMmdd.isEmpty() != b.dueMmdd.isEmpty()) {
+        return !a.dueMmdd.isEmpty();
+    }
+    if (a.dueYmd != 0 && b.dueYmd != 0) {
+        return a.dueYmd < b.dueYmd;
+    }
+    return strcmp(a.dueMmdd.c_str(), b.dueMmdd.c_str()) < 0;
+}
+
+static void buildIndex(const std::vector<FocusTask>& tasks, TaskSortMode mode, std::vector<uint16_t>& index)
+{
+    index.clear();
+    if (mode == TaskSortMode::Default) {
+        return;  // 原始顺序无需索引 / Original order needs no index
+    }
+
+    index.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++) {
+        index.push_back((uint16_t)i);
+    }
+
+    // stable_sort：相同键保持 HA 下发顺序 / Ties keep HA order
+    switch (mode) {
+        case TaskSortMode::Priority:
+            std::stable_sort(index.begin(), index.end(), [&tasks](uint16_t a, uint16_t b) {
+                return tasks[a].priority > tasks[b].priority;
+            });
+            break;
+        case TaskSortMode::Due:
+            std::stable_sort(index.begin(), index.end(), [&tasks](uint16_t a, uint16_t b) {
+                return dueBefore(tasks[a], tasks[b]);
+            });
+            break;
+        case TaskSortMode::Spent:
+            std::stable_sort(index.begin(), index.end(), [&tasks](uint16_t a, uint16_t b) {
+                return tasks[a].spentTodaySeconds > tasks[b].spentTodaySeconds;
+            });
+            break;
+        default:
+            break;
+    }
+}
 
 TaskListState::TaskListState()
     : selectedProjectId(""),
       selectedProjectName(""),
+      listVersion(0),
+      sortMode(TaskSortMode::Default),
       mode(TaskListMode::Pending),
       selectedIndexPending(0),
       displayOffsetPending(0),
@@ -13,7 +175,8 @@ TaskListState::TaskListState()
       displayOffsetCompleted(0),
       selectedIndexProjects(0),
       displayOffsetProjects(0),
-      lastActivity(0)
+      jumpMode(false),
+      jumpCursor(0)
 {
 }
 
@@ -28,165 +191,172 @@ void TaskListState::enter()
     displayOffsetCompleted = 0;
     selectedIndexProjects = 0;
     displayOffsetProjects = 0;
-    lastActivity = millis();
+    jumpMode = false;
+    stateMachine.armTimeout(this, TASK_TIMEOUT * 1000);
 
     // LED: Cyan breathing to indicate selection mode / 青色呼吸灯表示选择模式
     ledController.setBreath(TEAL, -1, false, 5);
+}
 
-    // Register encoder rotation handler for scrolling / 旋钮控制滚动
-    inputController.onEncoderRotateHandler([this](int delta) {
-        lastActivity = millis();
+bool TaskListState::onInput(const InputEvent& event)
+{
+    switch (event.gesture) {
+    case Trigger::Rotate:
+        return handleRotate(event.delta);
+    case Trigger::Press:
+        return handlePress();
+    case Trigger::DoublePress:
+        return handleDoublePress();
+    case Trigger::HoldRotate:
+        return handleHoldRotate(event.delta);
+    default:
+        return false;
+    }
+}
 
-        if (delta == 0) {
-            return;
-        }
+// Encoder scrolls the list / 旋钮控制滚动
+bool TaskListState::handleRotate(int delta)
+{
+    stateMachine.armTimeout(this, TASK_TIMEOUT * 1000);
 
-        if (mode == TaskListMode::Projects) {
-            if (projects.empty()) {
-                return;
-            }
-            int& selectedIndex = selectedIndexProjects;
-            int& displayOffset = displayOffsetProjects;
-
-            if (delta > 0) {
-                if (selectedIndex < (int)projects.size() - 1) {
-                    selectedIndex++;
-                    if (selectedIndex - displayOffset >= MAX_VISIBLE_TASKS) {
-                        displayOffset++;
-                    }
-                }
-            } else {
-                if (selectedIndex > 0) {
-                    selectedIndex--;
-                    if (selectedIndex < displayOffset) {
-                        displayOffset--;
-                    }
-                }
-            }
-            return;
-        }
+    if (delta == 0) {
+        return true;
+    }
 
-        std::vector<FocusTask>& currentTasks = (mode == TaskListMode::Completed) ? completedTasks : pendingTasks;
-        int& selectedIndex = (mode == TaskListMode::Completed) ? selectedIndexCompleted : selectedIndexPending;
-        int& displayOffset = (mode == TaskListMode::Completed) ? displayOffsetCompleted : displayOffsetPending;
+    // 跳转模式：每格切换一个首字母，直接落到该字母第一行 / Jump mode: one detent per initial
+    if (jumpMode) {
+        jumpTo(jumpCursor + (delta > 0 ? 1 : -1));
+        return true;
+    }
 
-        if (currentTasks.empty()) {
-            return;
+    if (mode == TaskListMode::Projects) {
+        if (projects.empty()) {
+            return true;
         }
+        int& selectedIndex = selectedIndexProjects;
+        int& displayOffset = displayOffsetProjects;
 
-        if (delta > 0) {
-            if (selectedIndex < (int)currentTasks.size() - 1) {
-                selectedIndex++;
-                if (selectedIndex - displayOffset >= MAX_VISIBLE_TASKS) {
-                    displayOffset++;
-                }
-            }
-        } else {
-            if (selectedIndex > 0) {
-                selectedIndex--;
-                if (selectedIndex < displayOffset) {
-                    displayOffset--;
-                }
-            }
-        }
-    });
+        scrollList(selectedIndex, displayOffset, (int)projects.size(), delta, MAX_VISIBLE_TASKS);
+        return true;
+    }
 
-    // Register button press handler for selection / 按键确认选择
-    inputController.onPressHandler([this]() {
-        lastActivity = millis();
+    std::vector<FocusTask>& currentTasks = (mode == TaskListMode::Completed) ? completedTasks : pendingTasks;
+    int& selectedIndex = (mode == TaskListMode::Completed) ? selectedIndexCompleted : selectedIndexPending;
+    int& displayOffset = (mode == TaskListMode::Completed) ? displayOffsetCompleted : displayOffsetPending;
 
-        // 项目选择：单击选择项目并请求 HA 刷新
-        if (mode == TaskListMode::Projects) {
-            if (projects.empty()) {
-                return;
-            }
-            if (selectedIndexProjects < 0) selectedIndexProjects = 0;
-            if (selectedIndexProjects >= (int)projects.size()) selectedIndexProjects = (int)projects.size() - 1;
-
-            const FocusProject& p = projects[selectedIndexProjects];
-            selectedProjectId = p.id;
-            selectedProjectName = p.name;
-
-            DynamicJsonDocument doc(256);
-            doc["event"] = "project_selected";
-            doc["project_id"] = selectedProjectId;
-            doc["project_name"] = selectedProjectName;
-            String payload;
-            serializeJson(doc, payload);
-            networkController.sendWebhookPayload(payload);
-
-            // 选择项目后回到“待办”
-            mode = TaskListMode::Pending;
-            selectedIndexPending = 0;
-            displayOffsetPending = 0;
-            return;
-        }
+    if (currentTasks.empty()) {
+        return true;
+    }
 
-        // 已完成列表：单击切回待办（只读查看）
-        if (mode == TaskListMode::Completed) {
-            mode = TaskListMode::Pending;
-            return;
-        }
+    scrollList(selectedIndex, displayOffset, (int)currentTasks.size(), delta, MAX_VISIBLE_TASKS);
+    return true;
+}
 
-        if (pendingTasks.empty()) {
-            Serial.println("TaskList: No pending tasks, returning to idle / 无待办任务，返回空闲");
-            stateMachine.changeState(&StateMachine::idleState);
-            return;
-        }
+// Press confirms the selection / 按键确认选择
+bool TaskListState::handlePress()
+{
+    stateMachine.armTimeout(this, TASK_TIMEOUT * 1000);
+
+    // 跳转模式：单击退出，保留当前落点 / Jump mode: click exits, keeping the landed row
+    if (jumpMode) {
+        jumpMode = false;
+        return true;
+    }
 
-        FocusTask* selectedTask = getSelectedTask();
-        if (selectedTask == nullptr) {
-            stateMachine.changeState(&StateMachine::idleState);
-            return;
+    // 项目选择：单击选择项目并请求 HA 刷新
+    if (mode == TaskListMode::Projects) {
+        if (projects.empty()) {
+            return true;
         }
+        if (selectedIndexProjects < 0) selectedIndexProjects = 0;
+        if (selectedIndexProjects >= (int)projects.size()) selectedIndexProjects = (int)projects.size() - 1;
+
+        const FocusProject& p = projects[selectedIndexProjects];
+        selectedProjectId = p.id;
+        selectedProjectName = p.name;
+
+        ArenaJsonDocument doc(256);
+        doc["event"] = "project_selected";
+        doc["project_id"] = selectedProjectId;
+        doc["project_name"] = selectedProjectName;
+        String payload;
+        serializeJson(doc, payload);
+        networkController.sendWebhookPayload(payload);
+
+        // 选择项目后回到“待办”
+        mode = TaskListMode::Pending;
+        selectedIndexPending = 0;
+        displayOffsetPending = 0;
+        return true;
+    }
 
-        Serial.printf("TaskList: Selected task '%s', entering duration select / 选中任务 '%s'，进入时长选择\n",
-                      selectedTask->name.c_str(), selectedTask->name.c_str());
-
-        // 进入时长选择状态（而非直接开始计时）/ Enter duration select state
-        StateMachine::durationSelectState.setTask(*selectedTask);
-        stateMachine.changeState(&StateMachine::durationSelectState);
-    });
-
-    // Double press to cycle mode / 双击循环：待办 → 已完成 → 项目选择
-    inputController.onDoublePressHandler([this]() {
-        lastActivity = millis();
-        if (mode == TaskListMode::Pending) {
-            mode = TaskListMode::Completed;
-        } else if (mode == TaskListMode::Completed) {
-            mode = TaskListMode::Projects;
-
-            // 进入项目选择时，尽量定位到当前项目
-            int idx = 0;
-            for (int i = 0; i < (int)projects.size(); i++) {
-                if (projects[i].id == selectedProjectId) {
-                    idx = i;
-                    break;
-                }
+    // 已完成列表：单击切回待办（只读查看）
+    if (mode == TaskListMode::Completed) {
+        mode = TaskListMode::Pending;
+        return true;
+    }
+
+    // 有选中任务进入时长选择，否则（无待办）返回空闲 / Selected task -> duration select, otherwise idle
+    return false;
+}
+
+// Double press to cycle mode / 双击循环：待办 → 首字母跳转 → 已完成 → 项目选择
+bool TaskListState::handleDoublePress()
+{
+    stateMachine.armTimeout(this, TASK_TIMEOUT * 1000);
+
+    // 待办（两条以上）先进入首字母跳转，从当前选中任务的字母开始；再双击才切到已完成
+    // Pending (two or more tasks) enters jump mode first, starting at the selected task's initial; the next
+    // double press moves on to completed
+    if (mode == TaskListMode::Pending && !jumpMode && pendingTasks.size() > 1) {
+        enterJumpMode();
+        if (jumpMode) {
+            return true;
+        }
+    }
+    jumpMode = false;
+
+    if (mode == TaskListMode::Pending) {
+        mode = TaskListMode::Completed;
+    } else if (mode == TaskListMode::Completed) {
+        mode = TaskListMode::Projects;
+
+        // 进入项目选择时，尽量定位到当前项目
+        int idx = 0;
+        for (int i = 0; i < (int)projects.size(); i++) {
+            if (projects[i].id == selectedProjectId) {
+                idx = i;
+                break;
             }
-            selectedIndexProjects = idx;
-            displayOffsetProjects = (idx >= MAX_VISIBLE_TASKS) ? (idx - (MAX_VISIBLE_TASKS - 1)) : 0;
-        } else {
-            mode = TaskListMode::Pending;
         }
+        selectedIndexProjects = idx;
+        displayOffsetProjects = (idx >= MAX_VISIBLE_TASKS) ? (idx - (MAX_VISIBLE_TASKS - 1)) : 0;
+    } else {
+        mode = TaskListMode::Pending;
+    }
 
-        Serial.printf("TaskList: Mode -> %d\n", (int)mode);
-    });
+    Serial.printf("TaskList: Mode -> %d\n", (int)mode);
+    return true;
+}
+
+// 按住旋转切换排序视图（与 TaskListViewState 相同）/ Hold and turn cycles the sort view (same as TaskListViewState)
+bool TaskListState::handleHoldRotate(int delta)
+{
+    stateMachine.armTimeout(this, TASK_TIMEOUT * 1000);
+    if (mode == TaskListMode::Projects || delta == 0) {
+        return true;
+    }
 
-    // Long press to cancel / 长按取消
-    inputController.onLongPressHandler([this]() {
-        Serial.println("TaskList: Long press detected, returning to idle / 长按检测，返回空闲");
-        displayController.showCancel();
-        stateMachine.changeState(&StateMachine::idleState);
-    });
+    // 加速后一格可能计多步，排序视图每格只走一步 / Acceleration may count several steps per detent; sort views move one
+    cycleSortMode(delta);
+    if (jumpMode) {
+        jumpTo(0);
+    }
+    return true;
 }
 
 void TaskListState::update()
 {
-    inputController.update();
-    ledController.update();
-    networkController.update();
-
     if (mode == TaskListMode::Projects) {
         displayController.drawProjectSelectScreen(projects, selectedIndexProjects, displayOffsetProjects, selectedProjectId, false);
     } else {
@@ -194,40 +364,37 @@ void TaskListState::update()
         const std::vector<FocusTask>& currentTasks = showingCompleted ? completedTasks : pendingTasks;
         int currentSelectedIndex = showingCompleted ? selectedIndexCompleted : selectedIndexPending;
         int currentDisplayOffset = showingCompleted ? displayOffsetCompleted : displayOffsetPending;
-        displayController.drawTaskListScreen(selectedProjectName, currentTasks, currentSelectedIndex, currentDisplayOffset, showingCompleted);
-    }
-
-    // Check timeout / 检查超时
-    if (millis() - lastActivity >= (TASK_TIMEOUT * 1000)) {
-        Serial.println("TaskList: Timeout, returning to idle / 超时，返回空闲");
-        stateMachine.changeState(&StateMachine::idleState);
+        const std::vector<JumpEntry>& jumpTable = pendingJump[(uint8_t)sortMode];
+        const char jumpInitial = (jumpMode && !jumpTable.empty()) ? jumpTable[jumpCursor].initial : 0;
+        displayController.drawTaskListScreen(selectedProjectName, currentTasks, currentSelectedIndex, currentDisplayOffset, showingCompleted,
+                                             viewOrder(showingCompleted), sortMode, jumpInitial);
     }
 }
 
 void TaskListState::exit()
 {
     Serial.println("Exiting TaskList State / 离开任务列表状态");
-    inputController.releaseHandlers();
     ledController.turnOff();
 }
 
-void TaskListState::updateTaskList(const String& jsonTaskList)
+bool TaskListState::updateTaskList(JsonDocument& doc)
 {
     Serial.println("TaskList: Updating task list from JSON / 从 JSON 更新任务列表");
 
+    // 版本：HA 下发 version 时以其为准并忽略旧版本；未下发则本地递增
+    // Version: honor HA-provided version (drop stale pushes), otherwise bump locally
+    const uint32_t incomingVersion = doc["version"] | 0UL;
+    if (incomingVersion > 0 && incomingVersion < listVersion) {
+        Serial.printf("TaskList: Stale list v%lu < v%lu, ignored / 旧版本列表，忽略\n",
+                      (unsigned long)incomingVersion, (unsigned long)listVersion);
+        return false;
+    }
+    listVersion = (incomingVersion > 0) ? incomingVersion : (listVersion + 1);
+
     pendingTasks.clear();
     completedTasks.clear();
     projects.clear();
 
-    // 与 API 端校验保持一致，避免任务较多时解析失败 / Keep in sync with API validation size
-    DynamicJsonDocument doc(24576);
-    DeserializationError error = deserializeJson(doc, jsonTaskList);
-
-    if (error) {
-        Serial.printf("TaskList: JSON parse error: %s / JSON 解析错误\n", error.c_str());
-        return;
-    }
-
     selectedProjectId = doc["selected_project_id"] | "";
     selectedProjectName = doc["selected_project_name"] | "";
 
@@ -268,6 +435,7 @@ void TaskListState::updateTaskList(const String& jsonTaskList)
         task.priority = taskObj["priority"] | 0;
         task.priorityFlag = taskObj["priority_flag"] | "";
         task.dueMmdd = taskObj["due_mmdd"] | "";
+        task.dueYmd = taskObj["due_ymd"] | 0UL;
         task.hasRepeat = taskObj["has_repeat"] | false;
         task.hasReminder = taskObj["has_reminder"] | false;
         task.subtasksTotal = taskObj["subtasks_total"] | 0;
@@ -308,6 +476,29 @@ void TaskListState::updateTaskList(const String& jsonTaskList)
                   (int)pendingTasks.size(),
                   (int)completedTasks.size());
 
+    rebuildIndexes();
+    resetSelection();
+
+    // 持久化到闪存，供下次开机立即显示 / Persist so the next boot can show it immediately
+    cache.save(*this);
+    return true;
+}
+
+void TaskListState::loadFromCache()
+{
+    if (cache.load(*this)) {
+        rebuildIndexes();
+        resetSelection();
+    }
+}
+
+void TaskListState::clearCache()
+{
+    cache.clear();
+}
+
+void TaskListState::resetSelection()
+{
     // Reset selection / 重置选择
     if (mode != TaskListMode::Projects) {
         mode = pendingTasks.empty() && !completedTasks.empty() ? TaskListMode::Completed : TaskListMode::Pending;
@@ -318,20 +509,102 @@ void TaskListState::updateTaskList(const String& jsonTaskList)
     displayOffsetCompleted = 0;
     selectedIndexProjects = 0;
     displayOffsetProjects = 0;
-    lastActivity = millis();
+    jumpMode = false;
+    stateMachine.armTimeout(this, TASK_TIMEOUT * 1000);
+}
+
+void TaskListState::rebuildIndexes()
+{
+    for (uint8_t m = 0; m < TASK_SORT_MODE_COUNT; m++) {
+        buildIndex(pendingTasks, (TaskSortMode)m, pendingIndex[m]);
+        buildIndex(completedTasks, (TaskSortMode)m, completedIndex[m]);
+    }
+
+    // 首字母只算一次，再按各视图顺序生成跳转表 / Compute initials once, then one jump table per view
+    std::vector<char> initials;
+    initials.reserve(pendingTasks.size());
+    for (const auto& task : pendingTasks) {
+        initials.push_back(taskInitial(task));
+    }
+    for (uint8_t m = 0; m < TASK_SORT_MODE_COUNT; m++) {
+        buildJumpTable(initials, pendingIndex[m], pendingJump[m]);
+    }
+}
+
+void TaskListState::enterJumpMode()
+{
+    const std::vector<JumpEntry>& table = pendingJump[(uint8_t)sortMode];
+    if (table.empty()) {
+        return;
+    }
+
+    // 跳转表按字母排序而非行号，按选中任务的首字母定位；选中行不变，旋钮从这一组开始步进
+    // The table is ordered by letter, not row: find the selected task's initial. The selection stays put
+    // and the encoder steps on from that group
+    const FocusTask* selected = getSelectedTask();
+    const char initial = selected != nullptr ? taskInitial(*selected) : table[0].initial;
+    int cursor = 0;
+    for (int i = 0; i < (int)table.size(); i++) {
+        if (table[i].initial == initial) {
+            cursor = i;
+            break;
+        }
+    }
+    jumpMode = true;
+    jumpCursor = cursor;
+}
+
+void TaskListState::jumpTo(int cursor)
+{
+    const std::vector<JumpEntry>& table = pendingJump[(uint8_t)sortMode];
+    if (table.empty()) {
+        jumpMode = false;
+        return;
+    }
+
+    if (cursor < 0) cursor = 0;
+    if (cursor >= (int)table.size()) cursor = (int)table.size() - 1;
+    jumpCursor = cursor;
+
+    // 落点置顶显示（列表末尾时贴底）/ Show landed row at the top (clamped at the end)
+    const int row = table[cursor].row;
+    const int maxOffset = (int)pendingTasks.size() > MAX_VISIBLE_TASKS ? (int)pendingTasks.size() - MAX_VISIBLE_TASKS : 0;
+    selectedIndexPending = row;
+    displayOffsetPending = row < maxOffset ? row : maxOffset;
+}
+
+const uint16_t* TaskListState::viewOrder(bool completed) const
+{
+    const std::vector<uint16_t>& index = completed ? completedIndex[(uint8_t)sortMode] : pendingIndex[(uint8_t)sortMode];
+    return index.empty() ? nullptr : index.data();
+}
+
+void TaskListState::cycleSortMode(int step)
+{
+    sortMode = (TaskSortMode)(((uint8_t)sortMode + (step > 0 ? 1 : TASK_SORT_MODE_COUNT - 1)) % TASK_SORT_MODE_COUNT);
+
+    // 新视图从顶部开始 / New view starts from the top
+    selectedIndexPending = 0;
+    displayOffsetPending = 0;
+    selectedIndexCompleted = 0;
+    displayOffsetCompleted = 0;
+
+    Serial.printf("TaskList: Sort mode -> %d\n", (int)sortMode);
 }
 
 FocusTask* TaskListState::getSelectedTask()
 {
     if (mode == TaskListMode::Completed) {
         if (selectedIndexCompleted >= 0 && selectedIndexCompleted < (int)completedTasks.size()) {
-            return &completedTasks[selectedIndexCompleted];
+            const uint16_t* order = viewOrder(true);
+            return &completedTasks[order ? order[selectedIndexCompleted] : selectedIndexCompleted];
         }
         return nullptr;
     }
 
     if (mode == TaskListMode::Pending && selectedIndexPending >= 0 && selectedIndexPending < (int)pendingTasks.size()) {
-        return &pendingTasks[selectedIndexPending];
+        const uint16_t* order = viewOrder(false);
+        return &pendingTasks[order ? order[selectedIndexPending] : selectedIndexPending];
     }
     return nullptr;
 }
@@ -1,5 +1,8 @@
 #include "StateMachine.h"
 #include "Controllers.h"
+#include "EventQueue.h"
+#include "JsonArena.h"
+#include "SessionJournal.h"
 #include <ArduinoJson.h>
 
 static String generateSessionId()
@@ -9,14 +12,12 @@ static String generateSessionId()
 }
 
 TimerState::TimerState()
-    : duration(0),
-      elapsedTime(0),
-      startTime(0),
-      taskProjectId(""),
-      taskId(""),
-      taskName(""),
-      sessionId(""),
-      taskDisplayName("")
+    : endTimer(nullptr),
+      armed(nullptr),
+      armGeneration(0),
+      firedGeneration(0),
+      sessionGeneration(0),
+      completionSent(false)
 {
 }
 
@@ -24,181 +25,39 @@ void TimerState::enter()
 {
     Serial.println("Entering Timer State / 进入计时状态");
 
-    // Start time based on the elapsed time / 根据已消耗时间校准起点
-    startTime = millis() - (elapsedTime * 1000);
-
-    displayController.drawTimerScreen(duration * 60);
-    uint32_t remainingSeconds = 0;
-    if ((unsigned long)(duration * 60) > elapsedTime)
+    // 查看列表期间已到时：不再恢复，update() 直接完成 / Ended while viewing the list: update() completes at once
+    if (completionSent)
     {
-        remainingSeconds = (duration * 60) - elapsedTime;
+        return;
     }
-    ledController.startFillAndDecay(RED, remainingSeconds * 1000);
+
+    // 从暂停/查看列表返回时接着已用时长继续，不取整 / Resume from the exact elapsed time, no rounding
+    const bool resumed = session.clock.elapsedUs() > 0;
+    session.clock.start();
+    armEndTimer();
+
+    displayController.drawTimerScreen(session.remainingSeconds());
+    ledController.startFillAndDecay(RED, (uint32_t)(session.remainingUs() / 1000));
 
     // Ensure session id / 确保会话 ID
-    if (sessionId.isEmpty())
+    if (session.sessionId.isEmpty())
     {
-        sessionId = generateSessionId();
+        session.sessionId = generateSessionId();
     }
 
-    // Register state-specific handlers / 注册状态回调
-    inputController.onPressHandler([this]()
-                                   {
-                                       Serial.println("Timer State: Button Pressed / 计时状态：按键按下");
-
-                                       // Update elapsed time / 更新已用时间
-                                       this->elapsedTime = (millis() - this->startTime) / 1000;
-
-                                       // Send 'Stop' webhook (pause) / 发送暂停事件
-                                       DynamicJsonDocument doc(768);
-                                       doc["action"] = "stop";
-                                       doc["event"] = "focus_paused";
-                                       doc["session_id"] = this->sessionId;
-                                       doc["task_id"] = this->taskId;
-                                       doc["task_name"] = this->taskName;
-                                       doc["task_display_name"] = this->taskDisplayName;
-                                       doc["elapsed_seconds"] = (uint32_t)this->elapsedTime;
-                                       doc["count_time"] = false;
-
-                                       String payload;
-                                       serializeJson(doc, payload);
-                                       networkController.sendWebhookPayload(payload);
-
-                                       displayController.showTimerPause();
-
-                                       // Transition to PausedState and set elapsed time
-	                                       StateMachine::pausedState.setPause(
-	                                           this->duration,
-	                                           this->elapsedTime,
-	                                           this->taskId,
-	                                           this->taskName,
-	                                           this->sessionId,
-	                                           this->taskDisplayName,
-	                                           this->taskProjectId);
-	                                       stateMachine.changeState(&StateMachine::pausedState); // Transition to Paused State / 切换到暂停状态
-	                                   });
-
-    inputController.onDoublePressHandler([this]()
-                                         {
-                                             Serial.println("Timer State: Double press - cancel / 计时状态：双击取消");
-
-                                             // Update elapsed time / 更新已用时间
-                                             this->elapsedTime = (millis() - this->startTime) / 1000;
-
-                                             // Send 'Stop' webhook (canceled) / 发送取消事件
-                                             DynamicJsonDocument doc(768);
-                                             doc["action"] = "stop";
-                                             doc["event"] = "focus_canceled";
-                                             doc["session_id"] = this->sessionId;
-                                             doc["task_id"] = this->taskId;
-                                             doc["task_name"] = this->taskName;
-                                             doc["task_display_name"] = this->taskDisplayName;
-                                             doc["elapsed_seconds"] = (uint32_t)this->elapsedTime;
-                                             doc["count_time"] = false;
-
-                                             String payload;
-                                             serializeJson(doc, payload);
-                                             networkController.sendWebhookPayload(payload);
-
-                                             displayController.showCancel();
-
-                                             // 如果存在任务，则进入"是否完成任务"确认 / If task exists, ask whether to mark done
-                                             if (!this->taskId.isEmpty())
-                                             {
-	                                                 StateMachine::taskCompletePromptState.setContext(
-	                                                     this->taskId,
-	                                                     this->taskName,
-	                                                     this->sessionId,
-	                                                     (uint32_t)this->elapsedTime,
-	                                                     false,
-	                                                     true,
-	                                                     this->taskDisplayName,
-	                                                     this->taskProjectId);
-	                                                 stateMachine.changeState(&StateMachine::taskCompletePromptState);
-	                                             }
-                                             else
-                                             {
-                                                 stateMachine.changeState(&StateMachine::idleState); // Transition to IdleState / 返回空闲
-                                             }
-                                         });
-
-    // 旋转查看任务列表 / Rotate to view task list
-    inputController.onEncoderRotateHandler([this](int delta)
-                                           {
-                                               Serial.println("Timer State: Encoder rotate - view task list / 计时状态：旋转查看任务列表");
-
-                                               // 更新已用时间（用于返回时恢复）/ Update elapsed time for restoration
-                                               this->elapsedTime = (millis() - this->startTime) / 1000;
-
-                                               // 进入只读任务列表查看状态（不暂停计时、不触发webhook）
-                                               // Enter read-only task list view (no pause, no webhook)
-	                                               StateMachine::taskListViewState.setTimerContext(
-	                                                   this->duration,
-	                                                   this->elapsedTime,
-	                                                   this->taskId,
-	                                                   this->taskName,
-	                                                   this->sessionId,
-	                                                   this->taskDisplayName,
-	                                                   this->taskProjectId);
-	                                               stateMachine.changeState(&StateMachine::taskListViewState);
-	                                           });
-
-    // 长按也可以取消计时（保留作为备用）/ Long press also cancels timer (kept as backup)
-    inputController.onLongPressHandler([this]()
-                                       {
-                                           Serial.println("Timer State: Long press - cancel / 计时状态：长按取消");
-
-                                           // Update elapsed time / 更新已用时间
-                                           this->elapsedTime = (millis() - this->startTime) / 1000;
-
-                                           // Send 'Stop' webhook (canceled) / 发送取消事件
-                                           DynamicJsonDocument doc(768);
-                                           doc["action"] = "stop";
-                                           doc["event"] = "focus_canceled";
-                                           doc["session_id"] = this->sessionId;
-                                           doc["task_id"] = this->taskId;
-                                           doc["task_name"] = this->taskName;
-                                           doc["task_display_name"] = this->taskDisplayName;
-                                           doc["elapsed_seconds"] = (uint32_t)this->elapsedTime;
-                                           doc["count_time"] = false;
-
-                                           String payload;
-                                           serializeJson(doc, payload);
-                                           networkController.sendWebhookPayload(payload);
-
-                                           displayController.showCancel();
-
-                                           // 如果存在任务，则进入"是否完成任务"确认 / If task exists, ask whether to mark done
-                                           if (!this->taskId.isEmpty())
-                                           {
-	                                               StateMachine::taskCompletePromptState.setContext(
-	                                                   this->taskId,
-	                                                   this->taskName,
-	                                                   this->sessionId,
-	                                                   (uint32_t)this->elapsedTime,
-	                                                   false,
-	                                                   true,
-	                                                   this->taskDisplayName,
-	                                                   this->taskProjectId);
-	                                               stateMachine.changeState(&StateMachine::taskCompletePromptState);
-	                                           }
-                                           else
-                                           {
-                                               stateMachine.changeState(&StateMachine::idleState); // Transition to IdleState / 返回空闲
-                                           }
-                                       });
+    // 按键/旋钮均由转移表处理（暂停、取消、查看列表）/ All gestures are handled by the transition table
 
     networkController.startBluetooth();
 
     // Send start/resume webhook / 发送开始/恢复事件
-    DynamicJsonDocument doc(768);
+    ArenaJsonDocument doc(768);
     doc["action"] = "start";
-    doc["event"] = (elapsedTime > 0) ? "focus_resumed" : "focus_started";
-    doc["session_id"] = sessionId;
-    doc["task_id"] = taskId;
-    doc["task_name"] = taskName;
-    doc["task_display_name"] = taskDisplayName;
-    doc["duration_minutes"] = duration;
+    doc["event"] = resumed ? "focus_resumed" : "focus_started";
+    doc["session_id"] = session.sessionId;
+    doc["task_id"] = session.taskId;
+    doc["task_name"] = session.taskName;
+    doc["task_display_name"] = session.taskDisplayName;
+    doc["duration_minutes"] = session.duration;
 
     String payload;
     serializeJson(doc, payload);
@@ -207,81 +66,174 @@ void TimerState::enter()
 
 void TimerState::update()
 {
-    inputController.update();
-    ledController.update();
-    networkController.update();
-
-    unsigned long currentTime = millis();
-    elapsedTime = (currentTime - startTime) / 1000;
-
-    int remainingSeconds = duration * 60 - elapsedTime;
+    displayController.drawTimerScreen(session.remainingSeconds());
 
-    displayController.drawTimerScreen(remainingSeconds);
+    // 每秒刷新断电恢复记录（NVS 写入按间隔合并）/ Refresh the checkpoint each second (NVS writes are coalesced)
+    sessionJournal.record(session);
 
-    // Check if the timer is done / 检查计时是否完成
-    if (remainingSeconds <= 0)
+    // 结束定时器触发后由 Timer 事件唤醒到这里 / Woken here by the Timer event once the end timer fires
+    if (completionSent)
     {
         Serial.println("Timer State: Done / 计时状态：完成");
-
-        // Send completion webhook (count_time=true) / 发送完成事件（计入今日统计）
-        DynamicJsonDocument doc(768);
-        doc["action"] = "stop";
-        doc["event"] = "focus_completed";
-        doc["session_id"] = sessionId;
-        doc["task_id"] = taskId;
-        doc["task_name"] = taskName;
-        doc["task_display_name"] = taskDisplayName;
-        doc["elapsed_seconds"] = (uint32_t)(duration * 60);
-        doc["count_time"] = true;
-
-        String payload;
-        serializeJson(doc, payload);
-        networkController.sendWebhookPayload(payload);
-
-        displayController.showTimerDone();
-
-        // 如果存在任务，则进入“是否完成任务”确认 / If task exists, ask whether to mark done
-	        if (!taskId.isEmpty())
-	        {
-	            StateMachine::taskCompletePromptState.setContext(
-	                taskId,
-	                taskName,
-	                sessionId,
-	                (uint32_t)(duration * 60),
-	                true,
-	                false,
-	                taskDisplayName,
-	                taskProjectId);
-	            stateMachine.changeState(&StateMachine::taskCompletePromptState);
-	        }
-        else
-        {
-            stateMachine.changeState(&StateMachine::doneState); // Transition to Done State / 切换到完成状态
-        }
+        stateMachine.dispatch(Trigger::Done);
     }
 }
 
+unsigned long TimerState::nextWakeup(unsigned long now)
+{
+    // 只需在倒计时跳到下一秒时重绘 / Only redraw when the countdown reaches its next second
+    const int64_t remainingUs = session.remainingUs();
+    const int64_t untilTickUs = (remainingUs % 1000000 == 0) ? 1000000 : remainingUs % 1000000;
+    return now + (unsigned long)((untilTickUs + 999) / 1000);
+}
+
 void TimerState::exit()
 {
-    inputController.releaseHandlers();
     networkController.stopBluetooth();
     ledController.turnOff();
     Serial.println("Exiting Timer State / 离开计时状态");
 }
 
 void TimerState::setTimer(int duration,
-                          unsigned long elapsedTime,
                           const String& taskId,
                           const String& taskName,
                           const String& sessionId,
                           const String& taskDisplayName,
                           const String& taskProjectId)
 {
-    this->duration = duration;
-    this->elapsedTime = elapsedTime;
-    this->taskId = taskId;
-    this->taskName = taskName;
-    this->sessionId = sessionId;
-    this->taskDisplayName = taskDisplayName;
-    this->taskProjectId = taskProjectId;
+    session.duration = duration;
+    session.clock.reset();
+    disarmEndTimer();
+    sessionGeneration = armGeneration;
+    firedGeneration = 0;
+    completionSent = false;
+    session.taskId = taskId;
+    session.taskName = taskName;
+    session.sessionId = sessionId;
+    session.taskDisplayName = taskDisplayName;
+    session.taskProjectId = taskProjectId;
+}
+
+void TimerState::setSession(const FocusSession& session)
+{
+    this->session = session;
+}
+
+void TimerState::stopClock()
+{
+    session.clock.stop();
+    disarmEndTimer();
+}
+
+void TimerState::armEndTimer()
+{
+    if (endTimer == nullptr)
+    {
+        esp_timer_create_args_t args = {};
+        args.callback = onSessionEnd;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "focus_end";
+        esp_timer_create(&args, &endTimer);
+    }
+
+    const uint32_t full = (uint32_t)(session.duration * 60);
+    const int64_t deadlineUs = session.endDeadlineUs();
+    ArmedCompletion* completion = new ArmedCompletion();
+    completion->generation = ++armGeneration;
+    completion->deadlineUs = deadlineUs;
+    completion->payload = focusStopPayload(session, "focus_completed", full, true);
+
+    // 发布后归回调所有，不再访问 / Owned by the callback once published; not touched again
+    esp_timer_stop(endTimer);
+    delete armed.exchange(completion);
+
+    // 按绝对结束时刻重新布防（查看列表返回时同样适用）/ Re-arm against the absolute end deadline
+    const int64_t untilEndUs = deadlineUs - FocusClock::now();
+    esp_timer_start_once(endTimer, untilEndUs > 0 ? (uint64_t)untilEndUs : 1);
+}
+
+void TimerState::disarmEndTimer()
+{
+    // 先递增代数：已在运行的回调即使拿到旧布防也会丢弃 / Bump first so a callback already running drops what it takes
+    ++armGeneration;
+    if (endTimer != nullptr)
+    {
+        esp_timer_stop(endTimer);
+    }
+    delete armed.exchange(nullptr);
+}
+
+// 在 esp_timer 任务中运行：主循环阻塞在网络调用里也能准时发出完成事件。
+// 入队只是 strdup + 非阻塞 xQueueSend；会话本身不在这里读写，只用布防时发布的副本
+// Runs on the esp_timer task, so the completion webhook goes out on time even if the loop is blocked in a
+// network call. Enqueueing is a strdup plus a non-blocking xQueueSend; the session is never touched here,
+// only the copy published when arming
+void TimerState::onSessionEnd(void* arg)
+{
+    TimerState* self = static_cast<TimerState*>(arg);
+    ArmedCompletion* completion = self->armed.exchange(nullptr);
+    if (completion == nullptr)
+    {
+        return; // 已撤防 / Disarmed
+    }
+
+    // 暂停/取消后代数已变：丢弃 / A pause or cancel changed the generation: drop it
+    if (completion->generation != self->armGeneration.load())
+    {
+        delete completion;
+        return;
+    }
+
+    // 上一次布防迟到的回调拿到了新布防：放回，等它自己的定时器 / A late fire from an earlier arm took the new one: put it back
+    if (FocusClock::now() < completion->deadlineUs)
+    {
+        ArmedCompletion* expected = nullptr;
+        if (!self->armed.compare_exchange_strong(expected, completion))
+        {
+            delete completion;
+        }
+        return;
+    }
+
+    networkController.sendWebhookPayload(completion->payload);
+    self->firedGeneration = completion->generation;
+    delete completion;
+    eventQueue.post(EventType::Timer);
+}
+
+void TimerState::onEndEvent()
+{
+    // 属于本会话即视为完成（即使暂停刚好抢在事件处理之前），避免恢复后再发一次
+    // Any fire from this session counts, even if a pause slipped in before the event was handled, so resuming never sends it twice
+    const uint32_t fired = firedGeneration.exchange(0);
+    if (fired != 0 && fired > sessionGeneration)
+    {
+        completionSent = true;
+    }
+}
+
+String TimerState::focusStopPayload(const FocusSession& session,
+                                    const char* event,
+                                    uint32_t elapsedSeconds,
+                                    bool countTime,
+                                    const char* cancelReason)
+{
+    ArenaJsonDocument doc(768);
+    doc["action"] = "stop";
+    doc["event"] = event;
+    doc["session_id"] = session.sessionId;
+    doc["task_id"] = session.taskId;
+    doc["task_name"] = session.taskName;
+    doc["task_display_name"] = session.taskDisplayName;
+    doc["elapsed_seconds"] = elapsedSeconds;
+    doc["count_time"] = countTime;
+    if (cancelReason != nullptr)
+    {
+        doc["cancel_reason"] = cancelReason;
+    }
+
+    String payload;
+    serializeJson(doc, payload);
+    return payload;
 }